@@ -1,18 +1,59 @@
 #ifndef CPP_S21_CONTAINERS_RBTREE_S21_RB_TREE_H
 #define CPP_S21_CONTAINERS_RBTREE_S21_RB_TREE_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "../allocator/s21_pool_allocator.h"
+#include "../helper/helper.h"
+#include "../thread_pool/s21_thread_pool.h"
 
 namespace s21 {
-template <typename K, typename T, class Compare, class Extracter>
+/*Subtree size kept in the nodes of an order-statistic (Indexed) tree*/
+template <bool Indexed>
+struct RBSubtreeSize {};
+
+template <>
+struct RBSubtreeSize<true> {
+  std::size_t subtree_size_;
+};
+
+/*In-order neighbours kept in the nodes of a Threaded tree, so iterators
+  step in one load instead of climbing the tree*/
+template <bool Threaded, typename Node>
+struct RBThreadLinks {};
+
+template <typename Node>
+struct RBThreadLinks<true, Node> {
+  Node *prev_;
+  Node *next_;
+};
+
+template <typename K, typename T, class Compare, class Extracter,
+          bool Indexed = false, class Alloc = s21::pool_allocator<T>,
+          bool Threaded = false>
 class RBTree {
   struct Node;
 
+  using node_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
  public:
   class RBIterator;
   class RBConstIterator;
+  class RBNodeHandle;
+  struct RBInsertReturn;
 
   using key_type = K;
   using value_type = T;
@@ -23,6 +64,9 @@ class RBTree {
   using iterator = RBIterator;
   using const_iterator = RBConstIterator;
   using node_type = Node;
+  using node_handle = RBNodeHandle;
+  using insert_return_type = RBInsertReturn;
+  using allocator_type = Alloc;
 
   class RBIterator {
     friend class RBTree;
@@ -67,7 +111,49 @@ class RBTree {
     pointer operator->() const;
   };
 
+  /*Owns a node taken out of a tree until it is inserted into another one or
+    dropped*/
+  class RBNodeHandle {
+    friend class RBTree;
+
+   public:
+    RBNodeHandle() noexcept;
+    RBNodeHandle(const RBNodeHandle &other) = delete;
+    RBNodeHandle(RBNodeHandle &&other) noexcept;
+    ~RBNodeHandle();
+
+    RBNodeHandle &operator=(const RBNodeHandle &other) = delete;
+    RBNodeHandle &operator=(RBNodeHandle &&other) noexcept;
+
+    bool empty() const noexcept;
+    explicit operator bool() const noexcept;
+    allocator_type get_allocator() const;
+
+    reference value() const noexcept;
+    template <typename V = value_type>
+    typename V::first_type &key() const noexcept;
+    template <typename V = value_type>
+    typename V::second_type &mapped() const noexcept;
+
+    void swap(RBNodeHandle &other) noexcept;
+
+   private:
+    node_type *node_;
+    /*Empty exactly when the handle is, like the one of std::set*/
+    std::optional<node_allocator> alloc_;
+
+    RBNodeHandle(node_type *node, const node_allocator &alloc) noexcept;
+    void Reset() noexcept;
+  };
+
+  struct RBInsertReturn {
+    iterator position;
+    bool inserted;
+    node_handle node;
+  };
+
   RBTree();
+  explicit RBTree(const allocator_type &alloc);
   RBTree(const RBTree &other);
   RBTree(RBTree &&other) noexcept;
   ~RBTree();
@@ -85,264 +171,981 @@ class RBTree {
   inline bool empty() const noexcept;
   inline size_type size() const noexcept;
   size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
 
   void clear();
   std::pair<iterator, bool> insert_unique(const value_type &val);
+  std::pair<iterator, bool> insert_unique(value_type &&val);
   iterator insert_equal(const value_type &val);
-  iterator search(const key_type target) const noexcept;
+  iterator insert_equal(value_type &&val);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args &&...args);
+  template <typename... Args>
+  iterator emplace_equal(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace_unique(const key_type &key,
+                                               Args &&...args);
+  template <typename V>
+  iterator insert_hint_unique(const_iterator hint, V &&val);
+  template <typename V>
+  iterator insert_hint_equal(const_iterator hint, V &&val);
+  template <typename... Args>
+  iterator emplace_hint_unique(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint_equal(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void insert_unique(InputIt first, InputIt last);
+  template <typename InputIt>
+  void insert_equal(InputIt first, InputIt last);
+  template <typename InputIt>
+  void insert_unique(InputIt first, InputIt last, thread_pool &pool);
+  template <typename InputIt>
+  void insert_equal(InputIt first, InputIt last, thread_pool &pool);
+  template <typename Key>
+  iterator search(const Key &target) const noexcept;
   iterator erase(iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  template <typename Key>
+  size_type erase_key(const Key &key);
+  template <typename Pred>
+  size_type erase_if(Pred pred);
   void swap(RBTree &other);
   void merge_unique(RBTree &other);
   void merge_equal(RBTree &other);
-
-  bool contains(const key_type &Key) const noexcept;
-  iterator lower_bound(const key_type &Key) noexcept;
-  iterator upper_bound(const key_type &Key) noexcept;
-  size_type count(const key_type &k) const;
-  std::pair<iterator, iterator> equal_range(const key_type &k);
+  template <typename Key>
+  RBTree split(const Key &key);
+  void join_unique(RBTree &other);
+  void join_equal(RBTree &other);
+  node_handle extract(const_iterator pos);
+  template <typename Key>
+  node_handle extract_key(const Key &key);
+  insert_return_type insert_unique(node_handle &&nh);
+  iterator insert_equal(node_handle &&nh);
+
+  template <typename Key>
+  bool contains(const Key &key) const noexcept;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename Key>
+  iterator lower_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key>
+  iterator upper_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator upper_bound(const Key &key) const noexcept;
+  template <typename Key>
+  size_type count(const Key &k) const;
+  template <typename Key>
+  std::pair<iterator, iterator> equal_range(const Key &k);
+  template <typename Key>
+  std::pair<const_iterator, const_iterator> equal_range(const Key &k) const;
+
+  template <typename Key>
+  size_type rank(const Key &k) const;
+  iterator select(size_type k) noexcept;
+  const_iterator select(size_type k) const noexcept;
+  size_type distance(const_iterator first, const_iterator last) const noexcept;
+
+  void assign_union(const RBTree &a, const RBTree &b);
+  void assign_intersection(const RBTree &a, const RBTree &b);
+  void assign_difference(const RBTree &a, const RBTree &b);
+  void assign_symmetric_difference(const RBTree &a, const RBTree &b);
+  void assign_union(const RBTree &a, const RBTree &b, thread_pool &pool);
+  void assign_intersection(const RBTree &a, const RBTree &b,
+                           thread_pool &pool);
+  void assign_difference(const RBTree &a, const RBTree &b, thread_pool &pool);
+  void assign_symmetric_difference(const RBTree &a, const RBTree &b,
+                                   thread_pool &pool);
 
  private:
   typedef enum { RED, BLACK } color_t;
 
-  struct Node {
-    value_type key_;
+  /*A subtree cut loose from its parent, with its black height counted as if
+    the root were black*/
+  using subtree_type = std::pair<node_type *, size_type>;
+
+  typedef enum {
+    UNION,
+    INTERSECTION,
+    DIFFERENCE,
+    SYMMETRIC_DIFFERENCE,
+    MERGE
+  } algebra_t;
+
+  /*How many of two runs of equivalent values an operation keeps: a_count
+    values of a starting at a_first, and likewise of b*/
+  struct RunShare {
+    size_type a_first;
+    size_type a_count;
+    size_type b_first;
+    size_type b_count;
+  };
+
+  /*Nodes a subtree operation let go of, threaded through right_child_ and
+    freed afterwards by a single thread*/
+  struct DropList {
+    node_type *first_;
+    node_type *last_;
+  };
+
+  /*Raw nodes chained through their first word*/
+  struct Spare {
+    Spare *next_;
+  };
+
+  /*The allocator is not thread safe, so the threads of a parallel copy take
+    raw nodes from it in batches under a lock and put back what they do not
+    use*/
+  struct Stock {
+    std::mutex mutex_;
+    Spare *chain_;
+  };
+
+  /*A thread's share of a Stock*/
+  struct Batch {
+    Stock *stock_;
+    Spare *chain_;
+  };
+
+  /*Subtrees below this black height, a few hundred nodes at the least, and
+    runs of fewer nodes than kForkSize are worked on by the thread that
+    reached them*/
+  static constexpr size_type kForkHeight = 8;
+  static constexpr size_type kForkSize = 2048;
+  static constexpr size_type kBatchNodes = 256;
+
+  /*One of the searches find_many runs side by side. turns_ holds the nodes
+    the search went left at; while the keys ascend, the next key starts below
+    the deepest of them that is still greater instead of at the root*/
+  template <typename ForwardIt>
+  struct Lane {
+    ForwardIt key_;
+    node_type *node_;
+    bool done_;
+    size_type depth_;
+    node_type *turns_[2 * std::numeric_limits<size_type>::digits];
+  };
+
+  /*Searches in flight at once, enough to keep several cache misses
+    outstanding. Trees under kLookupSpill nodes mostly stay in the cache, so
+    there is nothing to overlap and one search at a time is cheaper*/
+  static constexpr size_type kLookupLanes = 8;
+  static constexpr size_type kLookupSpill = 32768;
+
+  struct Header {};
+
+  /*key_ is constructed and destroyed by the tree, so the nil and end nodes
+    can go without a value. Nodes are at least pointer aligned, so the color
+    rides in the low bit of the parent link and costs no extra word*/
+  struct Node : RBSubtreeSize<Indexed>, RBThreadLinks<Threaded, Node> {
+    template <typename... Args>
+    explicit Node(Args &&...args)
+        : key_(std::forward<Args>(args)...), parent_color_(BLACK) {}
+    explicit Node(Header) noexcept
+        : left_child_(nullptr), right_child_(nullptr), parent_color_(BLACK) {
+      if constexpr (Indexed) {
+        this->subtree_size_ = 0;
+      }
+    }
+    ~Node() {}
+
+    Node *Parent() const noexcept {
+      return reinterpret_cast<Node *>(parent_color_ & ~kColorMask);
+    }
+
+    void SetParent(Node *parent) noexcept {
+      parent_color_ = reinterpret_cast<std::uintptr_t>(parent) |
+                      (parent_color_ & kColorMask);
+    }
+
+    color_t Color() const noexcept {
+      return static_cast<color_t>(parent_color_ & kColorMask);
+    }
+
+    void SetColor(color_t color) noexcept {
+      parent_color_ = (parent_color_ & ~kColorMask) | color;
+    }
+
+    union {
+      value_type key_;
+    };
 
     Node *left_child_;
     Node *right_child_;
-    Node *parent_;
 
-    color_t color_;
+   private:
+    static constexpr std::uintptr_t kColorMask = 1;
+
+    std::uintptr_t parent_color_;
   };
 
   node_type *root_;
   node_type *nil_;
   node_type *head_;
   node_type *tail_;
+  node_type header_;
   node_type *sentinel_;
   size_type tree_size_;
   Compare comp_;
   Extracter extracter_;
+  node_allocator alloc_;
 
   void CopyT(const RBTree &other);
   node_type *CopySubT(node_type *node, node_type *parent,
                       const node_type *other_nil, const node_type *other_sen);
   node_type *CopyN(const node_type *src);
-
-  node_type *SearchHelper(node_type *node, key_type data) const noexcept;
-
-  void Free(node_type *creep);
+  void EnsureNil();
+  void FreeNil() noexcept;
+  void LinkSentinel() noexcept;
+  void Thread(node_type *prev, node_type *next) noexcept;
+  node_type *ThreadSubT(node_type *node, node_type *prev) noexcept;
+
+  template <typename ForwardIt>
+  std::pair<bool, size_type> SortedLength(ForwardIt first, ForwardIt last,
+                                          bool unique) const;
+  template <typename ForwardIt>
+  void BuildSorted(ForwardIt first, ForwardIt last, size_type n, bool unique);
+  template <typename Source>
+  void Link(size_type n, Source &next);
+  template <typename Source>
+  node_type *LinkSubT(node_type *parent, size_type n, size_type depth,
+                      size_type red_depth, Source &next);
+  void Unlink() noexcept;
+  static size_type Log2(size_type n) noexcept;
+
+  bool MergeLinked(RBTree &other, bool unique) noexcept;
+  bool PreferRebuild(size_type incoming) const noexcept;
+  void MergeRebuild(RBTree &other, bool unique) noexcept;
+  node_type *Flatten(node_type *node, node_type *rest) noexcept;
+  void Join(RBTree &other, bool other_after) noexcept;
+  subtree_type JoinSubT(subtree_type left, node_type *mid,
+                        subtree_type right) noexcept;
+  std::pair<subtree_type, subtree_type> SplitSubT(node_type *pivot) noexcept;
+  subtree_type Detach(node_type *node, size_type height) noexcept;
+  size_type EraseRange(node_type *first, node_type *last);
+  size_type SpliceOut(node_type *first, node_type *last) noexcept;
+
+  void Algebra(algebra_t op, const RBTree &a, const RBTree &b,
+               thread_pool *pool);
+  static bool Lopsided(size_type smaller, size_type larger) noexcept;
+  static RunShare Share(algebra_t op, size_type m, size_type n) noexcept;
+  template <typename Emit>
+  void EmitShare(const RunShare &share, const_iterator a_run,
+                 const_iterator b_run, Emit &emit) const;
+  template <typename Emit>
+  void MergeRuns(algebra_t op, const RBTree &a, const RBTree &b,
+                 Emit &emit) const;
+  template <typename Emit>
+  void ProbeRuns(algebra_t op, const RBTree &smaller, const RBTree &larger,
+                 bool a_smaller, Emit &emit) const;
+  template <typename Walk>
+  void BuildFrom(Walk walk);
+  void JoinCopies(algebra_t op, const RBTree &a, const RBTree &b,
+                  bool a_smaller, thread_pool *pool);
+  void SettleRoot(node_type *root) noexcept;
+  subtree_type CopyDetached(const RBTree &other);
+  std::pair<subtree_type, subtree_type> CopyShared(const RBTree &a,
+                                                   const RBTree &b,
+                                                   thread_pool &pool);
+  node_type *CopySharedSubT(const node_type *src, const RBTree &other,
+                            size_type height, Batch &batch,
+                            thread_pool &pool);
+  node_type *Take(Batch &batch);
+  void PutBack(Batch &batch, node_type *node) noexcept;
+  void Scrap(node_type *node, Batch &batch) noexcept;
+  static void Return(Batch &batch) noexcept;
+  void Release(Stock &stock) noexcept;
+  subtree_type Combine(algebra_t op, subtree_type a, subtree_type b,
+                       bool pivot_on_a, DropList &dropped,
+                       thread_pool *pool) noexcept;
+  std::pair<subtree_type, subtree_type> SplitKey(subtree_type tree,
+                                                 const key_type &key,
+                                                 node_type *&equal) noexcept;
+  node_type *KeepRuns(algebra_t op, node_type *a, node_type *b,
+                      DropList &dropped) noexcept;
+  void Drop(node_type *node, DropList &dropped) noexcept;
+  static void Splice(DropList &to, const DropList &from) noexcept;
+  size_type FreeDropped(const DropList &dropped) noexcept;
+  subtree_type Concat(subtree_type left, node_type *run,
+                      subtree_type right) noexcept;
+  subtree_type JoinSubT(subtree_type left, subtree_type right) noexcept;
+  void JoinChecked(RBTree &other, bool unique);
+  template <typename InputIt>
+  void InsertShared(InputIt first, InputIt last, bool unique,
+                    thread_pool &pool);
+  void SortShared(node_type **nodes, size_type n,
+                  thread_pool &pool) const noexcept;
+  node_type *LinkShared(node_type **nodes, size_type n, size_type depth,
+                        size_type red_depth, thread_pool &pool) noexcept;
+  size_type RelinkLeaves(node_type *node, const node_type *other_nil,
+                         const node_type *other_sen) noexcept;
+  size_type BlackHeight(const node_type *node) const noexcept;
+
+  template <typename ForwardIt, typename Visit>
+  void SearchMany(ForwardIt first, ForwardIt last, Visit visit) const;
+  template <typename ForwardIt>
+  void StartLane(Lane<ForwardIt> &lane, ForwardIt key,
+                 bool ascending) const noexcept;
+  template <typename ForwardIt>
+  bool StepLane(Lane<ForwardIt> &lane) const noexcept;
+  static void Prefetch(const node_type *node) noexcept;
+
+  template <typename Key>
+  node_type *LowerBoundNode(const Key &key) const noexcept;
+  template <typename Key>
+  node_type *UpperBoundNode(const Key &key) const noexcept;
+  template <typename Key>
+  size_type CountLess(const Key &key) const noexcept;
+  template <typename Key>
+  size_type CountNotGreater(const Key &key) const noexcept;
+  node_type *SelectNode(size_type k) const noexcept;
+  size_type Position(const node_type *node) const noexcept;
+
+  template <typename... Args>
+  node_type *CreateNode(Args &&...args);
+  void DestroyNode(node_type *node) noexcept;
+  node_type *Adopt(RBTree &other, node_type *node, bool linked);
+  node_type *Adopt(node_handle &nh);
+  size_type Free(node_type *creep);
+  void DestroySubT(node_type *creep) noexcept;
 
   void Transplant(node_type *from, node_type *to) noexcept;
-  void LeftRotate(node_type *x) noexcept;
-  void RightRotate(node_type *y) noexcept;
-  void RebalanceInsert(node_type *node) noexcept;
+  void LeftRotate(node_type *x, node_type *&root) noexcept;
+  void RightRotate(node_type *y, node_type *&root) noexcept;
+  bool RebalanceInsert(node_type *node, node_type *&root) noexcept;
   void RebalanceDelete(node_type *x) noexcept;
   std::pair<node_type *, iterator> EraseHandler(const_iterator pos) noexcept;
 
-  node_type *extract(const_iterator position);
-
   inline node_type *MRight(const node_type *current) noexcept;
   inline node_type *MLeft(const node_type *current) noexcept;
-  std::pair<node_type *, bool> GetInsertUniqPos(const value_type &k);
-  node_type *GetInsertEqPos(const value_type &k);
-  iterator Insert(node_type *parent, const value_type &arg);
+  std::pair<node_type *, bool> GetInsertUniqPos(const key_type &key);
+  node_type *GetInsertEqPos(const key_type &key);
+  template <typename... Args>
+  iterator Emplace(node_type *parent, Args &&...args);
+  std::pair<node_type *, bool> GetHintUniqPos(const_iterator hint,
+                                              const key_type &key);
+  std::pair<node_type *, bool> GetHintEqPos(const_iterator hint,
+                                            const key_type &key);
   iterator Insert(node_type *parent, node_type *nh) noexcept;
-  iterator InsertHandler(node_type *parent, node_type *nh) noexcept;
+  iterator Insert(node_type *parent, node_type *nh, bool left) noexcept;
+  iterator InsertHandler(node_type *parent, node_type *nh, bool left) noexcept;
+  inline bool IsLeaf(const node_type *node) const noexcept;
 
   node_type *FindMinNode(node_type *enter) noexcept;
+
+  void ResizeSubtree(node_type *node) noexcept;
+  void GrowPath(node_type *node, size_type by = 1) noexcept;
+  void ShrinkPath(node_type *node) noexcept;
 };
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBTree()
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RBTree()
     : root_(nullptr),
-      nil_(new node_type),
-      sentinel_(new node_type),
+      nil_(nullptr),
+      header_(Header()),
+      sentinel_(&header_),
       tree_size_(0),
       comp_(),
-      extracter_() {
-  nil_->key_ = value_type();
-  nil_->left_child_ = nil_->right_child_ = nil_->parent_ = nullptr;
-  nil_->color_ = BLACK;
-
-  sentinel_->key_ = value_type();
-  sentinel_->parent_ = nullptr;
-  sentinel_->left_child_ = sentinel_->right_child_ = sentinel_;
-  sentinel_->color_ = BLACK;
+      extracter_(),
+      alloc_() {
+  LinkSentinel();
+}
 
-  head_ = tail_ = sentinel_;
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RBTree(
+    const allocator_type &alloc)
+    : root_(nullptr),
+      nil_(nullptr),
+      header_(Header()),
+      sentinel_(&header_),
+      tree_size_(0),
+      comp_(),
+      extracter_(),
+      alloc_(alloc) {
+  LinkSentinel();
 };
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBTree(const RBTree &other) : RBTree() {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBTree(const RBTree &other)
+    : RBTree(node_traits::select_on_container_copy_construction(other.alloc_)) {
   CopyT(other);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBTree(RBTree &&other) noexcept : RBTree() {
-  std::swap(this->root_, other.root_);
-  std::swap(this->head_, other.head_);
-  std::swap(this->tail_, other.tail_);
-  std::swap(this->nil_, other.nil_);
-  std::swap(this->sentinel_, other.sentinel_);
-  std::swap(this->tree_size_, other.tree_size_);
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RBTree(
+    RBTree &&other) noexcept
+    : RBTree() {
+  swap(other);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::~RBTree() {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::~RBTree() {
   clear();
-  delete nil_;
-  delete sentinel_;
+  FreeNil();
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter> &RBTree<K, T, Compare, Extracter>::operator=(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded> &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::operator=(
     const RBTree &other) {
   CopyT(other);
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter> &RBTree<K, T, Compare, Extracter>::operator=(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded> &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::operator=(
     RBTree &&other) noexcept {
   if (this != &other) {
     clear();
-    delete nil_;
-    delete sentinel_;
+    FreeNil();
 
     root_ = other.root_;
     nil_ = other.nil_;
     head_ = other.head_;
     tail_ = other.tail_;
-    sentinel_ = other.sentinel_;
     tree_size_ = other.tree_size_;
 
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    }
+
+    LinkSentinel();
+
     other.root_ = nullptr;
     other.nil_ = nullptr;
-    other.head_ = nullptr;
-    other.tail_ = nullptr;
-    other.sentinel_ = nullptr;
     other.tree_size_ = 0;
+    other.LinkSentinel();
   }
 
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::begin() noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::begin() noexcept {
   return iterator(head_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::const_iterator
-RBTree<K, T, Compare, Extracter>::begin() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::begin() const noexcept {
   return const_iterator(head_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::const_iterator
-RBTree<K, T, Compare, Extracter>::cbegin() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::cbegin() const noexcept {
   return const_iterator(head_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::end() noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::end() noexcept {
   return iterator(sentinel_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::const_iterator
-RBTree<K, T, Compare, Extracter>::end() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::end() const noexcept {
   return const_iterator(sentinel_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::const_iterator
-RBTree<K, T, Compare, Extracter>::cend() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::cend() const noexcept {
   return const_iterator(sentinel_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-bool RBTree<K, T, Compare, Extracter>::empty() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::empty() const noexcept {
   return begin() == end();
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::size_type
-RBTree<K, T, Compare, Extracter>::size() const noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::size() const noexcept {
   return tree_size_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::size_type
-RBTree<K, T, Compare, Extracter>::max_size() const {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::max_size() const {
   return (std::numeric_limits<size_type>::max() /
-          sizeof(RBTree<K, T, Compare, Extracter>::node_type)) /
+          sizeof(RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                        Threaded>::node_type)) /
          2;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::clear() {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::allocator_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::get_allocator()
+    const noexcept {
+  return allocator_type(alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::clear() {
   if (root_ == nullptr) {
     return;
   }
 
-  Free(root_);
+  if constexpr (is_releasable_allocator<node_allocator>::value) {
+    if (alloc_.unique()) {
+      DestroySubT(root_);
+      alloc_.release();
+      nil_ = nullptr;
+
+    } else {
+      Free(root_);
+    }
+
+  } else {
+    Free(root_);
+  }
 
   root_ = nullptr;
-  head_ = tail_ = sentinel_;
-  sentinel_->left_child_ = sentinel_->right_child_ = sentinel_;
   tree_size_ = 0;
+  LinkSentinel();
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::Free(node_type *creep) {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::Free(node_type *creep) {
   if (creep == nil_ || creep == sentinel_) {
-    return;
+    return 0;
+  }
+
+  size_type freed = Free(MLeft(creep)) + Free(MRight(creep)) + 1;
+  DestroyNode(creep);
+
+  return freed;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::DestroySubT(
+    node_type *creep) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    if (creep == nil_ || creep == sentinel_) {
+      return;
+    }
+
+    DestroySubT(MLeft(creep));
+    DestroySubT(MRight(creep));
+    std::destroy_at(&creep->key_);
+    node_traits::destroy(alloc_, creep);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::CreateNode(Args &&...args) {
+  EnsureNil();
+
+  node_type *node = node_traits::allocate(alloc_, 1);
+
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+
+  return node;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::DestroyNode(
+    node_type *node) noexcept {
+  std::destroy_at(&node->key_);
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+/*The nil leaf is only needed once there are nodes to hang off it, so empty
+  trees never allocate*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::EnsureNil() {
+  if (nil_ == nullptr) {
+    node_type *nil = node_traits::allocate(alloc_, 1);
+    node_traits::construct(alloc_, nil, Header());
+    nil_ = nil;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::FreeNil() noexcept {
+  if (nil_ != nullptr) {
+    node_traits::destroy(alloc_, nil_);
+    node_traits::deallocate(alloc_, nil_, 1);
+    nil_ = nullptr;
+  }
+}
+
+/*The end node lives inside the tree object, so whenever nodes change
+  hands the extreme nodes have to be pointed at the new owner's one*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::LinkSentinel() noexcept {
+  sentinel_->SetParent(nullptr);
+
+  if (root_ == nullptr) {
+    head_ = tail_ = sentinel_;
+    sentinel_->left_child_ = sentinel_->right_child_ = sentinel_;
+    Thread(sentinel_, sentinel_);
+
+  } else {
+    head_->left_child_ = sentinel_;
+    tail_->right_child_ = sentinel_;
+    sentinel_->left_child_ = sentinel_->right_child_ = tail_;
+    Thread(sentinel_, head_);
+    Thread(tail_, sentinel_);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Thread(
+    node_type *prev, node_type *next) noexcept {
+  if constexpr (Threaded) {
+    prev->next_ = next;
+    next->prev_ = prev;
+  }
+}
+
+/*Threads the subtree in key order after prev and returns its last node*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::ThreadSubT(
+    node_type *node, node_type *prev) noexcept {
+  if (node == nullptr || IsLeaf(node)) {
+    return prev;
+  }
+
+  Thread(ThreadSubT(node->left_child_, prev), node);
+
+  return ThreadSubT(node->right_child_, node);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Adopt(
+    RBTree &other, node_type *node, bool linked) {
+  if (linked) {
+    EnsureNil();
+    return node;
+  }
+
+  node_type *adopted = CreateNode(std::move(node->key_));
+  other.DestroyNode(node);
+  return adopted;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::Adopt(node_handle &nh) {
+  node_type *node = nh.node_;
+
+  if (adopt_allocations(alloc_, *nh.alloc_)) {
+    EnsureNil();
+    nh.node_ = nullptr;
+    nh.alloc_.reset();
+    return node;
+  }
+
+  node_type *adopted = CreateNode(std::move(node->key_));
+  nh.Reset();
+  return adopted;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator,
+          bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_unique(
+    const value_type &val) {
+  std::pair<node_type *, bool> res = GetInsertUniqPos(extracter_(val));
+
+  if (res.second) {
+    return std::make_pair(Emplace(res.first, val), true);
   }
 
-  Free(MLeft(creep));
-  Free(MRight(creep));
-  delete creep;
+  return std::make_pair(iterator(res.first), false);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-std::pair<typename RBTree<K, T, Compare, Extracter>::iterator, bool>
-RBTree<K, T, Compare, Extracter>::insert_unique(const value_type &val) {
-  std::pair<iterator, bool> out;
-  std::pair<node_type *, bool> res = GetInsertUniqPos(val);
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator,
+          bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_unique(
+    value_type &&val) {
+  std::pair<node_type *, bool> res = GetInsertUniqPos(extracter_(val));
 
   if (res.second) {
-    return out = std::make_pair(Insert(res.first, val), true);
+    return std::make_pair(Emplace(res.first, std::move(val)), true);
+  }
+
+  return std::make_pair(iterator(res.first), false);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_equal(
+    const value_type &val) {
+  return Emplace(GetInsertEqPos(extracter_(val)), val);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_equal(
+    value_type &&val) {
+  return Emplace(GetInsertEqPos(extracter_(val)), std::move(val));
+}
+
+/*The key is only known once the value is built, so the node is made up
+  front and dropped again if the key turns out to be taken*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator,
+          bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::emplace_unique(
+    Args &&...args) {
+  node_type *node = CreateNode(std::forward<Args>(args)...);
+  std::pair<node_type *, bool> res = GetInsertUniqPos(extracter_(node->key_));
+
+  if (!res.second) {
+    DestroyNode(node);
+    return std::make_pair(iterator(res.first), false);
+  }
+
+  return std::make_pair(Insert(res.first, node), true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::emplace_equal(
+    Args &&...args) {
+  node_type *node = CreateNode(std::forward<Args>(args)...);
+
+  return Insert(GetInsertEqPos(extracter_(node->key_)), node);
+}
+
+/*Looks the key up first and builds the value from args only on a miss*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator,
+          bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::try_emplace_unique(
+    const key_type &key, Args &&...args) {
+  std::pair<node_type *, bool> res = GetInsertUniqPos(key);
+
+  if (!res.second) {
+    return std::make_pair(iterator(res.first), false);
+  }
+
+  return std::make_pair(Emplace(res.first, std::forward<Args>(args)...), true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename V>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_hint_unique(
+    const_iterator hint, V &&val) {
+  std::pair<node_type *, bool> res = GetHintUniqPos(hint, extracter_(val));
+
+  if (!res.second) {
+    return iterator(res.first);
+  }
+
+  return Emplace(res.first, std::forward<V>(val));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename V>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_hint_equal(
+    const_iterator hint, V &&val) {
+  std::pair<node_type *, bool> res = GetHintEqPos(hint, extracter_(val));
+
+  return Insert(res.first, CreateNode(std::forward<V>(val)), res.second);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::emplace_hint_unique(
+    const_iterator hint, Args &&...args) {
+  node_type *node = CreateNode(std::forward<Args>(args)...);
+  std::pair<node_type *, bool> res =
+      GetHintUniqPos(hint, extracter_(node->key_));
+
+  if (!res.second) {
+    DestroyNode(node);
+    return iterator(res.first);
+  }
+
+  return Insert(res.first, node);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::emplace_hint_equal(
+    const_iterator hint, Args &&...args) {
+  node_type *node = CreateNode(std::forward<Args>(args)...);
+  std::pair<node_type *, bool> res = GetHintEqPos(hint, extracter_(node->key_));
+
+  return Insert(res.first, node, res.second);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_unique(
+    InputIt first, InputIt last) {
+  if constexpr (is_forward_iterator<InputIt>::value) {
+    if (empty()) {
+      std::pair<bool, size_type> sorted = SortedLength(first, last, true);
+
+      if (sorted.first) {
+        BuildSorted(first, last, sorted.second, true);
+        return;
+      }
+    }
+  }
+
+  for (; first != last; ++first) {
+    insert_hint_unique(cend(), *first);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_equal(
+    InputIt first, InputIt last) {
+  if constexpr (is_forward_iterator<InputIt>::value) {
+    if (empty()) {
+      std::pair<bool, size_type> sorted = SortedLength(first, last, false);
+
+      if (sorted.first) {
+        BuildSorted(first, last, sorted.second, false);
+        return;
+      }
+    }
   }
 
-  return out = std::make_pair(iterator(res.first), false);
+  for (; first != last; ++first) {
+    insert_hint_equal(cend(), *first);
+  }
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::insert_equal(const value_type &val) {
-  node_type *pos = GetInsertEqPos(val);
+/*Inserts a batch on a pool: the values are copied into nodes by the calling
+  thread, then sorted, linked into a tree and combined with ours in parallel.
+  A key already present keeps our value*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_unique(
+    InputIt first, InputIt last, thread_pool &pool) {
+  InsertShared(first, last, true, pool);
+}
 
-  return Insert(pos, val);
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_equal(
+    InputIt first, InputIt last, thread_pool &pool) {
+  InsertShared(first, last, false, pool);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::MLeft(const node_type *current) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::MLeft(
+    const node_type *current) noexcept {
   return current->left_child_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::MRight(const node_type *current) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::MRight(
+    const node_type *current) noexcept {
   return current->right_child_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-std::pair<typename RBTree<K, T, Compare, Extracter>::node_type *, bool>
-RBTree<K, T, Compare, Extracter>::GetInsertUniqPos(const value_type &k) {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::node_type *,
+    bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::GetInsertUniqPos(
+    const key_type &key) {
   std::pair<node_type *, bool> res;
   node_type *tmp = root_;
   node_type *parent = nullptr;
@@ -350,7 +1153,7 @@ RBTree<K, T, Compare, Extracter>::GetInsertUniqPos(const value_type &k) {
 
   while (tmp != nil_ && tmp != sentinel_ && tmp != nullptr) {
     parent = tmp;
-    comp = comp_(extracter_(k), extracter_(tmp->key_));
+    comp = comp_(key, extracter_(tmp->key_));
     tmp = comp ? MLeft(tmp) : MRight(tmp);
   }
 
@@ -368,182 +1171,327 @@ RBTree<K, T, Compare, Extracter>::GetInsertUniqPos(const value_type &k) {
     }
   }
 
-  if (comp_(extracter_(x.it_->key_), extracter_(k))) {
+  if (comp_(extracter_(x.it_->key_), key)) {
     return res = std::make_pair(parent, true);
   }
 
   return res = std::make_pair(x.it_, false);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::GetInsertEqPos(const value_type &k) {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::GetInsertEqPos(
+    const key_type &key) {
   node_type *tmp = root_;
   node_type *parent = nullptr;
 
   while (tmp != nil_ && tmp != sentinel_ && tmp != nullptr) {
     parent = tmp;
-    tmp = comp_(k, tmp->key_) ? MLeft(tmp) : MRight(tmp);
+    tmp = comp_(key, extracter_(tmp->key_)) ? MLeft(tmp) : MRight(tmp);
   }
 
   return parent;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::RebalanceInsert(
-    node_type *node) noexcept {
+/*A hint next to the right spot, end() for appends included, saves the
+  descent from the root. Otherwise falls back to GetInsertUniqPos*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::node_type *,
+    bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::GetHintUniqPos(
+    const_iterator hint, const key_type &key) {
+  node_type *pos = hint.it_;
+
+  if (pos == sentinel_) {
+    if (tree_size_ > 0 && comp_(extracter_(tail_->key_), key)) {
+      return std::make_pair(tail_, true);
+    }
+
+    return GetInsertUniqPos(key);
+  }
+
+  if (comp_(key, extracter_(pos->key_))) {
+    if (pos == head_) {
+      return std::make_pair(head_, true);
+    }
+
+    node_type *before = (--hint).it_;
+
+    if (comp_(extracter_(before->key_), key)) {
+      return std::make_pair(IsLeaf(before->right_child_) ? before : pos, true);
+    }
+
+    return GetInsertUniqPos(key);
+  }
+
+  if (comp_(extracter_(pos->key_), key)) {
+    if (pos == tail_) {
+      return std::make_pair(tail_, true);
+    }
+
+    node_type *after = (++hint).it_;
+
+    if (comp_(key, extracter_(after->key_))) {
+      return std::make_pair(IsLeaf(pos->right_child_) ? pos : after, true);
+    }
+
+    return GetInsertUniqPos(key);
+  }
+
+  return std::make_pair(pos, false);
+}
+
+/*Returns the parent and whether the new node goes to its left, which for
+  equal keys cannot be told from comparing against the parent*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::node_type *,
+    bool>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::GetHintEqPos(
+    const_iterator hint, const key_type &key) {
+  node_type *pos = hint.it_;
+
+  if (pos == sentinel_) {
+    if (tree_size_ > 0 && !comp_(key, extracter_(tail_->key_))) {
+      return std::make_pair(tail_, false);
+    }
+
+  } else if (!comp_(extracter_(pos->key_), key)) {
+    if (pos == head_) {
+      return std::make_pair(head_, true);
+    }
+
+    node_type *before = (--hint).it_;
+
+    if (!comp_(key, extracter_(before->key_))) {
+      return IsLeaf(before->right_child_) ? std::make_pair(before, false)
+                                          : std::make_pair(pos, true);
+    }
+
+  } else {
+    if (pos == tail_) {
+      return std::make_pair(tail_, false);
+    }
+
+    node_type *after = (++hint).it_;
+
+    if (!comp_(extracter_(after->key_), key)) {
+      return IsLeaf(pos->right_child_) ? std::make_pair(pos, false)
+                                       : std::make_pair(after, true);
+    }
+  }
+
+  node_type *parent = GetInsertEqPos(key);
+
+  return std::make_pair(
+      parent, parent != nullptr && comp_(key, extracter_(parent->key_)));
+}
+
+/*Returns true when the root had to be repainted black, which adds a black
+  level to every path*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::RebalanceInsert(node_type *node,
+                                       node_type *&root) noexcept {
   node_type *uncle = nil_;
 
-  while (node != root_ && node->parent_->color_ == RED) {
-    if (node->parent_ == node->parent_->parent_->left_child_) {
-      uncle = node->parent_->parent_->right_child_;
+  while (node != root && node->Parent()->Color() == RED) {
+    if (node->Parent() == node->Parent()->Parent()->left_child_) {
+      uncle = node->Parent()->Parent()->right_child_;
 
-      if (uncle->color_ == RED) {
-        node->parent_->color_ = BLACK;
-        uncle->color_ = BLACK;
-        node->parent_->parent_->color_ = RED;
-        node = node->parent_->parent_;
+      if (uncle->Color() == RED) {
+        node->Parent()->SetColor(BLACK);
+        uncle->SetColor(BLACK);
+        node->Parent()->Parent()->SetColor(RED);
+        node = node->Parent()->Parent();
 
       } else {
-        if (node == node->parent_->right_child_) {
-          node = node->parent_;
-          LeftRotate(node);
+        if (node == node->Parent()->right_child_) {
+          node = node->Parent();
+          LeftRotate(node, root);
         }
 
-        node->parent_->color_ = BLACK;
-        node->parent_->parent_->color_ = RED;
-        RightRotate(node->parent_->parent_);
+        node->Parent()->SetColor(BLACK);
+        node->Parent()->Parent()->SetColor(RED);
+        RightRotate(node->Parent()->Parent(), root);
       }
 
     } else {
-      uncle = node->parent_->parent_->left_child_;
+      uncle = node->Parent()->Parent()->left_child_;
 
-      if (uncle->color_ == RED) {
-        node->parent_->color_ = BLACK;
-        uncle->color_ = BLACK;
-        node->parent_->parent_->color_ = RED;
-        node = node->parent_->parent_;
+      if (uncle->Color() == RED) {
+        node->Parent()->SetColor(BLACK);
+        uncle->SetColor(BLACK);
+        node->Parent()->Parent()->SetColor(RED);
+        node = node->Parent()->Parent();
 
       } else {
-        if (node == node->parent_->left_child_) {
-          node = node->parent_;
-          RightRotate(node);
+        if (node == node->Parent()->left_child_) {
+          node = node->Parent();
+          RightRotate(node, root);
         }
 
-        node->parent_->color_ = BLACK;
-        node->parent_->parent_->color_ = RED;
-        LeftRotate(node->parent_->parent_);
+        node->Parent()->SetColor(BLACK);
+        node->Parent()->Parent()->SetColor(RED);
+        LeftRotate(node->Parent()->Parent(), root);
       }
     }
   }
 
-  root_->color_ = BLACK;
+  bool grown = root->Color() == RED;
+  root->SetColor(BLACK);
 
-  tail_->right_child_ = sentinel_;
-  head_->left_child_ = sentinel_;
-  sentinel_->left_child_ = sentinel_->right_child_ = tail_;
+  return grown;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::LeftRotate(node_type *x) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::LeftRotate(
+    node_type *x, node_type *&root) noexcept {
   node_type *y = x->right_child_;
   x->right_child_ = y->left_child_;
 
   if (y->left_child_ != nil_ && y->left_child_ != sentinel_) {
-    y->left_child_->parent_ = x;
+    y->left_child_->SetParent(x);
   }
 
-  y->parent_ = x->parent_;
+  y->SetParent(x->Parent());
 
-  if (x->parent_ == nullptr) {
-    root_ = y;
+  if (x->Parent() == nullptr) {
+    root = y;
 
-  } else if (x == x->parent_->left_child_) {
-    x->parent_->left_child_ = y;
+  } else if (x == x->Parent()->left_child_) {
+    x->Parent()->left_child_ = y;
 
   } else {
-    x->parent_->right_child_ = y;
+    x->Parent()->right_child_ = y;
   }
 
   y->left_child_ = x;
-  x->parent_ = y;
+  x->SetParent(y);
+
+  if constexpr (Indexed) {
+    y->subtree_size_ = x->subtree_size_;
+    ResizeSubtree(x);
+  }
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::RightRotate(node_type *y) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RightRotate(
+    node_type *y, node_type *&root) noexcept {
   node_type *x = y->left_child_;
   y->left_child_ = x->right_child_;
 
   if (x->right_child_ != nil_ && x->right_child_ != sentinel_) {
-    x->right_child_->parent_ = y;
+    x->right_child_->SetParent(y);
   }
 
-  x->parent_ = y->parent_;
+  x->SetParent(y->Parent());
 
-  if (y->parent_ == nullptr) {
-    root_ = x;
+  if (y->Parent() == nullptr) {
+    root = x;
 
-  } else if (y == y->parent_->left_child_) {
-    y->parent_->left_child_ = x;
+  } else if (y == y->Parent()->left_child_) {
+    y->Parent()->left_child_ = x;
 
   } else {
-    y->parent_->right_child_ = x;
+    y->Parent()->right_child_ = x;
   }
 
   x->right_child_ = y;
-  y->parent_ = x;
+  y->SetParent(x);
+
+  if constexpr (Indexed) {
+    x->subtree_size_ = y->subtree_size_;
+    ResizeSubtree(y);
+  }
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::Insert(node_type *parent,
-                                         const value_type &arg) {
-  node_type *newNode = new node_type;
-  newNode->key_ = arg;
-  newNode->left_child_ = nil_;
-  newNode->right_child_ = nil_;
-  newNode->parent_ = parent;
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::Emplace(node_type *parent, Args &&...args) {
+  return Insert(parent, CreateNode(std::forward<Args>(args)...));
+}
 
-  return iterator(InsertHandler(parent, newNode));
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Insert(
+    node_type *parent, node_type *nh) noexcept {
+  return Insert(parent, nh,
+                parent != nullptr &&
+                    comp_(extracter_(nh->key_), extracter_(parent->key_)));
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::Insert(node_type *parent,
-                                         node_type *nh) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Insert(
+    node_type *parent, node_type *nh, bool left) noexcept {
   nh->left_child_ = nil_;
   nh->right_child_ = nil_;
-  nh->parent_ = parent;
+  nh->SetParent(parent);
+
+  return iterator(InsertHandler(parent, nh, left));
+}
 
-  return iterator(InsertHandler(parent, nh));
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::IsLeaf(
+    const node_type *node) const noexcept {
+  return node == nil_ || node == sentinel_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::InsertHandler(node_type *parent,
-                                                node_type *nh) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::InsertHandler(
+    node_type *parent, node_type *nh, bool left) noexcept {
   ++tree_size_;
 
-  nh->color_ = RED;
+  nh->SetColor(RED);
+
+  if constexpr (Indexed) {
+    nh->subtree_size_ = 1;
+    GrowPath(parent);
+  }
 
   if (parent == nullptr) {
     root_ = nh;
     head_ = nh;
     tail_ = nh;
 
-    head_->left_child_ = sentinel_;
-    tail_->right_child_ = sentinel_;
-    sentinel_->left_child_ = sentinel_->right_child_ = tail_;
-
-    root_->color_ = BLACK;
+    root_->SetColor(BLACK);
+    LinkSentinel();
 
     return iterator(root_);
   }
 
-  if (comp_(extracter_(nh->key_), extracter_(parent->key_))) {
+  if (left) {
+    if constexpr (Threaded) {
+      Thread(parent->prev_, nh);
+    }
+
+    Thread(nh, parent);
     parent->left_child_ = nh;
 
   } else {
+    if constexpr (Threaded) {
+      Thread(nh, parent->next_);
+    }
+
+    Thread(parent, nh);
     parent->right_child_ = nh;
   }
 
@@ -555,39 +1503,42 @@ RBTree<K, T, Compare, Extracter>::InsertHandler(node_type *parent,
     tail_ = MRight(tail_);
   }
 
-  RebalanceInsert(nh);
+  RebalanceInsert(nh, root_);
+  LinkSentinel();
 
   return iterator(nh);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::search(const key_type target) const noexcept {
-  return iterator(SearchHelper(root_, target));
-}
+/*Only the comparator is consulted, so target may be of any type it can
+  order against the stored keys*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::search(
+    const Key &target) const noexcept {
+  node_type *creep = root_;
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::SearchHelper(node_type *node,
-                                               key_type data) const noexcept {
-  if (node == nullptr || node == sentinel_ || node == nil_) {
-    return sentinel_;
-  }
+  while (creep != nullptr && creep != nil_ && creep != sentinel_) {
+    if (comp_(target, extracter_(creep->key_))) {
+      creep = creep->left_child_;
 
-  if (data == extracter_(node->key_)) {
-    return node;
-  }
+    } else if (comp_(extracter_(creep->key_), target)) {
+      creep = creep->right_child_;
 
-  if (data < extracter_(node->key_)) {
-    return SearchHelper(node->left_child_, data);
+    } else {
+      return iterator(creep);
+    }
   }
 
-  return SearchHelper(node->right_child_, data);
+  return iterator(sentinel_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::erase(iterator pos) {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::erase(iterator pos) {
   if (root_ == nullptr) {
     return end();
   }
@@ -598,406 +1549,2693 @@ RBTree<K, T, Compare, Extracter>::erase(iterator pos) {
 
   std::pair<node_type *, iterator> deletable = EraseHandler(pos);
 
-  delete deletable.first;
+  DestroyNode(deletable.first);
 
   return deletable.second;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::Transplant(node_type *from,
-                                                  node_type *to) noexcept {
-  if (from->parent_ == nullptr) {
-    root_ = to;
-
-  } else if (from == from->parent_->left_child_) {
-    from->parent_->left_child_ = to;
-
-  } else {
-    from->parent_->right_child_ = to;
-  }
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::erase(
+    const_iterator first, const_iterator last) {
+  EraseRange(first.it_, last.it_);
 
-  to->parent_ = from->parent_;
+  return iterator(last.it_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::RebalanceDelete(node_type *x) noexcept {
-  node_type *sibling = nullptr;
+/*Erases every value equivalent to key and returns how many there were*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::erase_key(
+    const Key &key) {
+  return EraseRange(LowerBoundNode(key), UpperBoundNode(key));
+}
 
-  while (x != root_ && x->color_ == BLACK) {
-    if (x == x->parent_->left_child_) {
-      sibling = x->parent_->right_child_;
+/*Every value is visited anyway, so the survivors are relinked into a balanced
+  tree in the same linear pass instead of being erased one at a time. If pred
+  throws, nothing further is erased*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Pred>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::erase_if(
+    Pred pred) {
+  node_type *rest = Flatten(root_, nullptr);
+  node_type *kept = nullptr;
+  node_type **kept_end = &kept;
+  size_type kept_size = 0;
+  size_type erased = 0;
+
+  auto next = [&kept]() noexcept {
+    node_type *node = kept;
+    kept = node->right_child_;
+    return node;
+  };
 
-      if (sibling->color_ == RED) {
-        sibling->color_ = BLACK;
-        x->parent_->color_ = RED;
-        LeftRotate(x->parent_);
-        sibling = x->parent_->right_child_;
-      }
+  try {
+    while (rest != nullptr) {
+      node_type *node = rest;
+      bool drop = pred(node->key_);
+      rest = node->right_child_;
 
-      if (sibling->left_child_->color_ == BLACK &&
-          sibling->right_child_->color_ == BLACK) {
-        sibling->color_ = RED;
-        x = x->parent_;
+      if (drop) {
+        DestroyNode(node);
+        ++erased;
 
       } else {
-        if (sibling->right_child_->color_ == BLACK) {
-          sibling->left_child_->color_ = BLACK;
-          sibling->color_ = RED;
-          RightRotate(sibling);
-          sibling = x->parent_->right_child_;
-        }
-
-        sibling->color_ = x->parent_->color_;
-        x->parent_->color_ = BLACK;
-        sibling->right_child_->color_ = BLACK;
-        LeftRotate(x->parent_);
-        x = root_;
+        *kept_end = node;
+        kept_end = &node->right_child_;
+        ++kept_size;
       }
+    }
 
-    } else {
-      sibling = x->parent_->left_child_;
+  } catch (...) {
+    for (*kept_end = rest; rest != nullptr; rest = rest->right_child_) {
+      ++kept_size;
+    }
 
-      if (sibling->color_ == RED) {
-        sibling->color_ = BLACK;
-        x->parent_->color_ = RED;
-        RightRotate(x->parent_);
-        sibling = x->parent_->left_child_;
-      }
+    Unlink();
+    Link(kept_size, next);
+    throw;
+  }
 
-      if (sibling->left_child_->color_ == BLACK &&
-          sibling->right_child_->color_ == BLACK) {
-        sibling->color_ = RED;
-        x = x->parent_;
+  *kept_end = nullptr;
+  Unlink();
+  Link(kept_size, next);
 
-      } else {
-        if (sibling->left_child_->color_ == BLACK) {
-          sibling->right_child_->color_ = BLACK;
-          sibling->color_ = RED;
-          LeftRotate(sibling);
-          sibling = x->parent_->left_child_;
-        }
+  return erased;
+}
 
-        sibling->color_ = x->parent_->color_;
-        x->parent_->color_ = BLACK;
-        sibling->left_child_->color_ = BLACK;
-        RightRotate(x->parent_);
+/*Ranges up to log n long are erased node by node; longer ones are cut out
+  whole*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::EraseRange(
+    node_type *first, node_type *last) {
+  if (first == head_ && last == sentinel_) {
+    size_type erased = tree_size_;
+    clear();
+    return erased;
+  }
+
+  iterator probe(first);
+  size_type length = 0;
+
+  for (size_type limit = Log2(tree_size_); probe.it_ != last; ++probe) {
+    if (++length > limit) {
+      return SpliceOut(first, last);
+    }
+  }
+
+  while (first != last) {
+    node_type *next = (++iterator(first)).it_;
+    DestroyNode(EraseHandler(const_iterator(first)).first);
+    first = next;
+  }
+
+  return length;
+}
+
+/*Splits the tree at first and at last and joins what lies outside, so the
+  rebalancing costs O(log n) however long the range is. Only freeing the
+  nodes is linear*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SpliceOut(
+    node_type *first, node_type *last) noexcept {
+  node_type *before = first == head_ ? sentinel_ : (--iterator(first)).it_;
+
+  head_->left_child_ = nil_;
+  tail_->right_child_ = nil_;
+
+  std::pair<subtree_type, subtree_type> lower = SplitSubT(first);
+  node_type *dropped = lower.second.first;
+  root_ = lower.first.first;
+
+  if (last != sentinel_) {
+    std::pair<subtree_type, subtree_type> upper = SplitSubT(last);
+    dropped = upper.first.first;
+    root_ = JoinSubT(lower.first, last, upper.second).first;
+  }
+
+  first->left_child_ = dropped;
+  first->right_child_ = nil_;
+  size_type erased = Free(first);
+
+  if (root_ == nil_) {
+    root_ = nullptr;
+
+  } else {
+    root_->SetColor(BLACK);
+  }
+
+  if (before == sentinel_) {
+    head_ = last;
+  }
+
+  if (last == sentinel_) {
+    tail_ = before;
+  }
+
+  tree_size_ -= erased;
+  Thread(before, last);
+  LinkSentinel();
+
+  return erased;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Transplant(
+    node_type *from, node_type *to) noexcept {
+  if (from->Parent() == nullptr) {
+    root_ = to;
+
+  } else if (from == from->Parent()->left_child_) {
+    from->Parent()->left_child_ = to;
+
+  } else {
+    from->Parent()->right_child_ = to;
+  }
+
+  to->SetParent(from->Parent());
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::RebalanceDelete(
+    node_type *x) noexcept {
+  node_type *sibling = nullptr;
+
+  while (x != root_ && x->Color() == BLACK) {
+    if (x == x->Parent()->left_child_) {
+      sibling = x->Parent()->right_child_;
+
+      if (sibling->Color() == RED) {
+        sibling->SetColor(BLACK);
+        x->Parent()->SetColor(RED);
+        LeftRotate(x->Parent(), root_);
+        sibling = x->Parent()->right_child_;
+      }
+
+      if (sibling->left_child_->Color() == BLACK &&
+          sibling->right_child_->Color() == BLACK) {
+        sibling->SetColor(RED);
+        x = x->Parent();
+
+      } else {
+        if (sibling->right_child_->Color() == BLACK) {
+          sibling->left_child_->SetColor(BLACK);
+          sibling->SetColor(RED);
+          RightRotate(sibling, root_);
+          sibling = x->Parent()->right_child_;
+        }
+
+        sibling->SetColor(x->Parent()->Color());
+        x->Parent()->SetColor(BLACK);
+        sibling->right_child_->SetColor(BLACK);
+        LeftRotate(x->Parent(), root_);
+        x = root_;
+      }
+
+    } else {
+      sibling = x->Parent()->left_child_;
+
+      if (sibling->Color() == RED) {
+        sibling->SetColor(BLACK);
+        x->Parent()->SetColor(RED);
+        RightRotate(x->Parent(), root_);
+        sibling = x->Parent()->left_child_;
+      }
+
+      if (sibling->left_child_->Color() == BLACK &&
+          sibling->right_child_->Color() == BLACK) {
+        sibling->SetColor(RED);
+        x = x->Parent();
+
+      } else {
+        if (sibling->left_child_->Color() == BLACK) {
+          sibling->right_child_->SetColor(BLACK);
+          sibling->SetColor(RED);
+          LeftRotate(sibling, root_);
+          sibling = x->Parent()->left_child_;
+        }
+
+        sibling->SetColor(x->Parent()->Color());
+        x->Parent()->SetColor(BLACK);
+        sibling->left_child_->SetColor(BLACK);
+        RightRotate(x->Parent(), root_);
         x = root_;
       }
     }
   }
 
-  x->color_ = BLACK;
+  x->SetColor(BLACK);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::node_type *,
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::iterator>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::EraseHandler(
+    const_iterator pos) noexcept {
+  node_type *tmp = nullptr;
+  node_type *deletable = pos.it_;
+  color_t originalColor = pos.it_->Color();
+
+  if (deletable->left_child_ == nil_ || deletable->left_child_ == sentinel_) {
+    ShrinkPath(deletable->Parent());
+    tmp = deletable->right_child_;
+    Transplant(deletable, deletable->right_child_);
+
+  } else if (deletable->right_child_ == nil_ ||
+             deletable->right_child_ == sentinel_) {
+    ShrinkPath(deletable->Parent());
+    tmp = deletable->left_child_;
+    Transplant(deletable, deletable->left_child_);
+
+  } else {
+    node_type *minNode = FindMinNode(deletable->right_child_);
+    ShrinkPath(minNode->Parent());
+    originalColor = minNode->Color();
+    tmp = minNode->right_child_;
+
+    if (minNode->Parent() == deletable) {
+      tmp->SetParent(minNode);
+
+    } else {
+      Transplant(minNode, minNode->right_child_);
+      minNode->right_child_ = deletable->right_child_;
+      minNode->right_child_->SetParent(minNode);
+    }
+
+    Transplant(deletable, minNode);
+    minNode->left_child_ = deletable->left_child_;
+    minNode->left_child_->SetParent(minNode);
+    minNode->SetColor(deletable->Color());
+
+    if constexpr (Indexed) {
+      minNode->subtree_size_ = deletable->subtree_size_;
+    }
+  }
+
+  if (originalColor == BLACK) {
+    RebalanceDelete(tmp);
+  }
+
+  /*Iterators tell the tail by the sentinel having no parent*/
+  sentinel_->SetParent(nullptr);
+
+  iterator next(deletable);
+
+  if (next.it_->left_child_ == sentinel_ &&
+      next.it_->right_child_ == sentinel_) {
+    ++next;
+    head_ = sentinel_;
+    tail_ = sentinel_;
+
+  } else if (next.it_->left_child_ == sentinel_) {
+    ++next;
+    head_ = next.it_;
+    head_->left_child_ = sentinel_;
+
+  } else if (next.it_->right_child_ == sentinel_) {
+    --next;
+    tail_ = next.it_;
+    tail_->right_child_ = sentinel_;
+    sentinel_->SetParent(nullptr);
+    sentinel_->left_child_ = sentinel_->right_child_ = tail_;
+
+  } else {
+    ++next;
+  }
+
+  if constexpr (Threaded) {
+    Thread(deletable->prev_, deletable->next_);
+  }
+
+  --tree_size_;
+
+  if (root_ == sentinel_) {
+    root_ = nullptr;
+  }
+
+  return std::pair<node_type *, iterator>(deletable, next);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::swap(RBTree &other) {
+  std::swap(root_, other.root_);
+  std::swap(head_, other.head_);
+  std::swap(tail_, other.tail_);
+  std::swap(nil_, other.nil_);
+  std::swap(tree_size_, other.tree_size_);
+  std::swap(alloc_, other.alloc_);
+  LinkSentinel();
+  other.LinkSentinel();
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::merge_unique(
+    RBTree &other) {
+  bool linked = adopt_allocations(alloc_, other.alloc_);
+
+  if (linked && MergeLinked(other, true)) {
+    return;
+  }
+
+  iterator pos;
+  std::pair<node_type *, bool> search_pos;
+  node_type *cutting = nullptr;
+
+  for (auto i = other.begin(), end = other.end(); i != end;) {
+    pos = i++;
+    search_pos = GetInsertUniqPos(extracter_(pos.it_->key_));
+
+    if (search_pos.second) {
+      cutting = other.EraseHandler(pos).first;
+      Insert(search_pos.first, Adopt(other, cutting, linked));
+    }
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::merge_equal(
+    RBTree &other) {
+  bool linked = adopt_allocations(alloc_, other.alloc_);
+
+  if (linked && MergeLinked(other, false)) {
+    return;
+  }
+
+  iterator pos;
+  node_type *cutting = nullptr;
+  node_type *parent = nullptr;
+
+  for (auto i = other.begin(), end = other.end(); i != end;) {
+    pos = i++;
+    cutting = other.EraseHandler(pos).first;
+    parent = GetInsertEqPos(extracter_(cutting->key_));
+    Insert(parent, Adopt(other, cutting, linked));
+  }
+}
+
+/*Moves the values that do not order before key into the returned tree,
+  which shares our allocator. Cutting the tree is O(log n), but every
+  moved node is then visited to point its leaves at the new tree's nil, so
+  a split costs O(log n + moved) and is linear when most values move*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::split(
+    const Key &key) {
+  RBTree greater(get_allocator());
+  node_type *pivot = LowerBoundNode(key);
+
+  if (pivot == sentinel_) {
+    return greater;
+
+  } else if (pivot == head_) {
+    swap(greater);
+    return greater;
+  }
+
+  greater.EnsureNil();
+
+  node_type *before = (--iterator(pivot)).it_;
+  node_type *last = tail_;
+
+  head_->left_child_ = nil_;
+  tail_->right_child_ = nil_;
+
+  std::pair<subtree_type, subtree_type> parts = SplitSubT(pivot);
+  node_type *upper =
+      JoinSubT(subtree_type(nil_, 0), pivot, parts.second).first;
+  size_type moved = greater.RelinkLeaves(upper, nil_, sentinel_);
+
+  root_ = parts.first.first;
+  root_->SetColor(BLACK);
+  tail_ = before;
+  tree_size_ -= moved;
+  LinkSentinel();
+
+  greater.root_ = upper;
+  greater.head_ = pivot;
+  greater.tail_ = last;
+  greater.tree_size_ = moved;
+  greater.LinkSentinel();
+
+  return greater;
+}
+
+/*Appends the values of other, which all have to order after ours, or not
+  before them for join_equal; std::invalid_argument is thrown otherwise and
+  both trees are left as they were. The join runs through merge: the
+  smaller tree has its leaves pointed at the other's nil, so it costs
+  O(log n) plus the size of the smaller tree, not O(log n). Allocators that
+  can neither adopt nor compare equal fall back to moving value by value.
+  other is left empty*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::join_unique(
+    RBTree &other) {
+  JoinChecked(other, true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::join_equal(
+    RBTree &other) {
+  JoinChecked(other, false);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::JoinChecked(
+    RBTree &other, bool unique) {
+  if (this != &other && !empty() && !other.empty()) {
+    const key_type &last = extracter_(tail_->key_);
+    const key_type &first = extracter_(other.head_->key_);
+
+    if (unique ? !comp_(last, first) : comp_(first, last)) {
+      throw std::invalid_argument("Error: joined trees overlap");
+    }
+  }
+
+  if (unique) {
+    merge_unique(other);
+
+  } else {
+    merge_equal(other);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_handle
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::extract(const_iterator pos) {
+  if (pos.it_ == sentinel_ || root_ == nullptr) {
+    return node_handle();
+  }
+
+  return node_handle(EraseHandler(pos).first, alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_handle
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::extract_key(const Key &key) {
+  node_type *bound = LowerBoundNode(key);
+
+  if (bound == sentinel_ || comp_(key, extracter_(bound->key_))) {
+    return node_handle();
+  }
+
+  return extract(const_iterator(bound));
+}
+
+/*The node is linked in as is once we can free what its allocator handed
+  out; it only gets reallocated for allocators that cannot be made to*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::insert_return_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_unique(
+    node_handle &&nh) {
+  if (nh.empty()) {
+    return insert_return_type{end(), false, node_handle()};
+  }
+
+  std::pair<node_type *, bool> res = GetInsertUniqPos(extracter_(nh.value()));
+
+  if (!res.second) {
+    return insert_return_type{iterator(res.first), false, std::move(nh)};
+  }
+
+  return insert_return_type{Insert(res.first, Adopt(nh)), true, node_handle()};
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::insert_equal(
+    node_handle &&nh) {
+  if (nh.empty()) {
+    return end();
+  }
+
+  node_type *parent = GetInsertEqPos(extracter_(nh.value()));
+
+  return Insert(parent, Adopt(nh));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::contains(
+    const Key &key) const noexcept {
+  iterator finder = search(key);
+
+  if (finder == end()) {
+    return false;
+  }
+
+  return true;
+}
+
+/*Writes search(key) for every key, in order. The searches run kLookupLanes
+  at a time, each lane taking one step per round and prefetching the node it
+  moves to, so the cache misses of the lanes overlap instead of following
+  one another*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::find_many(ForwardIt first, ForwardIt last,
+                                     OutputIt out) const {
+  SearchMany(first, last, [this, &out](node_type *found) {
+    *out = iterator(found);
+    ++out;
+  });
+
+  return out;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::contains_many(ForwardIt first, ForwardIt last,
+                                         OutputIt out) const {
+  SearchMany(first, last, [this, &out](node_type *found) {
+    *out = found != sentinel_;
+    ++out;
+  });
+
+  return out;
+}
+
+/*Calls visit with the node search would find for every key, in order.
+  Sorted keys are checked for up front, so that unsorted ones do not pay
+  for a comparison with the key before*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt, typename Visit>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SearchMany(
+    ForwardIt first, ForwardIt last, Visit visit) const {
+  bool sorted = std::is_sorted(
+      first, last,
+      [this](const auto &lhs, const auto &rhs) { return comp_(lhs, rhs); });
+  size_type width = tree_size_ < kLookupSpill ? 1 : kLookupLanes;
+
+  if (width == 1 && !sorted) {
+    for (; first != last; ++first) {
+      visit(search(*first).it_);
+    }
+
+    return;
+  }
+
+  Lane<ForwardIt> lanes[kLookupLanes];
+  size_type started = 0;
+
+  while (first != last) {
+    size_type count = 0;
+
+    for (; count < width && first != last; ++count, ++first) {
+      StartLane(lanes[count], first, sorted && count < started);
+    }
+
+    started = std::max(started, count);
+
+    for (bool moving = true; moving;) {
+      moving = false;
+
+      for (size_type i = 0; i < count; ++i) {
+        moving = StepLane(lanes[i]) || moving;
+      }
+    }
+
+    for (size_type i = 0; i < count; ++i) {
+      visit(lanes[i].node_);
+    }
+  }
+}
+
+/*A lane keeps to every kLookupLanes-th key, so with sorted keys it goes on
+  from its last search. Every node that search went right at is less than its
+  key and so less than this one, and every turn left that is kept is greater,
+  so the search from the root would come down the same way to where this one
+  starts*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::StartLane(
+    Lane<ForwardIt> &lane, ForwardIt key, bool ascending) const noexcept {
+  if (!ascending) {
+    lane.depth_ = 0;
+  }
+
+  while (lane.depth_ > 0 &&
+         !comp_(*key, extracter_(lane.turns_[lane.depth_ - 1]->key_))) {
+    --lane.depth_;
+  }
+
+  lane.key_ = key;
+  lane.node_ = lane.depth_ > 0 ? lane.turns_[lane.depth_ - 1]->left_child_
+                               : root_;
+  lane.done_ = false;
+  Prefetch(lane.node_);
+}
+
+/*One step down; false once the lane has stopped, with node_ left at the
+  match or the end node*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::StepLane(
+    Lane<ForwardIt> &lane) const noexcept {
+  if (lane.done_) {
+    return false;
+  }
+
+  node_type *node = lane.node_;
+
+  if (node == nullptr || node == nil_ || node == sentinel_) {
+    lane.node_ = sentinel_;
+    lane.done_ = true;
+    return false;
+  }
+
+  if (comp_(*lane.key_, extracter_(node->key_))) {
+    lane.turns_[lane.depth_++] = node;
+    lane.node_ = node->left_child_;
+
+  } else if (comp_(extracter_(node->key_), *lane.key_)) {
+    lane.node_ = node->right_child_;
+
+  } else {
+    lane.done_ = true;
+    return false;
+  }
+
+  Prefetch(lane.node_);
+  return true;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Prefetch(
+    [[maybe_unused]] const node_type *node) noexcept {
+#if defined(__GNUC__)
+  __builtin_prefetch(node);
+#endif
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::lower_bound(
+    const Key &key) noexcept {
+  return iterator(LowerBoundNode(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::lower_bound(
+    const Key &key) const noexcept {
+  return const_iterator(LowerBoundNode(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::upper_bound(
+    const Key &key) noexcept {
+  return iterator(UpperBoundNode(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::upper_bound(
+    const Key &key) const noexcept {
+  return const_iterator(UpperBoundNode(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::LowerBoundNode(
+    const Key &key) const noexcept {
+  node_type *creep = root_;
+  node_type *bound = sentinel_;
+
+  while (creep != nullptr && creep != nil_ && creep != sentinel_) {
+    if (comp_(extracter_(creep->key_), key)) {
+      creep = creep->right_child_;
+
+    } else {
+      bound = creep;
+      creep = creep->left_child_;
+    }
+  }
+
+  return bound;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::UpperBoundNode(
+    const Key &key) const noexcept {
+  node_type *creep = root_;
+  node_type *bound = sentinel_;
+
+  while (creep != nullptr && creep != nil_ && creep != sentinel_) {
+    if (comp_(key, extracter_(creep->key_))) {
+      bound = creep;
+      creep = creep->left_child_;
+
+    } else {
+      creep = creep->right_child_;
+    }
+  }
+
+  return bound;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CountLess(
+    const Key &key) const noexcept {
+  node_type *creep = root_;
+  size_type less = 0;
+
+  while (creep != nullptr && creep != nil_ && creep != sentinel_) {
+    if (comp_(extracter_(creep->key_), key)) {
+      less += creep->left_child_->subtree_size_ + 1;
+      creep = creep->right_child_;
+
+    } else {
+      creep = creep->left_child_;
+    }
+  }
+
+  return less;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CountNotGreater(
+    const Key &key) const noexcept {
+  node_type *creep = root_;
+  size_type not_greater = 0;
+
+  while (creep != nullptr && creep != nil_ && creep != sentinel_) {
+    if (comp_(key, extracter_(creep->key_))) {
+      creep = creep->left_child_;
+
+    } else {
+      not_greater += creep->left_child_->subtree_size_ + 1;
+      creep = creep->right_child_;
+    }
+  }
+
+  return not_greater;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::count(
+    const Key &k) const {
+  if constexpr (Indexed) {
+    return CountNotGreater(k) - CountLess(k);
+
+  } else {
+    size_type coincidences = 0;
+
+    for (auto it = const_iterator(LowerBoundNode(k)),
+              last = const_iterator(UpperBoundNode(k));
+         it != last; ++it) {
+      ++coincidences;
+    }
+
+    return coincidences;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator,
+          typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::iterator>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::equal_range(
+    const Key &k) {
+  iterator lower = lower_bound(k);
+  iterator upper = upper_bound(k);
+
+  return std::make_pair(lower, upper);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+std::pair<
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::const_iterator,
+    typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                    Threaded>::const_iterator>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::equal_range(
+    const Key &k) const {
+  const_iterator lower = lower_bound(k);
+  const_iterator upper = upper_bound(k);
+
+  return std::make_pair(lower, upper);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::rank(
+    const Key &k) const {
+  if constexpr (Indexed) {
+    return CountLess(k);
+
+  } else {
+    return distance(cbegin(), lower_bound(k));
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::select(size_type k) noexcept {
+  return iterator(SelectNode(k));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::const_iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::select(
+    size_type k) const noexcept {
+  return const_iterator(SelectNode(k));
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::distance(
+    const_iterator first, const_iterator last) const noexcept {
+  if constexpr (Indexed) {
+    return Position(last.it_) - Position(first.it_);
+
+  } else {
+    size_type steps = 0;
+
+    for (; first != last; ++first) {
+      ++steps;
+    }
+
+    return steps;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SelectNode(
+    size_type k) const noexcept {
+  if (k >= tree_size_) {
+    return sentinel_;
+  }
+
+  if constexpr (Indexed) {
+    node_type *creep = root_;
+
+    while (k != creep->left_child_->subtree_size_) {
+      if (k < creep->left_child_->subtree_size_) {
+        creep = creep->left_child_;
+
+      } else {
+        k -= creep->left_child_->subtree_size_ + 1;
+        creep = creep->right_child_;
+      }
+    }
+
+    return creep;
+
+  } else {
+    const_iterator creep = cbegin();
+
+    for (; k > 0; --k) {
+      ++creep;
+    }
+
+    return creep.it_;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Position(
+    const node_type *node) const noexcept {
+  if (node == sentinel_) {
+    return tree_size_;
+  }
+
+  size_type position = node->left_child_->subtree_size_;
+
+  for (; node->Parent() != nullptr; node = node->Parent()) {
+    if (node == node->Parent()->right_child_) {
+      position += node->Parent()->left_child_->subtree_size_ + 1;
+    }
+  }
+
+  return position;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CopyT(
+    const RBTree &other) {
+  if (this != &other) {
+    if (!empty()) {
+      clear();
+    }
+
+    tree_size_ = other.tree_size_;
+    root_ = CopySubT(other.root_, nullptr, other.nil_, other.sentinel_);
+
+    if constexpr (Threaded) {
+      ThreadSubT(root_, sentinel_);
+    }
+
+    LinkSentinel();
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CopySubT(
+    node_type *node, node_type *parent, const node_type *other_nil,
+    const node_type *other_sen) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+
+  if (node == other_nil) {
+    return nil_;
+  }
+
+  if (node == other_sen) {
+    return sentinel_;
+  }
+
+  node_type *newNode = CopyN(node);
+  newNode->SetParent(parent);
+
+  if (node->left_child_ == other_sen) {
+    head_ = newNode;
+  }
+
+  if (node->right_child_ == other_sen) {
+    tail_ = newNode;
+  }
+
+  newNode->left_child_ = CopySubT(MLeft(node), newNode, other_nil, other_sen);
+  newNode->right_child_ = CopySubT(MRight(node), newNode, other_nil, other_sen);
+
+  return newNode;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::CopyN(const node_type *src) {
+  node_type *dst = CreateNode(src->key_);
+  dst->SetColor(src->Color());
+  dst->left_child_ = nil_;
+  dst->right_child_ = nil_;
+
+  if constexpr (Indexed) {
+    dst->subtree_size_ = src->subtree_size_;
+  }
+
+  return dst;
+}
+
+/*Checks that the range is ordered and counts the nodes it will produce,
+  leaving out repeated keys when they must be unique*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt>
+std::pair<bool,
+          typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::size_type>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SortedLength(
+    ForwardIt first, ForwardIt last, bool unique) const {
+  if (first == last) {
+    return std::make_pair(true, size_type(0));
+  }
+
+  size_type length = 1;
+
+  for (ForwardIt prev = first++; first != last; prev = first++) {
+    if (comp_(extracter_(*first), extracter_(*prev))) {
+      return std::make_pair(false, length);
+    }
+
+    if (!unique || comp_(extracter_(*prev), extracter_(*first))) {
+      ++length;
+    }
+  }
+
+  return std::make_pair(true, length);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::BuildSorted(
+    ForwardIt first, ForwardIt last, size_type n, bool unique) {
+  EnsureNil();
+
+  auto next = [&]() {
+    node_type *node = CreateNode(*first);
+    ++first;
+
+    while (unique && first != last &&
+           !comp_(extracter_(node->key_), extracter_(*first))) {
+      ++first;
+    }
+
+    return node;
+  };
+
+  Link(n, next);
+}
+
+/*Links n nodes handed out in key order by next() into an empty tree. Every
+  level but the deepest is full, so all paths carry the same number of black
+  nodes once the deepest level is painted red*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Source>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Link(
+    size_type n, Source &next) {
+  tree_size_ = n;
+
+  if (n == 0) {
+    return;
+  }
+
+  try {
+    root_ = LinkSubT(nullptr, n, 0, Log2(n), next);
+
+  } catch (...) {
+    Unlink();
+    throw;
+  }
+
+  LinkSentinel();
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Source>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::LinkSubT(
+    node_type *parent, size_type n, size_type depth, size_type red_depth,
+    Source &next) {
+  if (n == 0) {
+    return nil_;
+  }
+
+  size_type left_size = (n - 1) / 2;
+  node_type *left = LinkSubT(nullptr, left_size, depth + 1, red_depth, next);
+  node_type *node = nullptr;
+
+  try {
+    node = next();
+
+  } catch (...) {
+    Free(left);
+    throw;
+  }
+
+  node->SetParent(parent);
+  node->SetColor(depth > 0 && depth == red_depth ? RED : BLACK);
+  node->left_child_ = left;
+  node->right_child_ = nil_;
+
+  if constexpr (Indexed) {
+    node->subtree_size_ = n;
+  }
+
+  if (left != nil_) {
+    left->SetParent(node);
+  }
+
+  if (head_ == sentinel_) {
+    head_ = node;
+
+  } else {
+    Thread(tail_, node);
+  }
+
+  tail_ = node;
+
+  try {
+    node->right_child_ =
+        LinkSubT(node, n - 1 - left_size, depth + 1, red_depth, next);
+
+  } catch (...) {
+    Free(node);
+    throw;
+  }
+
+  return node;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::InsertShared(
+    InputIt first, InputIt last, bool unique, thread_pool &pool) {
+  std::vector<node_type *> nodes;
+
+  try {
+    for (; first != last; ++first) {
+      nodes.push_back(nullptr);
+      nodes.back() = CreateNode(*first);
+    }
+
+  } catch (...) {
+    for (node_type *node : nodes) {
+      if (node != nullptr) {
+        DestroyNode(node);
+      }
+    }
+
+    throw;
+  }
+
+  if (nodes.empty()) {
+    return;
+  }
+
+  SortShared(nodes.data(), nodes.size(), pool);
+
+  DropList dropped{nullptr, nullptr};
+  size_type n = nodes.size();
+
+  if (unique) {
+    n = 1;
+
+    for (size_type i = 1; i < nodes.size(); ++i) {
+      if (comp_(extracter_(nodes[n - 1]->key_),
+                extracter_(nodes[i]->key_))) {
+        nodes[n++] = nodes[i];
+
+      } else {
+        nodes[i]->left_child_ = nodes[i]->right_child_ = nil_;
+        Drop(nodes[i], dropped);
+      }
+    }
+  }
+
+  node_type *batch = LinkShared(nodes.data(), n, 0, Log2(n), pool);
+  subtree_type ours(nil_, 0);
+  bool ours_smaller = tree_size_ <= n;
+
+  if (root_ != nullptr) {
+    head_->left_child_ = nil_;
+    tail_->right_child_ = nil_;
+    ours = subtree_type(root_, BlackHeight(root_));
+  }
+
+  subtree_type result =
+      Combine(unique ? UNION : MERGE, ours,
+              subtree_type(batch, BlackHeight(batch)), ours_smaller, dropped,
+              &pool);
+
+  tree_size_ += nodes.size();
+  tree_size_ -= FreeDropped(dropped);
+  SettleRoot(result.first);
+}
+
+/*A merge sort whose halves are sorted in parallel. Equivalent nodes keep
+  their order*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SortShared(
+    node_type **nodes, size_type n, thread_pool &pool) const noexcept {
+  auto less = [this](const node_type *lhs, const node_type *rhs) {
+    return comp_(extracter_(lhs->key_), extracter_(rhs->key_));
+  };
+
+  if (n < kForkSize) {
+    std::stable_sort(nodes, nodes + n, less);
+    return;
+  }
+
+  size_type half = n / 2;
+
+  pool.invoke([&]() { SortShared(nodes, half, pool); },
+              [&]() { SortShared(nodes + half, n - half, pool); });
+  std::inplace_merge(nodes, nodes + half, nodes + n, less);
+}
+
+/*LinkSubT over n sorted nodes, with long runs linked in parallel*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::LinkShared(
+    node_type **nodes, size_type n, size_type depth, size_type red_depth,
+    thread_pool &pool) noexcept {
+  if (n == 0) {
+    return nil_;
+  }
+
+  size_type left_size = (n - 1) / 2;
+  node_type *node = nodes[left_size];
+  node_type *left = nil_;
+  node_type *right = nil_;
+
+  auto link_left = [&]() {
+    left = LinkShared(nodes, left_size, depth + 1, red_depth, pool);
+  };
+
+  auto link_right = [&]() {
+    right = LinkShared(nodes + left_size + 1, n - 1 - left_size, depth + 1,
+                       red_depth, pool);
+  };
+
+  if (n >= kForkSize) {
+    pool.invoke(link_left, link_right);
+
+  } else {
+    link_left();
+    link_right();
+  }
+
+  node->SetParent(nullptr);
+  node->SetColor(depth > 0 && depth == red_depth ? RED : BLACK);
+  node->left_child_ = left;
+  node->right_child_ = right;
+
+  if constexpr (Indexed) {
+    node->subtree_size_ = n;
+  }
+
+  if (left != nil_) {
+    left->SetParent(node);
+  }
+
+  if (right != nil_) {
+    right->SetParent(node);
+  }
+
+  return node;
+}
+
+/*Forgets the nodes without freeing them; they are owned elsewhere*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::Unlink() noexcept {
+  root_ = nullptr;
+  tree_size_ = 0;
+  LinkSentinel();
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::Log2(size_type n) noexcept {
+  size_type log = 0;
+
+  for (; n > 1; n /= 2) {
+    ++log;
+  }
+
+  return log;
+}
+
+/*Merges by relinking whole trees, so we have to be able to free what other
+  allocated. Returns false when the nodes have to be moved over one at a
+  time instead*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::MergeLinked(
+    RBTree &other, bool unique) noexcept {
+  if (this == &other || other.empty()) {
+    return true;
+
+  } else if (empty()) {
+    swap(other);
+    return true;
+  }
+
+  bool after = unique ? comp_(extracter_(tail_->key_),
+                              extracter_(other.head_->key_))
+                      : !comp_(extracter_(other.head_->key_),
+                               extracter_(tail_->key_));
+
+  if (after) {
+    Join(other, true);
+
+  } else if (comp_(extracter_(other.tail_->key_), extracter_(head_->key_))) {
+    Join(other, false);
+
+  } else if (PreferRebuild(other.tree_size_)) {
+    MergeRebuild(other, unique);
+
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+/*Rebuilding costs n + m relinks against m descents of log(n + m) each*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::PreferRebuild(
+    size_type incoming) const noexcept {
+  size_type total = tree_size_ + incoming;
+
+  return incoming * Log2(total) >= total;
+}
+
+/*Walks both trees in key order and links the result into a balanced tree.
+  Keys that are already present stay behind in other when they must be
+  unique. We have to be able to free what other allocated*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::MergeRebuild(
+    RBTree &other, bool unique) noexcept {
+  node_type *mine = Flatten(root_, nullptr);
+  node_type *theirs = other.Flatten(other.root_, nullptr);
+  node_type *merged = nullptr;
+  node_type *rest = nullptr;
+  node_type **merged_end = &merged;
+  node_type **rest_end = &rest;
+  size_type merged_size = 0;
+  size_type rest_size = 0;
+
+  auto take = [](node_type *&from, node_type **&to, size_type &size) {
+    node_type *node = from;
+    from = node->right_child_;
+    *to = node;
+    to = &node->right_child_;
+    ++size;
+  };
+
+  while (mine != nullptr && theirs != nullptr) {
+    if (comp_(extracter_(theirs->key_), extracter_(mine->key_))) {
+      take(theirs, merged_end, merged_size);
+
+    } else if (unique && !comp_(extracter_(mine->key_),
+                                extracter_(theirs->key_))) {
+      take(theirs, rest_end, rest_size);
+
+    } else {
+      take(mine, merged_end, merged_size);
+    }
+  }
+
+  while (mine != nullptr) {
+    take(mine, merged_end, merged_size);
+  }
+
+  while (theirs != nullptr) {
+    take(theirs, merged_end, merged_size);
+  }
+
+  *merged_end = *rest_end = nullptr;
+
+  auto next_merged = [&merged]() noexcept {
+    node_type *node = merged;
+    merged = node->right_child_;
+    return node;
+  };
+
+  auto next_rest = [&rest]() noexcept {
+    node_type *node = rest;
+    rest = node->right_child_;
+    return node;
+  };
+
+  Unlink();
+  other.Unlink();
+  Link(merged_size, next_merged);
+  other.Link(rest_size, next_rest);
+}
+
+/*Threads the subtree in key order through right_child_ ahead of rest*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Flatten(
+    node_type *node, node_type *rest) noexcept {
+  if (node == nullptr || node == nil_ || node == sentinel_) {
+    return rest;
+  }
+
+  node_type *left = node->left_child_;
+  node->right_child_ = Flatten(node->right_child_, rest);
+
+  return Flatten(left, node);
+}
+
+/*Concatenates two trees whose key ranges do not overlap. The smaller tree
+  donates its extreme node as the joining point and then has its leaves
+  pointed at our nil, so the cost is O(log n) plus the size of the smaller
+  tree. We have to be able to free what other allocated*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Join(
+    RBTree &other, bool other_after) noexcept {
+  if (other.tree_size_ > tree_size_) {
+    swap(other);
+    other_after = !other_after;
+  }
+
+  node_type *mid = other.EraseHandler(
+      const_iterator(other_after ? other.head_ : other.tail_)).first;
+
+  if (other.root_ == nullptr) {
+    Insert(other_after ? tail_ : head_, mid);
+    return;
+  }
+
+  node_type *left_head = other_after ? head_ : other.head_;
+  node_type *left_tail = other_after ? tail_ : other.tail_;
+  node_type *right_head = other_after ? other.head_ : head_;
+  node_type *right_tail = other_after ? other.tail_ : tail_;
+  node_type *left = other_after ? root_ : other.root_;
+  node_type *right = other_after ? other.root_ : root_;
+
+  RelinkLeaves(other.root_, other.nil_, other.sentinel_);
+  head_->left_child_ = nil_;
+  tail_->right_child_ = nil_;
+
+  tree_size_ += other.tree_size_ + 1;
+  head_ = left_head;
+  tail_ = right_tail;
+  other.Unlink();
+
+  Thread(left_tail, mid);
+  Thread(mid, right_head);
+  root_ = JoinSubT(subtree_type(left, BlackHeight(left)), mid,
+                   subtree_type(right, BlackHeight(right)))
+              .first;
+  LinkSentinel();
+}
+
+/*Joins two detached subtrees around mid, which orders after every node of
+  left and before every node of right. mid hangs with the lower tree under it
+  at the spot on the taller tree's inner spine where the black heights match,
+  then the colors are repaired as an insertion of mid. Costs O(1 + the
+  difference in height)*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::JoinSubT(
+    subtree_type left, node_type *mid, subtree_type right) noexcept {
+  bool left_taller = left.second >= right.second;
+  node_type *root = left_taller ? left.first : right.first;
+  size_type height = left_taller ? left.second : right.second;
+  node_type *creep = root;
+  node_type *parent = nullptr;
+
+  if (left.first != nil_) {
+    left.first->SetColor(BLACK);
+  }
+
+  if (right.first != nil_) {
+    right.first->SetColor(BLACK);
+  }
+
+  mid->SetColor(RED);
+
+  if (left_taller) {
+    for (size_type h = height; creep->Color() == RED || h > right.second;
+         creep = creep->right_child_) {
+      if (creep->Color() == BLACK) {
+        --h;
+      }
+
+      parent = creep;
+    }
+
+    mid->left_child_ = creep;
+    mid->right_child_ = right.first;
+
+    if (parent != nullptr) {
+      parent->right_child_ = mid;
+    }
+
+  } else {
+    for (size_type h = height; creep->Color() == RED || h > left.second;
+         creep = creep->left_child_) {
+      if (creep->Color() == BLACK) {
+        --h;
+      }
+
+      parent = creep;
+    }
+
+    mid->right_child_ = creep;
+    mid->left_child_ = left.first;
+
+    if (parent != nullptr) {
+      parent->left_child_ = mid;
+    }
+  }
+
+  mid->SetParent(parent);
+
+  if (mid->left_child_ != nil_) {
+    mid->left_child_->SetParent(mid);
+  }
+
+  if (mid->right_child_ != nil_) {
+    mid->right_child_->SetParent(mid);
+  }
+
+  if (parent == nullptr) {
+    root = mid;
+  }
+
+  if constexpr (Indexed) {
+    ResizeSubtree(mid);
+    GrowPath(parent, mid->subtree_size_ - creep->subtree_size_);
+  }
+
+  if (RebalanceInsert(mid, root)) {
+    ++height;
+  }
+
+  return subtree_type(root, height);
+}
+
+/*Cuts the detached subtree holding pivot into the nodes before and after it.
+  Every ancestor is joined onto the side it falls on with its other subtree
+  on the way up; the heights joined only grow, so the whole split is
+  O(log n). pivot itself is left out of both halves*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type,
+          typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SplitSubT(
+    node_type *pivot) noexcept {
+  size_type height = BlackHeight(pivot->left_child_);
+  color_t color = pivot->Color();
+  subtree_type left = Detach(pivot->left_child_, height);
+  subtree_type right = Detach(pivot->right_child_, height);
+  node_type *child = pivot;
+  node_type *parent = pivot->Parent();
+
+  while (parent != nullptr) {
+    node_type *grand = parent->Parent();
+    color_t parent_color = parent->Color();
+
+    if (color == BLACK) {
+      ++height;
+    }
+
+    if (child == parent->left_child_) {
+      right = JoinSubT(right, parent, Detach(parent->right_child_, height));
+
+    } else {
+      left = JoinSubT(Detach(parent->left_child_, height), parent, left);
+    }
+
+    child = parent;
+    color = parent_color;
+    parent = grand;
+  }
+
+  return std::make_pair(left, right);
+}
+
+/*height is the black height below node's parent*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Detach(
+    node_type *node, size_type height) noexcept {
+  if (node == nil_) {
+    return subtree_type(nil_, 0);
+  }
+
+  node->SetParent(nullptr);
+
+  return subtree_type(node, node->Color() == RED ? height + 1 : height);
+}
+
+/*Returns how many nodes the subtree holds*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RelinkLeaves(
+    node_type *node, const node_type *other_nil,
+    const node_type *other_sen) noexcept {
+  size_type count = 1;
+
+  if (node->left_child_ == other_nil || node->left_child_ == other_sen) {
+    node->left_child_ = nil_;
+
+  } else {
+    count += RelinkLeaves(node->left_child_, other_nil, other_sen);
+  }
+
+  if (node->right_child_ == other_nil || node->right_child_ == other_sen) {
+    node->right_child_ = nil_;
+
+  } else {
+    count += RelinkLeaves(node->right_child_, other_nil, other_sen);
+  }
+
+  return count;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::BlackHeight(
+    const node_type *node) const noexcept {
+  size_type height = 0;
+
+  for (; node != nil_; node = node->left_child_) {
+    if (node->Color() == BLACK) {
+      ++height;
+    }
+  }
+
+  return height;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::FindMinNode(
+    node_type *enter) noexcept {
+  node_type *finder = enter;
+  if (finder == nullptr || finder == nil_ || finder == sentinel_) {
+    return finder;
+  }
+
+  while (finder->left_child_ != nil_ && finder->left_child_ != sentinel_) {
+    finder = MLeft(finder);
+  }
+
+  return finder;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::ResizeSubtree(
+    node_type *node) noexcept {
+  if constexpr (Indexed) {
+    node->subtree_size_ = node->left_child_->subtree_size_ +
+                          node->right_child_->subtree_size_ + 1;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::GrowPath(
+    node_type *node, size_type by) noexcept {
+  if constexpr (Indexed) {
+    for (; node != nullptr; node = node->Parent()) {
+      node->subtree_size_ += by;
+    }
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::ShrinkPath(
+    node_type *node) noexcept {
+  if constexpr (Indexed) {
+    for (; node != nullptr; node = node->Parent()) {
+      --node->subtree_size_;
+    }
+  }
+}
+
+/*Set algebra in the sense of the std algorithms: of m equivalent values in a
+  and n in b, a union keeps the m and the last n - m of b, an intersection the
+  first min(m, n) of a, a difference the last m - n of a and a symmetric
+  difference the surplus of the longer run. The result replaces our contents
+  and is built in bulk, by a linear merge when the sizes are close. When they
+  are lopsided, a result no larger than the smaller operand is collected by
+  looking its runs up in the larger one, and any other result is computed by
+  joining copies of both operands, which costs O(m log(n / m + 1))
+  comparisons and rebalancing on top of copying*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::assign_union(
+    const RBTree &a, const RBTree &b) {
+  Algebra(UNION, a, b, nullptr);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::assign_intersection(const RBTree &a, const RBTree &b) {
+  Algebra(INTERSECTION, a, b, nullptr);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::assign_difference(const RBTree &a, const RBTree &b) {
+  Algebra(DIFFERENCE, a, b, nullptr);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::
+    assign_symmetric_difference(const RBTree &a, const RBTree &b) {
+  Algebra(SYMMETRIC_DIFFERENCE, a, b, nullptr);
+}
+
+/*With a pool of more than one thread, results that would be merged are
+  computed by joining copies instead. The copies are made in parallel and
+  the halves either side of each split are combined in parallel, so only
+  taking nodes from the allocator and freeing the dropped ones is left to a
+  single thread*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::assign_union(
+    const RBTree &a, const RBTree &b, thread_pool &pool) {
+  Algebra(UNION, a, b, &pool);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::
+    assign_intersection(const RBTree &a, const RBTree &b, thread_pool &pool) {
+  Algebra(INTERSECTION, a, b, &pool);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::
+    assign_difference(const RBTree &a, const RBTree &b, thread_pool &pool) {
+  Algebra(DIFFERENCE, a, b, &pool);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::
+    assign_symmetric_difference(const RBTree &a, const RBTree &b,
+                                thread_pool &pool) {
+  Algebra(SYMMETRIC_DIFFERENCE, a, b, &pool);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Algebra(
+    algebra_t op, const RBTree &a, const RBTree &b, thread_pool *pool) {
+  if (this == &a || this == &b) {
+    RBTree result(get_allocator());
+    result.Algebra(op, a, b, pool);
+    swap(result);
+    return;
+  }
+
+  bool a_smaller = a.tree_size_ <= b.tree_size_;
+  const RBTree &smaller = a_smaller ? a : b;
+  const RBTree &larger = a_smaller ? b : a;
+  bool lopsided = Lopsided(smaller.tree_size_, larger.tree_size_);
+
+  clear();
+
+  if (lopsided && (op == INTERSECTION || (op == DIFFERENCE && a_smaller))) {
+    BuildFrom([&](auto &emit) {
+      ProbeRuns(op, smaller, larger, a_smaller, emit);
+    });
+
+  } else if (lopsided || (pool != nullptr && pool->size() > 1)) {
+    JoinCopies(op, a, b, a_smaller, pool);
+
+  } else {
+    BuildFrom([&](auto &emit) { MergeRuns(op, a, b, emit); });
+  }
+}
+
+/*Searching or splitting for each of m values beats merging all n + m of
+  them until m log(n + m) reaches a few times n + m; every step of a merge
+  also copies a value, and the factor comes from bench_algebra*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Lopsided(
+    size_type smaller, size_type larger) noexcept {
+  size_type total = smaller + larger;
+
+  return smaller * Log2(total) < 4 * total;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::RunShare
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Share(
+    algebra_t op, size_type m, size_type n) noexcept {
+  size_type common = m < n ? m : n;
+
+  switch (op) {
+    case UNION:
+      return RunShare{0, m, common, n - common};
+    case INTERSECTION:
+      return RunShare{0, common, 0, 0};
+    case DIFFERENCE:
+      return RunShare{common, m - common, 0, 0};
+    case MERGE:
+      return RunShare{0, m, 0, n};
+    default:
+      return RunShare{common, m - common, common, n - common};
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Emit>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::EmitShare(
+    const RunShare &share, const_iterator a_run, const_iterator b_run,
+    Emit &emit) const {
+  for (size_type i = 0; i < share.a_first; ++i) {
+    ++a_run;
+  }
+
+  for (size_type i = 0; i < share.a_count; ++i, ++a_run) {
+    emit(*a_run);
+  }
+
+  for (size_type i = 0; i < share.b_first; ++i) {
+    ++b_run;
+  }
+
+  for (size_type i = 0; i < share.b_count; ++i, ++b_run) {
+    emit(*b_run);
+  }
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-std::pair<typename RBTree<K, T, Compare, Extracter>::node_type *,
-          typename RBTree<K, T, Compare, Extracter>::iterator>
-RBTree<K, T, Compare, Extracter>::EraseHandler(const_iterator pos) noexcept {
-  node_type *tmp = nullptr;
-  node_type *deletable = pos.it_;
-  color_t originalColor = pos.it_->color_;
+/*Walks both trees in key order a run of equivalent values at a time*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Emit>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::MergeRuns(
+    algebra_t op, const RBTree &a, const RBTree &b, Emit &emit) const {
+  bool keeps_b_alone = Share(op, 0, 1).b_count != 0;
+  const_iterator a_it = a.begin();
+  const_iterator b_it = b.begin();
+
+  while (a_it != a.end() || (keeps_b_alone && b_it != b.end())) {
+    bool from_a = a_it != a.end() &&
+                  (b_it == b.end() ||
+                   !comp_(extracter_(*b_it), extracter_(*a_it)));
+    const key_type &key = extracter_(from_a ? *a_it : *b_it);
+    const_iterator a_run = a_it;
+    const_iterator b_run = b_it;
+    size_type m = 0;
+    size_type n = 0;
+
+    for (; a_it != a.end() && !comp_(key, extracter_(*a_it)); ++a_it) {
+      ++m;
+    }
 
-  if (deletable->left_child_ == nil_ || deletable->left_child_ == sentinel_) {
-    tmp = deletable->right_child_;
-    Transplant(deletable, deletable->right_child_);
+    for (; b_it != b.end() && !comp_(key, extracter_(*b_it)); ++b_it) {
+      ++n;
+    }
 
-  } else if (deletable->right_child_ == nil_ ||
-             deletable->right_child_ == sentinel_) {
-    tmp = deletable->left_child_;
-    Transplant(deletable, deletable->left_child_);
+    EmitShare(Share(op, m, n), a_run, b_run, emit);
+  }
+}
 
-  } else {
-    node_type *minNode = FindMinNode(deletable->right_child_);
-    originalColor = minNode->color_;
-    tmp = minNode->right_child_;
+/*Walks the runs of the smaller tree only and finds the matching ones in the
+  larger tree by search, for results that keep nothing the smaller tree
+  lacks*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Emit>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::ProbeRuns(
+    algebra_t op, const RBTree &smaller, const RBTree &larger, bool a_smaller,
+    Emit &emit) const {
+  const_iterator it = smaller.begin();
+
+  while (it != smaller.end()) {
+    const key_type &key = extracter_(*it);
+    const_iterator run = it;
+    const_iterator match(larger.LowerBoundNode(key));
+    size_type m = 0;
+    size_type n = 0;
+
+    for (; it != smaller.end() && !comp_(key, extracter_(*it)); ++it) {
+      ++m;
+    }
+
+    for (const_iterator probe = match;
+         probe != larger.end() && !comp_(key, extracter_(*probe)); ++probe) {
+      ++n;
+    }
 
-    if (minNode->parent_ == deletable) {
-      tmp->parent_ = minNode;
+    if (a_smaller) {
+      EmitShare(Share(op, m, n), run, match, emit);
 
     } else {
-      Transplant(minNode, minNode->right_child_);
-      minNode->right_child_ = deletable->right_child_;
-      minNode->right_child_->parent_ = minNode;
+      EmitShare(Share(op, n, m), match, run, emit);
     }
-
-    Transplant(deletable, minNode);
-    minNode->left_child_ = deletable->left_child_;
-    minNode->left_child_->parent_ = minNode;
-    minNode->color_ = deletable->color_;
   }
+}
 
-  if (originalColor == BLACK) {
-    RebalanceDelete(tmp);
-    sentinel_->parent_ = nullptr;
+/*Copies every value walk hands to emit into a list and links the list into
+  a balanced tree. Our tree has to be empty*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Walk>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::BuildFrom(
+    Walk walk) {
+  node_type *list = nullptr;
+  node_type **list_end = &list;
+  size_type n = 0;
+
+  auto emit = [&](const value_type &value) {
+    node_type *node = CreateNode(value);
+    *list_end = node;
+    list_end = &node->right_child_;
+    ++n;
+  };
+
+  auto next = [&list]() noexcept {
+    node_type *node = list;
+    list = node->right_child_;
+    return node;
+  };
+
+  try {
+    walk(emit);
+
+  } catch (...) {
+    for (*list_end = nullptr; list != nullptr;) {
+      DestroyNode(next());
+    }
+
+    throw;
   }
 
-  iterator next(deletable);
+  *list_end = nullptr;
+  Link(n, next);
+}
 
-  if (next.it_->left_child_ == sentinel_ &&
-      next.it_->right_child_ == sentinel_) {
-    ++next;
-    head_ = sentinel_;
-    tail_ = sentinel_;
+/*Our tree has to be empty*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::JoinCopies(
+    algebra_t op, const RBTree &a, const RBTree &b, bool a_smaller,
+    thread_pool *pool) {
+  EnsureNil();
 
-  } else if (next.it_->left_child_ == sentinel_) {
-    ++next;
-    head_ = next.it_;
-    head_->left_child_ = sentinel_;
+  std::pair<subtree_type, subtree_type> copies(subtree_type(nil_, 0),
+                                               subtree_type(nil_, 0));
 
-  } else if (next.it_->right_child_ == sentinel_) {
-    --next;
-    tail_ = next.it_;
-    tail_->right_child_ = sentinel_;
-    sentinel_->parent_ = nullptr;
-    sentinel_->left_child_ = sentinel_->right_child_ = tail_;
+  if (pool != nullptr && pool->size() > 1) {
+    copies = CopyShared(a, b, *pool);
 
   } else {
-    ++next;
+    copies.first = CopyDetached(a);
+
+    try {
+      copies.second = CopyDetached(b);
+
+    } catch (...) {
+      Free(copies.first.first);
+      tree_size_ = 0;
+      throw;
+    }
   }
 
-  --tree_size_;
+  DropList dropped{nullptr, nullptr};
+  subtree_type result =
+      Combine(op, copies.first, copies.second, a_smaller, dropped, pool);
 
-  if (root_ == sentinel_) {
+  tree_size_ -= FreeDropped(dropped);
+  SettleRoot(result.first);
+}
+
+/*Takes a detached subtree hanging off our nil as the whole tree*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SettleRoot(
+    node_type *root) noexcept {
+  root_ = root;
+  head_ = tail_ = sentinel_;
+
+  if (root_ == nil_) {
     root_ = nullptr;
+
+  } else {
+    root_->SetColor(BLACK);
+    head_ = FindMinNode(root_);
+
+    for (tail_ = root_; tail_->right_child_ != nil_;) {
+      tail_ = tail_->right_child_;
+    }
   }
 
-  return std::pair<node_type *, iterator>(deletable, next);
-}
+  if constexpr (Threaded) {
+    ThreadSubT(root_, sentinel_);
+  }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::swap(RBTree &other) {
-  std::swap(root_, other.root_);
-  std::swap(head_, other.head_);
-  std::swap(tail_, other.tail_);
-  std::swap(nil_, other.nil_);
-  std::swap(sentinel_, other.sentinel_);
-  std::swap(tree_size_, other.tree_size_);
+  LinkSentinel();
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::merge_unique(RBTree &other) {
-  iterator pos;
-  std::pair<node_type *, bool> search_pos;
-  node_type *cutting = nullptr;
+/*Copies the tree as a detached subtree hanging off our nil. The copied
+  nodes are counted into our size*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CopyDetached(
+    const RBTree &other) {
+  if (other.root_ == nullptr) {
+    return subtree_type(nil_, 0);
+  }
 
-  for (auto i = other.begin(), end = other.end(); i != end;) {
-    pos = i++;
-    search_pos = GetInsertUniqPos(pos.it_->key_);
+  node_type *root =
+      CopySubT(other.root_, nullptr, other.nil_, other.sentinel_);
+  node_type *creep = root;
 
-    if (search_pos.second) {
-      cutting = other.extract(pos);
-      Insert(search_pos.first, cutting);
+  for (; creep->left_child_ != sentinel_; creep = creep->left_child_) {
+  }
+
+  creep->left_child_ = nil_;
+
+  for (creep = root; creep->right_child_ != sentinel_;) {
+    creep = creep->right_child_;
+  }
+
+  creep->right_child_ = nil_;
+  tree_size_ += other.tree_size_;
+
+  return subtree_type(root, BlackHeight(root));
+}
+
+/*Pivots on the root of the operand that started out smaller: both operands
+  are split around its key, the parts on either side are combined
+  recursively and joined back around what the runs of that key keep. The
+  parts touch no common node, so with a pool the two sides are combined in
+  parallel while both operands are still tall. Unwanted nodes go to dropped
+  rather than back to the allocator*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Combine(
+    algebra_t op, subtree_type a, subtree_type b, bool pivot_on_a,
+    DropList &dropped, thread_pool *pool) noexcept {
+  if (a.first == nil_ || b.first == nil_) {
+    if (Share(op, 1, 0).a_count == 0) {
+      Drop(a.first, dropped);
+      a = subtree_type(nil_, 0);
+    }
+
+    if (Share(op, 0, 1).b_count == 0) {
+      Drop(b.first, dropped);
+      b = subtree_type(nil_, 0);
     }
+
+    return a.first == nil_ ? b : a;
+  }
+
+  const key_type &key = extracter_((pivot_on_a ? a : b).first->key_);
+  node_type *a_run = nullptr;
+  node_type *b_run = nullptr;
+  std::pair<subtree_type, subtree_type> a_parts = SplitKey(a, key, a_run);
+  std::pair<subtree_type, subtree_type> b_parts = SplitKey(b, key, b_run);
+  subtree_type left(nil_, 0);
+  subtree_type right(nil_, 0);
+
+  if (pool != nullptr && std::min(a.second, b.second) >= kForkHeight) {
+    DropList right_dropped{nullptr, nullptr};
+
+    pool->invoke(
+        [&]() {
+          left = Combine(op, a_parts.first, b_parts.first, pivot_on_a,
+                         dropped, pool);
+        },
+        [&]() {
+          right = Combine(op, a_parts.second, b_parts.second, pivot_on_a,
+                          right_dropped, pool);
+        });
+    Splice(dropped, right_dropped);
+
+  } else {
+    left = Combine(op, a_parts.first, b_parts.first, pivot_on_a, dropped,
+                   pool);
+    right = Combine(op, a_parts.second, b_parts.second, pivot_on_a, dropped,
+                    pool);
   }
+
+  return Concat(left, KeepRuns(op, a_run, b_run, dropped), right);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::merge_equal(RBTree &other) {
-  iterator pos;
-  node_type *cutting = nullptr;
+/*Splits a detached subtree into the nodes ordering before key and after it.
+  The nodes equivalent to key are threaded in order through right_child_
+  ahead of equal*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type,
+          typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::SplitKey(
+    subtree_type tree, const key_type &key, node_type *&equal) noexcept {
+  node_type *node = tree.first;
+
+  if (node == nil_) {
+    return std::make_pair(tree, tree);
+  }
 
-  for (auto i = other.begin(), end = other.end(); i != end;) {
-    pos = i++;
-    cutting = other.extract(pos);
-    Insert(GetInsertEqPos(pos.it_->key_), cutting);
+  subtree_type left = Detach(node->left_child_, tree.second - 1);
+  subtree_type right = Detach(node->right_child_, tree.second - 1);
+
+  if (comp_(key, extracter_(node->key_))) {
+    std::pair<subtree_type, subtree_type> parts = SplitKey(left, key, equal);
+    return std::make_pair(parts.first, JoinSubT(parts.second, node, right));
+
+  } else if (comp_(extracter_(node->key_), key)) {
+    std::pair<subtree_type, subtree_type> parts = SplitKey(right, key, equal);
+    return std::make_pair(JoinSubT(left, node, parts.first), parts.second);
   }
+
+  right = SplitKey(right, key, equal).second;
+  node->right_child_ = equal;
+  equal = node;
+  left = SplitKey(left, key, equal).first;
+
+  return std::make_pair(left, right);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::extract(const_iterator position) {
-  node_type *seized = EraseHandler(position).first;
-  return seized;
+/*Keeps what the operation keeps of two runs of equivalent values and drops
+  the rest*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::KeepRuns(
+    algebra_t op, node_type *a, node_type *b, DropList &dropped) noexcept {
+  size_type m = 0;
+  size_type n = 0;
+  node_type *run = nullptr;
+  node_type **run_end = &run;
+
+  for (node_type *node = a; node != nullptr; node = node->right_child_) {
+    ++m;
+  }
+
+  for (node_type *node = b; node != nullptr; node = node->right_child_) {
+    ++n;
+  }
+
+  auto keep = [&](node_type *list, size_type first, size_type count) {
+    for (size_type i = 0; list != nullptr; ++i) {
+      node_type *node = list;
+      list = node->right_child_;
+
+      if (i >= first && i < first + count) {
+        *run_end = node;
+        run_end = &node->right_child_;
+
+      } else {
+        node->left_child_ = node->right_child_ = nil_;
+        Drop(node, dropped);
+      }
+    }
+  };
+
+  RunShare share = Share(op, m, n);
+  keep(a, share.a_first, share.a_count);
+  keep(b, share.b_first, share.b_count);
+  *run_end = nullptr;
+
+  return run;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-bool RBTree<K, T, Compare, Extracter>::contains(
-    const key_type &Key) const noexcept {
-  iterator finder = search(Key);
+/*Joins left, the nodes of run in order and right*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Concat(
+    subtree_type left, node_type *run, subtree_type right) noexcept {
+  if (run == nullptr) {
+    return JoinSubT(left, right);
+  }
 
-  if (finder == end()) {
-    return false;
+  for (node_type *next = run->right_child_; next != nullptr;
+       run = next, next = run->right_child_) {
+    left = JoinSubT(left, run, subtree_type(nil_, 0));
   }
 
-  return true;
+  return JoinSubT(left, run, right);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::lower_bound(const key_type &Key) noexcept {
-  iterator it = begin();
+/*Joins two detached subtrees with the first node of right as the middle*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::subtree_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::JoinSubT(
+    subtree_type left, subtree_type right) noexcept {
+  if (left.first == nil_) {
+    return right;
+
+  } else if (right.first == nil_) {
+    return left;
+  }
+
+  node_type *mid = right.first;
 
-  while (it != end() && comp_(extracter_(it.it_->key_), Key)) {
-    ++it;
+  while (mid->left_child_ != nil_) {
+    mid = mid->left_child_;
   }
 
-  return it;
+  return JoinSubT(left, mid, SplitSubT(mid).second);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::upper_bound(const key_type &Key) noexcept {
-  iterator it = begin();
+/*Threads the subtree onto the front of dropped*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Drop(
+    node_type *node, DropList &dropped) noexcept {
+  if (node == nil_) {
+    return;
+  }
+
+  node_type *last = node;
 
-  while (it != end() && !comp_(Key, extracter_(it.it_->key_))) {
-    ++it;
+  while (last->right_child_ != nil_) {
+    last = last->right_child_;
   }
 
-  return it;
+  if (dropped.last_ == nullptr) {
+    dropped.last_ = last;
+  }
+
+  dropped.first_ = Flatten(node, dropped.first_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::size_type
-RBTree<K, T, Compare, Extracter>::count(const key_type &k) const {
-  size_type coincidences = 0;
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Splice(
+    DropList &to, const DropList &from) noexcept {
+  if (from.first_ == nullptr) {
+    return;
+  }
+
+  from.last_->right_child_ = to.first_;
 
-  for (auto it = cbegin(); it != cend(); ++it) {
-    if (extracter_(it.it_->key_) == k) {
-      ++coincidences;
-    }
+  if (to.last_ == nullptr) {
+    to.last_ = from.last_;
   }
 
-  return coincidences;
+  to.first_ = from.first_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-std::pair<typename RBTree<K, T, Compare, Extracter>::iterator,
-          typename RBTree<K, T, Compare, Extracter>::iterator>
-RBTree<K, T, Compare, Extracter>::equal_range(const key_type &k) {
-  iterator lower = lower_bound(k);
-  iterator upper = upper_bound(k);
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::size_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::FreeDropped(
+    const DropList &dropped) noexcept {
+  size_type freed = 0;
+
+  for (node_type *node = dropped.first_; node != nullptr; ++freed) {
+    node_type *next = node->right_child_;
+    DestroyNode(node);
+    node = next;
+  }
 
-  return std::make_pair(lower, upper);
+  return freed;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-void RBTree<K, T, Compare, Extracter>::CopyT(const RBTree &other) {
-  if (this != &other) {
-    if (!empty()) {
-      clear();
+/*Copies both trees as detached subtrees hanging off our nil, each subtree
+  of either that is still tall on a thread of its own. The copied nodes are
+  counted into our size*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type,
+          typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                          Threaded>::subtree_type>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CopyShared(
+    const RBTree &a, const RBTree &b, thread_pool &pool) {
+  auto height = [](const RBTree &tree) noexcept {
+    size_type black = 0;
+
+    for (const node_type *node = tree.root_;
+         node != nullptr && !tree.IsLeaf(node); node = node->left_child_) {
+      if (node->Color() == BLACK) {
+        ++black;
+      }
     }
 
-    tree_size_ = other.tree_size_;
-    root_ = CopySubT(other.root_, nullptr, other.nil_, other.sentinel_);
-    sentinel_->left_child_ = sentinel_->right_child_ = tail_;
+    return black;
+  };
+
+  Stock stock;
+  stock.chain_ = nullptr;
+  Batch a_batch{&stock, nullptr};
+  Batch b_batch{&stock, nullptr};
+  size_type a_height = height(a);
+  size_type b_height = height(b);
+  node_type *a_root = nil_;
+  node_type *b_root = nil_;
+
+  try {
+    pool.invoke(
+        [&]() {
+          a_root = CopySharedSubT(a.root_, a, a_height, a_batch, pool);
+        },
+        [&]() {
+          b_root = CopySharedSubT(b.root_, b, b_height, b_batch, pool);
+        });
+
+  } catch (...) {
+    Scrap(a_root, a_batch);
+    Scrap(b_root, b_batch);
+    Return(a_batch);
+    Return(b_batch);
+    Release(stock);
+    throw;
   }
+
+  Return(a_batch);
+  Return(b_batch);
+  Release(stock);
+  tree_size_ += a.tree_size_ + b.tree_size_;
+
+  return std::make_pair(subtree_type(a_root, a_height),
+                        subtree_type(b_root, b_height));
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::CopySubT(node_type *node, node_type *parent,
-                                           const node_type *other_nil,
-                                           const node_type *other_sen) {
-  if (node == nullptr) {
-    return nullptr;
+/*height is the black height of src, src included. A copy that throws puts
+  the nodes it made back into batch*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::CopySharedSubT(
+    const node_type *src, const RBTree &other, size_type height, Batch &batch,
+    thread_pool &pool) {
+  if (src == nullptr || other.IsLeaf(src)) {
+    return nil_;
   }
 
-  if (node == other_nil) {
-    return nil_;
+  node_type *node = Take(batch);
+
+  try {
+    node_traits::construct(alloc_, node, src->key_);
+
+  } catch (...) {
+    PutBack(batch, node);
+    throw;
   }
 
-  if (node == other_sen) {
-    return sentinel_;
+  node->SetColor(src->Color());
+  node->left_child_ = nil_;
+  node->right_child_ = nil_;
+
+  if constexpr (Indexed) {
+    node->subtree_size_ = src->subtree_size_;
   }
 
-  node_type *newNode = CopyN(node);
-  newNode->parent_ = parent;
+  size_type below = src->Color() == BLACK ? height - 1 : height;
+
+  try {
+    if (below >= kForkHeight) {
+      Batch right_batch{batch.stock_, nullptr};
+
+      try {
+        pool.invoke(
+            [&]() {
+              node->left_child_ = CopySharedSubT(src->left_child_, other,
+                                                 below, batch, pool);
+            },
+            [&]() {
+              node->right_child_ = CopySharedSubT(src->right_child_, other,
+                                                  below, right_batch, pool);
+            });
+
+      } catch (...) {
+        Return(right_batch);
+        throw;
+      }
 
-  if (head_ == sentinel_) {
-    head_ = newNode;
-  } else if (head_->key_ >= newNode->key_) {
-    head_ = newNode;
+      Return(right_batch);
+
+    } else {
+      node->left_child_ =
+          CopySharedSubT(src->left_child_, other, below, batch, pool);
+      node->right_child_ =
+          CopySharedSubT(src->right_child_, other, below, batch, pool);
+    }
+
+  } catch (...) {
+    Scrap(node, batch);
+    throw;
   }
 
-  if (tail_ == sentinel_) {
-    tail_ = newNode;
-  } else if (newNode->key_ >= tail_->key_) {
-    tail_ = newNode;
+  if (node->left_child_ != nil_) {
+    node->left_child_->SetParent(node);
   }
 
-  newNode->left_child_ = CopySubT(MLeft(node), newNode, other_nil, other_sen);
-  newNode->right_child_ = CopySubT(MRight(node), newNode, other_nil, other_sen);
+  if (node->right_child_ != nil_) {
+    node->right_child_->SetParent(node);
+  }
 
-  return newNode;
+  return node;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::CopyN(const node_type *src) {
-  node_type *dst = new node_type;
-  dst->key_ = src->key_;
-  dst->color_ = src->color_;
-  dst->left_child_ = nil_;
-  dst->right_child_ = nil_;
-  return dst;
+/*Refills batch from the stock, and the stock from the allocator, a batch
+  at a time*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Take(
+    Batch &batch) {
+  if (batch.chain_ == nullptr) {
+    std::lock_guard<std::mutex> lock(batch.stock_->mutex_);
+    Spare *&chain = batch.stock_->chain_;
+
+    if (chain == nullptr) {
+      try {
+        for (size_type i = 0; i < kBatchNodes; ++i) {
+          node_type *block = node_traits::allocate(alloc_, 1);
+          chain = ::new (static_cast<void *>(block)) Spare{chain};
+        }
+
+      } catch (...) {
+        if (chain == nullptr) {
+          throw;
+        }
+      }
+    }
+
+    Spare *last = chain;
+
+    for (size_type i = 1; i < kBatchNodes && last->next_ != nullptr; ++i) {
+      last = last->next_;
+    }
+
+    batch.chain_ = chain;
+    chain = last->next_;
+    last->next_ = nullptr;
+  }
+
+  Spare *spare = batch.chain_;
+  batch.chain_ = spare->next_;
+
+  return reinterpret_cast<node_type *>(spare);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::FindMinNode(node_type *enter) noexcept {
-  node_type *finder = enter;
-  if (finder == nullptr || finder == nil_ || finder == sentinel_) {
-    return finder;
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::PutBack(
+    Batch &batch, node_type *node) noexcept {
+  batch.chain_ = ::new (static_cast<void *>(node)) Spare{batch.chain_};
+}
+
+/*Destroys a subtree copied in parallel and puts its nodes back into batch*/
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Scrap(
+    node_type *node, Batch &batch) noexcept {
+  if (node == nil_) {
+    return;
   }
 
-  while (finder->left_child_ != nil_ && finder->left_child_ != sentinel_) {
-    finder = MLeft(finder);
+  Scrap(node->left_child_, batch);
+  Scrap(node->right_child_, batch);
+  std::destroy_at(&node->key_);
+  node_traits::destroy(alloc_, node);
+  PutBack(batch, node);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Return(
+    Batch &batch) noexcept {
+  if (batch.chain_ == nullptr) {
+    return;
   }
 
-  return finder;
+  Spare *last = batch.chain_;
+
+  while (last->next_ != nullptr) {
+    last = last->next_;
+  }
+
+  std::lock_guard<std::mutex> lock(batch.stock_->mutex_);
+  last->next_ = batch.stock_->chain_;
+  batch.stock_->chain_ = batch.chain_;
+  batch.chain_ = nullptr;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::Release(
+    Stock &stock) noexcept {
+  while (stock.chain_ != nullptr) {
+    Spare *spare = stock.chain_;
+    stock.chain_ = spare->next_;
+    node_traits::deallocate(alloc_, reinterpret_cast<node_type *>(spare), 1);
+  }
 }
 
 /*Iterator*/
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBIterator::RBIterator() noexcept
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::RBIterator()
+    noexcept
     : it_(nullptr) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBIterator::RBIterator(node_type *src)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::RBIterator(
+    node_type *src)
     : it_(src) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBIterator::RBIterator(const iterator &src)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::RBIterator(
+    const iterator &src)
     : it_(src.it_) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::RBIterator::RBIterator(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::RBIterator(
     iterator &&other) noexcept
     : RBIterator() {
   std::swap(other.it_, it_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator &
-RBTree<K, T, Compare, Extracter>::RBIterator::operator=(const iterator &other) {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::operator=(
+    const iterator &other) {
   it_ = other.it_;
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator &
-RBTree<K, T, Compare, Extracter>::RBIterator::operator=(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::RBIterator::operator=(
     iterator &&other) noexcept {
   it_ = other.it_;
   other.it_ = nullptr;
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator &
-RBTree<K, T, Compare, Extracter>::iterator::operator++() noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator++()
+    noexcept {
+  if constexpr (Threaded) {
+    it_ = it_->next_;
+    return *this;
+  }
+
   if (it_->right_child_->right_child_ != nullptr) {
     it_ = GetMin(it_->right_child_);
     return *this;
   }
 
-  node_type *steper = it_->parent_;
+  node_type *steper = it_->Parent();
 
   if (it_ == steper->right_child_) {
     while (steper != nullptr && it_ == steper->right_child_) {
       it_ = steper;
-      steper = it_->parent_;
+      steper = it_->Parent();
     }
 
     it_ = steper;
@@ -1009,28 +4247,39 @@ RBTree<K, T, Compare, Extracter>::iterator::operator++() noexcept {
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::iterator::operator++(int) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator++(
+    int) noexcept {
   iterator temp = *this;
   operator++();
   return temp;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator &
-RBTree<K, T, Compare, Extracter>::iterator::operator--() noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator--()
+    noexcept {
+  if constexpr (Threaded) {
+    it_ = it_->prev_;
+    return *this;
+  }
+
   if (it_->left_child_->left_child_ != nullptr) {
     it_ = GetMax(it_->left_child_);
     return *this;
   }
 
-  node_type *steper = it_->parent_;
+  node_type *steper = it_->Parent();
 
   if (it_ == steper->left_child_) {
     while (steper != nullptr && it_ == steper->left_child_) {
       it_ = steper;
-      steper = it_->parent_;
+      steper = it_->Parent();
     }
 
     it_ = steper;
@@ -1042,109 +4291,266 @@ RBTree<K, T, Compare, Extracter>::iterator::operator--() noexcept {
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::iterator
-RBTree<K, T, Compare, Extracter>::iterator::operator--(int) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator--(
+    int) noexcept {
   iterator temp = *this;
   operator--();
   return temp;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::reference
-RBTree<K, T, Compare, Extracter>::iterator::operator*() {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::reference
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator*() {
   return *reinterpret_cast<value_type *>(&it_->key_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::pointer
-RBTree<K, T, Compare, Extracter>::iterator::operator->() {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::pointer
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator->() {
   return reinterpret_cast<pointer>(&it_->key_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-inline bool RBTree<K, T, Compare, Extracter>::iterator::operator==(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+inline bool
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator==(
     const iterator &other) const noexcept {
   return it_ == other.it_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-inline bool RBTree<K, T, Compare, Extracter>::iterator::operator!=(
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+inline bool
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::iterator::operator!=(
     const iterator &other) const noexcept {
   return it_ != other.it_;
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::iterator::GetMax(node_type *enter) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator::GetMax(
+    node_type *enter) noexcept {
   if (enter == nullptr) return nullptr;
 
   if (enter->right_child_->right_child_ == nullptr) {
     return enter;
 
-  } else if (enter->right_child_->parent_ == nullptr) {
+  } else if (enter->right_child_->Parent() == nullptr) {
     return enter;
 
-  } else if (enter->parent_ == nullptr) {
+  } else if (enter->Parent() == nullptr) {
     return enter;
   }
 
   return GetMax(enter->right_child_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::node_type *
-RBTree<K, T, Compare, Extracter>::iterator::GetMin(node_type *enter) noexcept {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_type *
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::iterator::GetMin(
+    node_type *enter) noexcept {
   if (enter == nullptr) return nullptr;
 
   if (enter->left_child_->left_child_ == nullptr) {
     return enter;
 
-  } else if (enter->parent_ == nullptr) {
+  } else if (enter->Parent() == nullptr) {
     return enter;
   }
 
   return GetMin(enter->left_child_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::const_iterator::RBConstIterator() noexcept
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed,
+       Alloc, Threaded>::const_iterator::RBConstIterator() noexcept
     : RBIterator() {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::const_iterator::RBConstIterator(
-    node_type *src)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed,
+       Alloc, Threaded>::const_iterator::RBConstIterator(node_type *src)
     : RBIterator(src) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::const_iterator::RBConstIterator(
-    const iterator &other)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed,
+       Alloc, Threaded>::const_iterator::RBConstIterator(const iterator &other)
     : RBIterator(other) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::const_iterator::RBConstIterator(
-    const const_iterator &other)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::const_iterator::
+    RBConstIterator(const const_iterator &other)
     : RBIterator(other) {}
 
-template <typename K, typename T, class Compare, class Extracter>
-RBTree<K, T, Compare, Extracter>::const_iterator::RBConstIterator(
-    const_iterator &&other)
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed,
+       Alloc, Threaded>::const_iterator::RBConstIterator(const_iterator &&other)
     : RBConstIterator() {
   std::swap(RBIterator::it_, other.it_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::reference
-RBTree<K, T, Compare, Extracter>::const_iterator::operator*() const {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::reference
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::const_iterator::operator*()
+    const {
   return *static_cast<value_type *>(&RBIterator::it_->key_);
 }
 
-template <typename K, typename T, class Compare, class Extracter>
-typename RBTree<K, T, Compare, Extracter>::pointer
-RBTree<K, T, Compare, Extracter>::const_iterator::operator->() const {
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::pointer
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::const_iterator::operator->()
+    const {
   return static_cast<value_type *>(&RBIterator::it_->key_);
 }
 
+/*Node handle*/
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::RBNodeHandle()
+    noexcept
+    : node_(nullptr), alloc_(std::nullopt) {}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::RBNodeHandle(
+    node_type *node, const node_allocator &alloc) noexcept
+    : node_(node), alloc_(alloc) {}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::RBNodeHandle(
+    RBNodeHandle &&other) noexcept
+    : node_(other.node_), alloc_(std::move(other.alloc_)) {
+  other.node_ = nullptr;
+  other.alloc_.reset();
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::~RBNodeHandle() {
+  Reset();
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::node_handle &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::operator=(
+    RBNodeHandle &&other) noexcept {
+  if (this != &other) {
+    Reset();
+    node_ = other.node_;
+    alloc_ = std::move(other.alloc_);
+    other.node_ = nullptr;
+    other.alloc_.reset();
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+bool RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::node_handle::empty()
+    const noexcept {
+  return node_ == nullptr;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::operator bool()
+    const noexcept {
+  return node_ != nullptr;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+                Threaded>::allocator_type
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::get_allocator()
+    const {
+  return allocator_type(*alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+typename RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::reference
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_handle::value()
+    const noexcept {
+  return node_->key_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename V>
+typename V::first_type &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc, Threaded>::node_handle::key()
+    const noexcept {
+  return node_->key_.first;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename V>
+typename V::second_type &
+RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+       Threaded>::node_handle::mapped()
+    const noexcept {
+  return node_->key_.second;
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::node_handle::swap(
+    RBNodeHandle &other) noexcept {
+  std::swap(node_, other.node_);
+  std::swap(alloc_, other.alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, bool Indexed,
+          class Alloc, bool Threaded>
+void RBTree<K, T, Compare, Extracter, Indexed, Alloc,
+            Threaded>::node_handle::Reset()
+    noexcept {
+  if (node_ != nullptr) {
+    std::destroy_at(&node_->key_);
+    node_traits::destroy(*alloc_, node_);
+    node_traits::deallocate(*alloc_, node_, 1);
+    node_ = nullptr;
+  }
+
+  alloc_.reset();
+}
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
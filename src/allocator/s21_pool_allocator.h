@@ -0,0 +1,840 @@
+#ifndef CPP_S21_CONTAINERS_ALLOCATOR_S21_POOL_ALLOCATOR_H
+#define CPP_S21_CONTAINERS_ALLOCATOR_S21_POOL_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+/*Slab storage behind pool_allocator. Blocks of one size are cut from
+  contiguous chunks, recycled through a free list on deallocation and
+  handed back to the system all at once by Release(). A pool can adopt
+  another one, after which either may free blocks the other handed out: the
+  chunks of both then belong to one owner that outlives them all. Such
+  pools hand a chunk back as soon as all of its blocks have come back to
+  one of them, and the free blocks of a pool whose last allocator is gone
+  go to the owner for the others to draw from. Only what pools share is
+  locked, so a pool is still not thread safe.*/
+class PoolResource : public std::enable_shared_from_this<PoolResource> {
+ public:
+  static constexpr std::size_t kAlign = alignof(std::max_align_t);
+  static constexpr std::size_t kFirstChunkBlocks = 16;
+  static constexpr std::size_t kMaxChunkBlocks = 4096;
+  static constexpr std::size_t kSweepBlocks = 64;
+
+  explicit PoolResource(
+      std::size_t first_chunk_blocks = kFirstChunkBlocks) noexcept;
+  PoolResource(const PoolResource &other) = delete;
+  PoolResource &operator=(const PoolResource &other) = delete;
+  ~PoolResource();
+
+  static std::shared_ptr<PoolResource> Make(
+      std::size_t first_chunk_blocks = kFirstChunkBlocks);
+
+  void *Allocate(std::size_t bytes);
+  void Deallocate(void *block, std::size_t bytes) noexcept;
+  void Release() noexcept;
+  bool Shared() const noexcept;
+
+  static void Adopt(PoolResource *pool, PoolResource *other) noexcept;
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next_;
+  };
+
+  struct Chunk {
+    Chunk *next_;
+    std::size_t block_size_;
+    std::size_t blocks_;
+  };
+
+  struct Bucket {
+    std::size_t block_size_;
+    std::size_t chunk_blocks_;
+    FreeBlock *free_list_;
+    std::size_t free_blocks_;
+    std::size_t sweep_at_;
+    char *cursor_;
+    char *limit_;
+    Bucket *next_;
+  };
+
+  static constexpr std::size_t kChunkHeader =
+      (sizeof(Chunk) + kAlign - 1) / kAlign * kAlign;
+
+  Chunk *chunks_;
+  Chunk *last_chunk_;
+  Bucket *buckets_;
+  /*Buckets of pools whose allocators are gone, left to us as their owner,
+    and how many blocks they hold*/
+  Bucket *orphans_;
+  std::size_t orphan_blocks_;
+  std::size_t orphan_sweep_at_;
+  std::size_t first_chunk_blocks_;
+  /*Set once we adopted another pool or got adopted*/
+  std::atomic<bool> mixed_;
+  /*Set once our chunks went to another pool, which keeps the new ones too*/
+  std::shared_ptr<PoolResource> owner_;
+
+  static std::mutex &ChunkLock() noexcept;
+  static std::size_t BlockSize(std::size_t bytes) noexcept;
+  template <typename Link>
+  static Link *SortByAddress(Link *list) noexcept;
+  static std::size_t Blocks(const Bucket *bucket) noexcept;
+  static void Spill(Bucket *into, Bucket *from) noexcept;
+  static void Absorb(Bucket **orphans, Bucket *bucket,
+                     Bucket *&absorbed) noexcept;
+  static void Collect(PoolResource *owner, Bucket *bucket,
+                      Chunk *&dead) noexcept;
+  static void Free(Chunk *dead, Bucket *absorbed) noexcept;
+  PoolResource *Owner() noexcept;
+  Bucket *FindBucket(std::size_t block_size) const noexcept;
+  Bucket *MakeBucket(std::size_t block_size) noexcept;
+  void Grow(Bucket *bucket);
+  bool Claim(Bucket *bucket) noexcept;
+  void Sweep(Bucket *bucket) noexcept;
+  void Retire() noexcept;
+};
+
+template <typename T>
+class pool_allocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  pool_allocator() noexcept = default;
+  explicit pool_allocator(std::size_t first_chunk_blocks);
+  pool_allocator(const pool_allocator &other) noexcept;
+  pool_allocator(pool_allocator &&other) noexcept = default;
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &other) noexcept;
+
+  pool_allocator &operator=(const pool_allocator &other) noexcept;
+  pool_allocator &operator=(pool_allocator &&other) noexcept = default;
+
+  T *allocate(size_type n);
+  void deallocate(T *block, size_type n) noexcept;
+
+  pool_allocator select_on_container_copy_construction() const noexcept;
+  bool unique() const noexcept;
+  void release() noexcept;
+  template <typename U>
+  void adopt(const pool_allocator<U> &other) noexcept;
+
+  template <typename U>
+  bool operator==(const pool_allocator<U> &other) const noexcept;
+  template <typename U>
+  bool operator!=(const pool_allocator<U> &other) const noexcept;
+
+ private:
+  template <typename U>
+  friend class pool_allocator;
+
+  static constexpr bool kPooled = alignof(T) <= PoolResource::kAlign;
+
+  /*Made on the first allocation or copy, so that an allocator nobody
+    allocated through or copied costs nothing, while copies still share it*/
+  mutable std::shared_ptr<PoolResource> pool_;
+
+  std::shared_ptr<PoolResource> Pool() const noexcept;
+  std::shared_ptr<PoolResource> Share() const noexcept;
+};
+
+/*Containers ask this before dropping a whole pool instead of freeing
+  their nodes one by one*/
+template <class Alloc, class = void>
+struct is_releasable_allocator : std::false_type {};
+
+template <class Alloc>
+struct is_releasable_allocator<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().release()),
+                       decltype(std::declval<const Alloc &>().unique())>>
+    : std::true_type {};
+
+/*Allocators that can be made to free what an unequal one allocated*/
+template <class Alloc, class = void>
+struct is_adopting_allocator : std::false_type {};
+
+template <class Alloc>
+struct is_adopting_allocator<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().adopt(
+               std::declval<const Alloc &>()))>> : std::true_type {};
+
+/*Lets alloc free what other allocated where the allocator allows it and
+  tells whether it can now. Containers relink nodes between each other when
+  it can*/
+template <class Alloc>
+bool adopt_allocations(Alloc &alloc, const Alloc &other) noexcept {
+  if constexpr (is_adopting_allocator<Alloc>::value) {
+    alloc.adopt(other);
+    return true;
+
+  } else {
+    return alloc == other;
+  }
+}
+
+inline PoolResource::PoolResource(std::size_t first_chunk_blocks) noexcept
+    : chunks_(nullptr),
+      last_chunk_(nullptr),
+      buckets_(nullptr),
+      orphans_(nullptr),
+      orphan_blocks_(0),
+      orphan_sweep_at_(kSweepBlocks),
+      first_chunk_blocks_(first_chunk_blocks ? first_chunk_blocks : 1),
+      mixed_(false),
+      owner_(nullptr) {}
+
+/*Never takes the lock: an adopted pool can go away while it is held*/
+inline PoolResource::~PoolResource() {
+  while (chunks_ != nullptr) {
+    Chunk *next = chunks_->next_;
+    ::operator delete(chunks_);
+    chunks_ = next;
+  }
+
+  for (Bucket *bucket : {buckets_, orphans_}) {
+    while (bucket != nullptr) {
+      Bucket *next = bucket->next_;
+      delete bucket;
+      bucket = next;
+    }
+  }
+}
+
+/*The handle shared by an allocator and its copies. Adopted pools keep the
+  pool itself alive for its chunks, the handle only for its free blocks*/
+inline std::shared_ptr<PoolResource> PoolResource::Make(
+    std::size_t first_chunk_blocks) {
+  std::shared_ptr<PoolResource> pool =
+      std::make_shared<PoolResource>(first_chunk_blocks);
+  PoolResource *resource = pool.get();
+
+  return std::shared_ptr<PoolResource>(
+      resource, [pool](PoolResource *) mutable noexcept {
+        pool->Retire();
+        pool.reset();
+      });
+}
+
+inline void *PoolResource::Allocate(std::size_t bytes) {
+  std::size_t block_size = BlockSize(bytes);
+  Bucket *bucket = FindBucket(block_size);
+
+  if (bucket == nullptr) {
+    bucket = MakeBucket(block_size);
+
+    if (bucket == nullptr) {
+      throw std::bad_alloc();
+    }
+  }
+
+  if (bucket->free_list_ == nullptr && bucket->cursor_ == bucket->limit_ &&
+      !Claim(bucket)) {
+    Grow(bucket);
+  }
+
+  if (bucket->free_list_ != nullptr) {
+    FreeBlock *block = bucket->free_list_;
+    bucket->free_list_ = block->next_;
+    --bucket->free_blocks_;
+    return block;
+  }
+
+  void *block = bucket->cursor_;
+  bucket->cursor_ += block_size;
+  return block;
+}
+
+/*A block of a size we never handed out came from an adopted pool and gets
+  a bucket of its own. Out of memory for that, the block is dropped and its
+  chunk freed with the owner's*/
+inline void PoolResource::Deallocate(void *block, std::size_t bytes) noexcept {
+  std::size_t block_size = BlockSize(bytes);
+  Bucket *bucket = FindBucket(block_size);
+
+  if (bucket == nullptr && (bucket = MakeBucket(block_size)) == nullptr) {
+    return;
+  }
+
+  FreeBlock *freed = static_cast<FreeBlock *>(block);
+  freed->next_ = bucket->free_list_;
+  bucket->free_list_ = freed;
+
+  if (++bucket->free_blocks_ >= bucket->sweep_at_ &&
+      mixed_.load(std::memory_order_relaxed)) {
+    Sweep(bucket);
+  }
+}
+
+/*Only for a pool nothing else draws from or has adopted*/
+inline void PoolResource::Release() noexcept {
+  Chunk *chunks = nullptr;
+
+  {
+    std::lock_guard<std::mutex> guard(ChunkLock());
+    chunks = chunks_;
+    chunks_ = last_chunk_ = nullptr;
+  }
+
+  while (chunks != nullptr) {
+    Chunk *next = chunks->next_;
+    ::operator delete(chunks);
+    chunks = next;
+  }
+
+  for (Bucket *bucket = buckets_; bucket != nullptr; bucket = bucket->next_) {
+    bucket->chunk_blocks_ = first_chunk_blocks_;
+    bucket->free_list_ = nullptr;
+    bucket->free_blocks_ = 0;
+    bucket->sweep_at_ = kSweepBlocks;
+    bucket->cursor_ = bucket->limit_ = nullptr;
+  }
+}
+
+/*Whether blocks can pass between us and another pool, so that Release()
+  must not run*/
+inline bool PoolResource::Shared() const noexcept {
+  return mixed_.load(std::memory_order_relaxed);
+}
+
+/*Hands the chunks of other's owner to pool's owner, which keeps them and
+  every chunk either pool grows later, along with the blocks dead pools
+  left behind. Costs O(1) apart from those*/
+inline void PoolResource::Adopt(PoolResource *pool,
+                                PoolResource *other) noexcept {
+  std::lock_guard<std::mutex> guard(ChunkLock());
+  PoolResource *owner = pool->Owner();
+  PoolResource *adopted = other->Owner();
+
+  pool->mixed_.store(true, std::memory_order_relaxed);
+  other->mixed_.store(true, std::memory_order_relaxed);
+
+  if (owner == adopted) {
+    return;
+  }
+
+  if (adopted->chunks_ != nullptr) {
+    adopted->last_chunk_->next_ = owner->chunks_;
+
+    if (owner->chunks_ == nullptr) {
+      owner->last_chunk_ = adopted->last_chunk_;
+    }
+
+    owner->chunks_ = adopted->chunks_;
+    adopted->chunks_ = adopted->last_chunk_ = nullptr;
+  }
+
+  while (adopted->orphans_ != nullptr) {
+    Bucket *orphan = adopted->orphans_;
+    adopted->orphans_ = orphan->next_;
+    orphan->next_ = owner->orphans_;
+    owner->orphans_ = orphan;
+  }
+
+  owner->orphan_blocks_ += adopted->orphan_blocks_;
+  adopted->orphan_blocks_ = 0;
+
+  adopted->owner_ = owner->shared_from_this();
+}
+
+inline std::mutex &PoolResource::ChunkLock() noexcept {
+  static std::mutex lock;
+  return lock;
+}
+
+inline std::size_t PoolResource::BlockSize(std::size_t bytes) noexcept {
+  if (bytes < sizeof(FreeBlock)) {
+    bytes = sizeof(FreeBlock);
+  }
+
+  return (bytes + kAlign - 1) / kAlign * kAlign;
+}
+
+/*Merge sort of a singly linked list of blocks or chunks*/
+template <typename Link>
+Link *PoolResource::SortByAddress(Link *list) noexcept {
+  if (list == nullptr || list->next_ == nullptr) {
+    return list;
+  }
+
+  Link *middle = list;
+
+  for (Link *fast = list->next_; fast != nullptr && fast->next_ != nullptr;
+       fast = fast->next_->next_) {
+    middle = middle->next_;
+  }
+
+  Link *right = SortByAddress(middle->next_);
+  middle->next_ = nullptr;
+  Link *left = SortByAddress(list);
+  Link *head = nullptr;
+  Link **tail = &head;
+
+  while (left != nullptr && right != nullptr) {
+    Link *&first = reinterpret_cast<std::uintptr_t>(left) <
+                           reinterpret_cast<std::uintptr_t>(right)
+                       ? left
+                       : right;
+    *tail = first;
+    tail = &first->next_;
+    first = first->next_;
+  }
+
+  *tail = left != nullptr ? left : right;
+  return head;
+}
+
+inline std::size_t PoolResource::Blocks(const Bucket *bucket) noexcept {
+  return bucket->free_blocks_ +
+         static_cast<std::size_t>(bucket->limit_ - bucket->cursor_) /
+             bucket->block_size_;
+}
+
+/*Moves every block left in from, whether on its free list or not cut
+  yet, onto the free list of into*/
+inline void PoolResource::Spill(Bucket *into, Bucket *from) noexcept {
+  for (; from->cursor_ != from->limit_; from->cursor_ += from->block_size_) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(from->cursor_);
+    block->next_ = into->free_list_;
+    into->free_list_ = block;
+    ++into->free_blocks_;
+  }
+
+  from->cursor_ = from->limit_ = nullptr;
+
+  while (from != into && from->free_list_ != nullptr) {
+    FreeBlock *block = from->free_list_;
+    from->free_list_ = block->next_;
+    block->next_ = into->free_list_;
+    into->free_list_ = block;
+    ++into->free_blocks_;
+  }
+
+  if (from != into) {
+    from->free_blocks_ = 0;
+  }
+}
+
+/*The pool that keeps our chunks, with the lock held. Points us straight at
+  it on the way, so that chains of adoptions stay short*/
+inline PoolResource *PoolResource::Owner() noexcept {
+  if (owner_ == nullptr) {
+    return this;
+  }
+
+  PoolResource *owner = owner_.get();
+
+  while (owner->owner_ != nullptr) {
+    owner = owner->owner_.get();
+  }
+
+  if (owner != owner_.get()) {
+    owner_ = owner->shared_from_this();
+  }
+
+  return owner;
+}
+
+inline PoolResource::Bucket *PoolResource::FindBucket(
+    std::size_t block_size) const noexcept {
+  Bucket *bucket = buckets_;
+
+  while (bucket != nullptr && bucket->block_size_ != block_size) {
+    bucket = bucket->next_;
+  }
+
+  return bucket;
+}
+
+inline PoolResource::Bucket *PoolResource::MakeBucket(
+    std::size_t block_size) noexcept {
+  Bucket *bucket = new (std::nothrow)
+      Bucket{block_size, first_chunk_blocks_, nullptr, 0, kSweepBlocks,
+             nullptr,    nullptr,             buckets_};
+
+  if (bucket != nullptr) {
+    buckets_ = bucket;
+  }
+
+  return bucket;
+}
+
+inline void PoolResource::Grow(Bucket *bucket) {
+  std::size_t blocks = bucket->chunk_blocks_;
+  char *memory = static_cast<char *>(
+      ::operator new(kChunkHeader + blocks * bucket->block_size_));
+  Chunk *chunk = reinterpret_cast<Chunk *>(memory);
+
+  chunk->block_size_ = bucket->block_size_;
+  chunk->blocks_ = blocks;
+
+  {
+    std::lock_guard<std::mutex> guard(ChunkLock());
+    PoolResource *owner = Owner();
+
+    chunk->next_ = owner->chunks_;
+
+    if (owner->chunks_ == nullptr) {
+      owner->last_chunk_ = chunk;
+    }
+
+    owner->chunks_ = chunk;
+  }
+
+  bucket->cursor_ = memory + kChunkHeader;
+  bucket->limit_ = bucket->cursor_ + blocks * bucket->block_size_;
+
+  if (blocks < kMaxChunkBlocks) {
+    bucket->chunk_blocks_ = blocks * 2;
+  }
+}
+
+/*Takes over the blocks a dead pool left to our owner for an empty bucket*/
+inline bool PoolResource::Claim(Bucket *bucket) noexcept {
+  if (!mixed_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  Bucket *orphan = nullptr;
+
+  {
+    std::lock_guard<std::mutex> guard(ChunkLock());
+    PoolResource *owner = Owner();
+    Bucket **link = &owner->orphans_;
+
+    while (*link != nullptr && (*link)->block_size_ != bucket->block_size_) {
+      link = &(*link)->next_;
+    }
+
+    if (*link == nullptr) {
+      return false;
+    }
+
+    orphan = *link;
+    *link = orphan->next_;
+    owner->orphan_blocks_ -= Blocks(orphan);
+  }
+
+  bucket->free_list_ = orphan->free_list_;
+  bucket->free_blocks_ = orphan->free_blocks_;
+  bucket->cursor_ = orphan->cursor_;
+  bucket->limit_ = orphan->limit_;
+  delete orphan;
+
+  return true;
+}
+
+/*Hands back every chunk of the bucket's size all of whose blocks are free
+  here, after taking in what dead pools left to our owner so that it counts
+  too. Runs once the free blocks doubled since the last time*/
+inline void PoolResource::Sweep(Bucket *bucket) noexcept {
+  Bucket *absorbed = nullptr;
+  Chunk *dead = nullptr;
+
+  {
+    std::lock_guard<std::mutex> guard(ChunkLock());
+    PoolResource *owner = Owner();
+    std::size_t before = bucket->free_blocks_;
+
+    Absorb(&owner->orphans_, bucket, absorbed);
+    owner->orphan_blocks_ -= bucket->free_blocks_ - before;
+    Collect(owner, bucket, dead);
+  }
+
+  Free(dead, absorbed);
+  bucket->sweep_at_ = bucket->free_blocks_ * 2 > kSweepBlocks
+                          ? bucket->free_blocks_ * 2
+                          : kSweepBlocks;
+}
+
+/*Runs once the last allocator drawing from us is gone. Blocks we still
+  hold go to our owner, where the pools left drawing from it find them;
+  without any adoption our chunks simply go with us. Once what the owner
+  was left doubled, it hands back the chunks that are free altogether*/
+inline void PoolResource::Retire() noexcept {
+  if (!mixed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  Bucket *absorbed = nullptr;
+  Chunk *dead = nullptr;
+
+  {
+    std::lock_guard<std::mutex> guard(ChunkLock());
+    PoolResource *owner = Owner();
+
+    for (Bucket **link = &buckets_; *link != nullptr;) {
+      Bucket *bucket = *link;
+
+      if (Blocks(bucket) != 0) {
+        *link = bucket->next_;
+        bucket->next_ = owner->orphans_;
+        owner->orphans_ = bucket;
+        owner->orphan_blocks_ += Blocks(bucket);
+
+      } else {
+        link = &bucket->next_;
+      }
+    }
+
+    if (owner->orphan_blocks_ >= owner->orphan_sweep_at_) {
+      owner->orphan_blocks_ = 0;
+
+      for (Bucket **link = &owner->orphans_; *link != nullptr;) {
+        Bucket *orphan = *link;
+
+        Absorb(&orphan->next_, orphan, absorbed);
+        Collect(owner, orphan, dead);
+
+        if (Blocks(orphan) == 0) {
+          *link = orphan->next_;
+          orphan->next_ = absorbed;
+          absorbed = orphan;
+
+        } else {
+          owner->orphan_blocks_ += Blocks(orphan);
+          link = &orphan->next_;
+        }
+      }
+
+      owner->orphan_sweep_at_ = owner->orphan_blocks_ * 2 > kSweepBlocks
+                                    ? owner->orphan_blocks_ * 2
+                                    : kSweepBlocks;
+    }
+  }
+
+  Free(dead, absorbed);
+}
+
+/*With the lock held, moves the blocks of every orphan of the bucket's size
+  from the list into the bucket and the emptied orphans to absorbed*/
+inline void PoolResource::Absorb(Bucket **orphans, Bucket *bucket,
+                                 Bucket *&absorbed) noexcept {
+  for (Bucket **link = orphans; *link != nullptr;) {
+    Bucket *orphan = *link;
+
+    if (orphan->block_size_ == bucket->block_size_) {
+      *link = orphan->next_;
+      Spill(bucket, orphan);
+      orphan->next_ = absorbed;
+      absorbed = orphan;
+
+    } else {
+      link = &orphan->next_;
+    }
+  }
+}
+
+/*With the lock held, moves the owner's chunks of the bucket's size all of
+  whose blocks are free in the bucket to dead. Sorts the free blocks and
+  the chunks by address for that, in O(f log f + c log c) for f free blocks
+  and c chunks*/
+inline void PoolResource::Collect(PoolResource *owner, Bucket *bucket,
+                                  Chunk *&dead) noexcept {
+  std::size_t block_size = bucket->block_size_;
+
+  Spill(bucket, bucket);
+  bucket->free_list_ = SortByAddress(bucket->free_list_);
+  owner->chunks_ = SortByAddress(owner->chunks_);
+
+  FreeBlock **free_link = &bucket->free_list_;
+  Chunk *last = nullptr;
+
+  for (Chunk **link = &owner->chunks_; *link != nullptr;) {
+    Chunk *chunk = *link;
+
+    if (chunk->block_size_ == block_size) {
+      std::uintptr_t begin =
+          reinterpret_cast<std::uintptr_t>(chunk) + kChunkHeader;
+      std::uintptr_t end = begin + chunk->blocks_ * block_size;
+      std::size_t free_blocks = 0;
+
+      while (*free_link != nullptr &&
+             reinterpret_cast<std::uintptr_t>(*free_link) < begin) {
+        free_link = &(*free_link)->next_;
+      }
+
+      FreeBlock **first = free_link;
+
+      while (*free_link != nullptr &&
+             reinterpret_cast<std::uintptr_t>(*free_link) < end) {
+        free_link = &(*free_link)->next_;
+        ++free_blocks;
+      }
+
+      if (free_blocks == chunk->blocks_) {
+        *first = *free_link;
+        free_link = first;
+        bucket->free_blocks_ -= free_blocks;
+        *link = chunk->next_;
+        chunk->next_ = dead;
+        dead = chunk;
+        continue;
+      }
+    }
+
+    last = chunk;
+    link = &chunk->next_;
+  }
+
+  owner->last_chunk_ = last;
+}
+
+inline void PoolResource::Free(Chunk *dead, Bucket *absorbed) noexcept {
+  while (dead != nullptr) {
+    Chunk *next = dead->next_;
+    ::operator delete(dead);
+    dead = next;
+  }
+
+  while (absorbed != nullptr) {
+    Bucket *next = absorbed->next_;
+    delete absorbed;
+    absorbed = next;
+  }
+}
+
+template <typename T>
+pool_allocator<T>::pool_allocator(std::size_t first_chunk_blocks)
+    : pool_(PoolResource::Make(first_chunk_blocks)) {}
+
+template <typename T>
+pool_allocator<T>::pool_allocator(const pool_allocator &other) noexcept
+    : pool_(other.Share()) {}
+
+template <typename T>
+template <typename U>
+pool_allocator<T>::pool_allocator(const pool_allocator<U> &other) noexcept
+    : pool_(other.Share()) {}
+
+template <typename T>
+pool_allocator<T> &pool_allocator<T>::operator=(
+    const pool_allocator &other) noexcept {
+  pool_ = other.Share();
+  return *this;
+}
+
+template <typename T>
+T *pool_allocator<T>::allocate(size_type n) {
+  if (!kPooled || n != 1) {
+    return std::allocator<T>().allocate(n);
+  }
+
+  if (pool_ == nullptr) {
+    pool_ = PoolResource::Make();
+  }
+
+  return static_cast<T *>(pool_->Allocate(sizeof(T)));
+}
+
+template <typename T>
+void pool_allocator<T>::deallocate(T *block, size_type n) noexcept {
+  if (!kPooled || n != 1) {
+    std::allocator<T>().deallocate(block, n);
+    return;
+  }
+
+  pool_->Deallocate(block, sizeof(T));
+}
+
+template <typename T>
+pool_allocator<T> pool_allocator<T>::select_on_container_copy_construction()
+    const noexcept {
+  return pool_allocator();
+}
+
+template <typename T>
+bool pool_allocator<T>::unique() const noexcept {
+  return kPooled && pool_ != nullptr && pool_.use_count() == 1 &&
+         !pool_->Shared();
+}
+
+template <typename T>
+void pool_allocator<T>::release() noexcept {
+  if (unique()) {
+    pool_->Release();
+  }
+}
+
+/*Afterwards we may free whatever other allocated, and other what we did.
+  Both pools still hand out their own free blocks. Without a pool of our
+  own yet we make one first, and out of memory for that draw from other's*/
+template <typename T>
+template <typename U>
+void pool_allocator<T>::adopt(const pool_allocator<U> &other) noexcept {
+  std::shared_ptr<PoolResource> pool = other.Pool();
+
+  if (pool == nullptr || pool == pool_) {
+    return;
+  }
+
+  if (pool_ == nullptr) {
+    try {
+      pool_ = PoolResource::Make();
+
+    } catch (const std::bad_alloc &) {
+      pool_ = pool;
+      return;
+    }
+  }
+
+  PoolResource::Adopt(pool_.get(), pool.get());
+}
+
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator==(
+    const pool_allocator<U> &other) const noexcept {
+  return Pool() == other.Pool();
+}
+
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator!=(
+    const pool_allocator<U> &other) const noexcept {
+  return !(*this == other);
+}
+
+/*Copies of one allocator may be made on several threads at once, so the
+  pool is read and made atomically wherever a const allocator looks at it*/
+template <typename T>
+std::shared_ptr<PoolResource> pool_allocator<T>::Pool() const noexcept {
+  return std::atomic_load(&pool_);
+}
+
+/*The pool for a copy, made here if nothing was allocated yet. Out of
+  memory the copy makes its own pool later*/
+template <typename T>
+std::shared_ptr<PoolResource> pool_allocator<T>::Share() const noexcept {
+  std::shared_ptr<PoolResource> pool = Pool();
+
+  if (pool == nullptr) {
+    try {
+      std::shared_ptr<PoolResource> made = PoolResource::Make();
+
+      if (std::atomic_compare_exchange_strong(&pool_, &pool, made)) {
+        pool = made;
+      }
+
+    } catch (const std::bad_alloc &) {
+    }
+  }
+
+  return pool;
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
@@ -1,9 +1,12 @@
 #ifndef CPP_S21_CONTAINERS_ARRAY_S21_ARRAY_H
 #define CPP_S21_CONTAINERS_ARRAY_S21_ARRAY_H
 
+#include <algorithm>
+#include <cstring>
 #include <initializer_list>
 #include <limits>
 #include <sstream>
+#include <type_traits>
 
 #include "../helper/helper.h"
 
@@ -59,18 +62,33 @@ array<T, N>::array(std::initializer_list<value_type> const &items) {
 
 template <class T, std::size_t N>
 array<T, N>::array(const array &a) {
-  std::copy(a.begin(), a.end(), Data);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memcpy(static_cast<void *>(Data), a.Data, sizeof(Data));
+
+  } else {
+    std::copy(a.begin(), a.end(), Data);
+  }
 }
 
 template <class T, std::size_t N>
 array<T, N>::array(array &&a) {
-  std::move(a.begin(), a.end(), Data);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memcpy(static_cast<void *>(Data), a.Data, sizeof(Data));
+
+  } else {
+    std::move(a.begin(), a.end(), Data);
+  }
 }
 
 template <class T, std::size_t N>
 array<T, N> &array<T, N>::operator=(const array &a) {
   if (this != &a) {
-    std::copy(a.begin(), a.end(), Data);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memcpy(static_cast<void *>(Data), a.Data, sizeof(Data));
+
+    } else {
+      std::copy(a.begin(), a.end(), Data);
+    }
   }
   return *this;
 }
@@ -78,7 +96,12 @@ array<T, N> &array<T, N>::operator=(const array &a) {
 template <class T, std::size_t N>
 array<T, N> &array<T, N>::operator=(array &&a) noexcept {
   if (this != &a) {
-    std::copy(a.begin(), a.end(), Data);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memcpy(static_cast<void *>(Data), a.Data, sizeof(Data));
+
+    } else {
+      std::move(a.begin(), a.end(), Data);
+    }
   }
   return *this;
 }
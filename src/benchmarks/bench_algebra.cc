@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../set/s21_set.h"
+
+namespace {
+
+template <typename F>
+double MeasureMs(F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+std::vector<long> RandomKeys(std::size_t n, long range, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::vector<long> keys(n);
+  for (long &key : keys) key = static_cast<long>(rng() % range);
+
+  return keys;
+}
+
+/*The way intersections used to be written: walk one set and probe the
+  other*/
+s21::set<long> ProbeLoop(s21::set<long> &a, s21::set<long> &b) {
+  s21::set<long> result;
+  for (long key : a) {
+    if (b.contains(key)) result.insert(result.end(), key);
+  }
+
+  return result;
+}
+
+void Run(std::size_t n, std::size_t m) {
+  const long range = static_cast<long>(n) * 2;
+  std::vector<long> big_keys = RandomKeys(n, range, 1);
+  std::vector<long> small_keys = RandomKeys(m, range, 2);
+  s21::set<long> big(big_keys.begin(), big_keys.end());
+  s21::set<long> small(small_keys.begin(), small_keys.end());
+  std::set<long> std_big(big_keys.begin(), big_keys.end());
+  std::set<long> std_small(small_keys.begin(), small_keys.end());
+  std::size_t sizes = 0;
+
+  double probe_ms = MeasureMs([&]() { sizes += ProbeLoop(small, big).size(); });
+  double inter_ms = MeasureMs(
+      [&]() { sizes += s21::set_intersection(small, big).size(); });
+  double std_inter_ms = MeasureMs([&]() {
+    std::set<long> out;
+    std::set_intersection(std_small.begin(), std_small.end(), std_big.begin(),
+                          std_big.end(), std::inserter(out, out.end()));
+    sizes += out.size();
+  });
+  double union_ms =
+      MeasureMs([&]() { sizes += s21::set_union(big, small).size(); });
+  double std_union_ms = MeasureMs([&]() {
+    std::set<long> out;
+    std::set_union(std_big.begin(), std_big.end(), std_small.begin(),
+                   std_small.end(), std::inserter(out, out.end()));
+    sizes += out.size();
+  });
+
+  std::printf("%8zu x %-8zu %10.2f %10.2f %10.2f %10.2f %10.2f   (%zu)\n", n,
+              m, probe_ms, inter_ms, std_inter_ms, union_ms, std_union_ms,
+              sizes % 10);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("ms per operation\n");
+  std::printf("%-19s %10s %10s %10s %10s %10s\n", "sizes", "probe loop",
+              "inter", "std inter", "union", "std union");
+
+  for (std::size_t m : {1000000UL, 300000UL, 100000UL, 1000UL}) {
+    Run(1000000, m);
+  }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../btree_map/s21_btree_map.h"
+#include "../map/s21_map.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+std::vector<long> ShuffledKeys(std::size_t n) {
+  std::vector<long> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i) * 7;
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+
+  return keys;
+}
+
+template <class Map>
+void Run(const char *name, const std::vector<long> &keys) {
+  Map m;
+  long sum = 0;
+
+  double insert_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) m.insert({key, key});
+  });
+  double find_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) sum += m.find(key)->second;
+  });
+  double scan_ns = MeasureNs(keys.size(), [&]() {
+    for (auto &item : m) sum += item.second;
+  });
+  double erase_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) m.erase(m.find(key));
+  });
+
+  std::printf("%-16s %10.1f %10.1f %10.1f %10.1f   (%ld)\n", name, insert_ns,
+              find_ns, scan_ns, erase_ns, sum % 10);
+}
+
+}  // namespace
+
+int main() {
+  for (std::size_t n : {1000UL, 100000UL, 1000000UL}) {
+    std::vector<long> keys = ShuffledKeys(n);
+
+    std::printf("n = %zu, ns per op\n", n);
+    std::printf("%-16s %10s %10s %10s %10s\n", "", "insert", "find", "scan",
+                "erase");
+    Run<s21::btree_map<long, long>>("s21::btree_map", keys);
+    Run<s21::map<long, long>>("s21::map", keys);
+    Run<std::map<long, long>>("std::map", keys);
+  }
+
+  return 0;
+}
\ No newline at end of file
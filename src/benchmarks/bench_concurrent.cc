@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../concurrent_map/s21_concurrent_map.h"
+#include "../map/s21_map.h"
+
+namespace {
+
+template <typename F>
+double MeasureMs(F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+/*Runs body(t) on threads threads at once and returns the wall time*/
+template <typename F>
+double OnThreads(std::size_t threads, F &&body) {
+  return MeasureMs([&]() {
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&body, t]() { body(t); });
+    }
+
+    for (auto &worker : workers) worker.join();
+  });
+}
+
+/*The map behind one mutex, the way the ingest uses s21::map today*/
+struct LockedMap {
+  std::mutex lock_;
+  s21::map<long, long> map_;
+
+  void Insert(long key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    map_.emplace(key, key);
+  }
+
+  bool Contains(long key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return map_.contains(key);
+  }
+};
+
+}  // namespace
+
+int main() {
+  const std::size_t n = 1 << 20;
+  const std::size_t batch = 256;
+  std::vector<long> keys(n);
+
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(25));
+
+  std::printf("millions of ops per second, %zu keys split over the threads; "
+              "hardware threads: %u\n",
+              n, std::thread::hardware_concurrency());
+  std::printf("%-8s %12s %12s %12s   %12s %12s\n", "threads", "mutex ins",
+              "sharded ins", "batch ins", "mutex 90/10", "sharded 90/10");
+
+  std::size_t hits = 0;
+
+  for (std::size_t threads : {1UL, 2UL, 4UL, 8UL, 16UL, 32UL}) {
+    std::size_t share = n / threads;
+    double ms[5];
+
+    LockedMap locked;
+    ms[0] = OnThreads(threads, [&](std::size_t t) {
+      for (std::size_t i = t * share; i < (t + 1) * share; ++i) {
+        locked.Insert(keys[i]);
+      }
+    });
+
+    s21::concurrent_map<long, long> sharded;
+    ms[1] = OnThreads(threads, [&](std::size_t t) {
+      for (std::size_t i = t * share; i < (t + 1) * share; ++i) {
+        sharded.insert({keys[i], keys[i]});
+      }
+    });
+
+    s21::concurrent_map<long, long> batched;
+    ms[2] = OnThreads(threads, [&](std::size_t t) {
+      std::vector<std::pair<long, long>> items;
+
+      for (std::size_t i = t * share; i < (t + 1) * share; i += batch) {
+        items.clear();
+
+        for (std::size_t j = i; j < std::min(i + batch, (t + 1) * share);
+             ++j) {
+          items.emplace_back(keys[j], keys[j]);
+        }
+
+        batched.insert(items.begin(), items.end());
+      }
+    });
+
+    /*Nine lookups to every insert, on the filled maps*/
+    std::vector<std::size_t> found(threads, 0);
+    ms[3] = OnThreads(threads, [&](std::size_t t) {
+      for (std::size_t i = t * share; i < (t + 1) * share; ++i) {
+        if (i % 10 == 0) {
+          locked.Insert(keys[i] + static_cast<long>(n));
+        } else {
+          found[t] += locked.Contains(keys[i]) ? 1 : 0;
+        }
+      }
+    });
+    ms[4] = OnThreads(threads, [&](std::size_t t) {
+      for (std::size_t i = t * share; i < (t + 1) * share; ++i) {
+        if (i % 10 == 0) {
+          sharded.insert({keys[i] + static_cast<long>(n), 0});
+        } else {
+          found[t] += sharded.contains(keys[i]) ? 1 : 0;
+        }
+      }
+    });
+
+    for (std::size_t count : found) hits += count;
+
+    double ops = static_cast<double>(share * threads) / 1000.0;
+    std::printf("%-8zu %12.2f %12.2f %12.2f   %12.2f %12.2f   (%zu)\n",
+                threads, ops / ms[0], ops / ms[1], ops / ms[2], ops / ms[3],
+                ops / ms[4], hits % 10);
+  }
+
+  return 0;
+}
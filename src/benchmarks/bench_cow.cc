@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+#include "../map/s21_map.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+/*Each stage takes the configuration by value and reads a few entries, the
+  way a pipeline hands it along*/
+template <class Map>
+long Stage(Map config, long key) {
+  return config.find(key)->second;
+}
+
+long CowStage(s21::cow_map<long, long> config, long key) {
+  return config->find(key)->second;
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t stages = 20;
+  long sum = 0;
+
+  std::printf(
+      "ns per copy passed to a stage, and per write to a fresh copy: the "
+      "first one copies the whole map\n");
+  std::printf("%-10s %14s %14s %14s %14s %14s\n", "n", "s21::map", "std::map",
+              "cow_map", "first write", "next write");
+
+  for (std::size_t n : {1000UL, 100000UL, 1000000UL}) {
+    s21::map<long, long> plain;
+    std::map<long, long> standard;
+    s21::cow_map<long, long> shared;
+
+    for (std::size_t i = 0; i < n; ++i) {
+      long key = static_cast<long>(i);
+      plain.emplace(key, key);
+      standard.emplace(key, key);
+      shared.write().emplace(key, key);
+    }
+
+    double plain_ns = MeasureNs(stages, [&]() {
+      for (std::size_t i = 0; i < stages; ++i) sum += Stage(plain, 7);
+    });
+    double std_ns = MeasureNs(stages, [&]() {
+      for (std::size_t i = 0; i < stages; ++i) sum += Stage(standard, 7);
+    });
+    double cow_ns = MeasureNs(stages, [&]() {
+      for (std::size_t i = 0; i < stages; ++i) sum += CowStage(shared, 7);
+    });
+
+    s21::cow_map<long, long> copy = shared;
+    double first_ns = MeasureNs(1, [&]() { copy.write()[7] = 8; });
+    double next_ns = MeasureNs(1, [&]() { copy.write()[9] = 10; });
+
+    std::printf("%-10zu %14.0f %14.0f %14.0f %14.0f %14.0f   (%ld)\n", n,
+                plain_ns, std_ns, cow_ns, first_ns, next_ns, sum % 10);
+  }
+
+  return 0;
+}
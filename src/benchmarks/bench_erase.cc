@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdio>
+#include <set>
+
+#include "../set/s21_set.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+template <class Set>
+Set Filled(std::size_t n) {
+  Set s;
+  for (std::size_t i = 0; i < n; ++i) s.insert(static_cast<long>(i));
+
+  return s;
+}
+
+/*Drops count windows of width keys spread evenly over a set holding 0..n-1,
+  the way expiring entries or clearing key ranges would*/
+template <class Set>
+double OneByOne(std::size_t n, long count, long width) {
+  Set s = Filled<Set>(n);
+  long stride = static_cast<long>(n) / count;
+
+  return MeasureNs(count * width, [&]() {
+    for (long from = 0; from < count * stride; from += stride) {
+      auto last = s.find(from + width);
+      for (auto it = s.find(from); it != last;) s.erase(it++);
+    }
+  });
+}
+
+template <class Set>
+double Range(std::size_t n, long count, long width) {
+  Set s = Filled<Set>(n);
+  long stride = static_cast<long>(n) / count;
+
+  return MeasureNs(count * width, [&]() {
+    for (long from = 0; from < count * stride; from += stride) {
+      s.erase(s.find(from), s.find(from + width));
+    }
+  });
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t n = 1000000;
+  const long shapes[][2] = {{1, 500000}, {1000, 500}, {10000, 16}, {10000, 4}};
+
+  std::printf("n = %zu, ns per erased element\n", n);
+  std::printf("%-18s %14s %14s %14s\n", "windows x width", "s21 one by one",
+              "s21 range", "std range");
+
+  for (const auto &shape : shapes) {
+    long count = shape[0];
+    long width = shape[1];
+    char name[32];
+    std::snprintf(name, sizeof(name), "%ld x %ld", count, width);
+
+    std::printf("%-18s %14.1f %14.1f %14.1f\n", name,
+                OneByOne<s21::set<long>>(n, count, width),
+                Range<s21::set<long>>(n, count, width),
+                Range<std::set<long>>(n, count, width));
+  }
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../btree_map/s21_btree_map.h"
+#include "../flat_map/s21_flat_map.h"
+#include "../map/s21_map.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+/*Builds the table from one batch, then probes it with a mix of present and
+  missing keys*/
+template <class Map>
+void Run(const char *name, const std::vector<std::pair<int, int>> &batch,
+         const std::vector<int> &probes) {
+  Map m;
+  long hits = 0;
+
+  double build_ns = MeasureNs(batch.size(), [&]() {
+    m = Map(batch.begin(), batch.end());
+  });
+  double find_ns = MeasureNs(probes.size(), [&]() {
+    for (int key : probes) hits += m.find(key) != m.end();
+  });
+
+  std::printf("%-16s %10.1f %10.1f   (%ld)\n", name, build_ns, find_ns,
+              hits % 10);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(1);
+
+  for (std::size_t n : {100UL, 10000UL, 1000000UL}) {
+    std::vector<std::pair<int, int>> batch(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      batch[i] = {static_cast<int>(i) * 2, static_cast<int>(i)};
+    }
+    std::shuffle(batch.begin(), batch.end(), rng);
+
+    std::vector<int> probes(1000000);
+    for (int &key : probes) key = static_cast<int>(rng() % (2 * n));
+
+    std::printf("n = %zu, ns per op\n", n);
+    std::printf("%-16s %10s %10s\n", "", "build", "find");
+    Run<s21::flat_map<int, int>>("s21::flat_map", batch, probes);
+    Run<s21::btree_map<int, int>>("s21::btree_map", batch, probes);
+    Run<s21::map<int, int>>("s21::map", batch, probes);
+    Run<std::map<int, int>>("std::map", batch, probes);
+  }
+
+  return 0;
+}
\ No newline at end of file
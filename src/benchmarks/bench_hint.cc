@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+
+#include "../map/s21_map.h"
+#include "../multiset/s21_multiset.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+/*Timestamps arrive in order, a few of them repeated*/
+long Timestamp(std::size_t i) { return 1700000000000L + (i - i % 4 / 3); }
+
+template <class Map>
+double MapIngest(std::size_t n, bool hinted) {
+  Map m;
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (hinted) {
+        m.insert(m.end(), {Timestamp(i), static_cast<long>(i)});
+
+      } else {
+        m.insert({Timestamp(i), static_cast<long>(i)});
+      }
+    }
+  });
+}
+
+template <class Multiset>
+double MultisetIngest(std::size_t n, bool hinted) {
+  Multiset m;
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (hinted) {
+        m.insert(m.end(), Timestamp(i));
+
+      } else {
+        m.insert(Timestamp(i));
+      }
+    }
+  });
+}
+
+void Report(const char *name, double s21_ns, double std_ns) {
+  std::printf("%-28s %12.1f %12.1f\n", name, s21_ns, std_ns);
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t n = 1000000;
+
+  std::printf("%-28s %12s %12s\n", "ns per insert", "s21", "std");
+  Report("map insert", MapIngest<s21::map<long, long>>(n, false),
+         MapIngest<std::map<long, long>>(n, false));
+  Report("map insert(end())", MapIngest<s21::map<long, long>>(n, true),
+         MapIngest<std::map<long, long>>(n, true));
+  Report("multiset insert", MultisetIngest<s21::multiset<long>>(n, false),
+         MultisetIngest<std::multiset<long>>(n, false));
+  Report("multiset insert(end())",
+         MultisetIngest<s21::multiset<long>>(n, true),
+         MultisetIngest<std::multiset<long>>(n, true));
+
+  return 0;
+}
\ No newline at end of file
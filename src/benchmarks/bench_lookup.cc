@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "../set/s21_set.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+/*Batches of lookups, half of them misses, the way a request handler would
+  resolve the keys it was sent*/
+std::vector<long> Lookups(std::size_t n, std::size_t count, bool sorted) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<long> pick(0, static_cast<long>(n) * 2 - 1);
+  std::vector<long> keys(count);
+  for (long &key : keys) key = pick(gen);
+  if (sorted) std::sort(keys.begin(), keys.end());
+
+  return keys;
+}
+
+/*The even keys below 2n in shuffled order, so the nodes inserted for them
+  end up scattered over memory*/
+std::vector<long> Stored(std::size_t n) {
+  std::vector<long> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i) * 2;
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+
+  return keys;
+}
+
+void Run(std::size_t n, bool sorted) {
+  const std::size_t batch = 512;
+  const std::size_t rounds = 400;
+  std::vector<long> keys = Lookups(n, batch * rounds, sorted);
+  s21::set<long> s;
+  std::set<long> ss;
+  s21::map<long, long> m;
+
+  for (long key : Stored(n)) {
+    s.insert(key);
+    ss.insert(key);
+    m.insert(std::make_pair(key, key));
+  }
+
+  std::vector<bool> present;
+  std::vector<s21::map<long, long>::iterator> found;
+  present.reserve(batch);
+  found.reserve(batch);
+  long hits = 0;
+
+  double single_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) hits += s.contains(key);
+  });
+  double many_ns = MeasureNs(keys.size(), [&]() {
+    for (std::size_t i = 0; i < keys.size(); i += batch) {
+      present.clear();
+      s.contains_many(keys.begin() + i, keys.begin() + i + batch,
+                      std::back_inserter(present));
+      hits += std::count(present.begin(), present.end(), true);
+    }
+  });
+  double std_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) hits += ss.count(key);
+  });
+  double map_single_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) hits += m.find(key) != m.end();
+  });
+  double map_many_ns = MeasureNs(keys.size(), [&]() {
+    for (std::size_t i = 0; i < keys.size(); i += batch) {
+      found.clear();
+      m.find_many(keys.begin() + i, keys.begin() + i + batch,
+                  std::back_inserter(found));
+      for (auto it : found) hits += it != m.end();
+    }
+  });
+
+  std::printf("%-9zu %-8s %10.1f %10.1f %10.1f %10.1f %10.1f   (%ld)\n", n,
+              sorted ? "sorted" : "random", single_ns, many_ns, std_ns,
+              map_single_ns, map_many_ns, hits % 10);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("batches of 512 keys, ns per key\n");
+  std::printf("%-9s %-8s %10s %10s %10s %10s %10s\n", "n", "keys",
+              "contains", "c_many", "std::set", "map find", "find_many");
+
+  for (std::size_t n : {10000UL, 100000UL, 1000000UL, 4000000UL}) {
+    Run(n, false);
+    Run(n, true);
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../set/s21_set.h"
+
+namespace {
+
+template <typename F>
+double MeasureMs(F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+std::vector<long> ShuffledKeys(std::size_t n, long step, unsigned seed) {
+  std::vector<long> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i) * step;
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+
+  return keys;
+}
+
+s21::set<long> Filled(const std::vector<long> &keys) {
+  s21::set<long> s;
+  for (long key : keys) s.insert(key);
+
+  return s;
+}
+
+/*Runs every operation once serially and once on the given pool; a pool of
+  zero threads stands for the serial version*/
+void Run(std::size_t threads, s21::set<long> &a, s21::set<long> &b,
+         const std::vector<long> &batch) {
+  double ms[4];
+  std::size_t sizes = 0;
+
+  if (threads == 0) {
+    ms[0] = MeasureMs([&]() { sizes += s21::set_union(a, b).size(); });
+    ms[1] = MeasureMs([&]() { sizes += s21::set_intersection(a, b).size(); });
+    ms[2] = MeasureMs([&]() { sizes += s21::set_difference(a, b).size(); });
+
+    s21::set<long> target = a;
+    ms[3] = MeasureMs([&]() {
+      for (long key : batch) target.insert(key);
+    });
+    sizes += target.size();
+
+    std::printf("%-10s", "serial");
+
+  } else {
+    s21::thread_pool pool(threads);
+    ms[0] = MeasureMs([&]() { sizes += s21::set_union(a, b, pool).size(); });
+    ms[1] = MeasureMs(
+        [&]() { sizes += s21::set_intersection(a, b, pool).size(); });
+    ms[2] =
+        MeasureMs([&]() { sizes += s21::set_difference(a, b, pool).size(); });
+
+    s21::set<long> target = a;
+    ms[3] =
+        MeasureMs([&]() { target.insert(batch.begin(), batch.end(), pool); });
+    sizes += target.size();
+
+    std::printf("%-10zu", threads);
+  }
+
+  std::printf(" %10.1f %10.1f %10.1f %10.1f   (%zu)\n", ms[0], ms[1], ms[2],
+              ms[3], sizes % 10);
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t n = 1000000;
+  s21::set<long> a = Filled(ShuffledKeys(n, 2, 1));
+  s21::set<long> b = Filled(ShuffledKeys(n, 3, 2));
+  std::vector<long> batch = ShuffledKeys(n, 5, 3);
+
+  std::printf("n = %zu per operand, ms per operation, %u hardware threads\n",
+              n, std::thread::hardware_concurrency());
+  std::printf("%-10s %10s %10s %10s %10s\n", "threads", "union", "inter",
+              "diff", "insert");
+
+  for (std::size_t threads : {0, 1, 2, 4, 8}) Run(threads, a, b, batch);
+
+  return 0;
+}
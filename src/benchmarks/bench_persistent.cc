@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "../persistent_map/s21_persistent_map.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t versions = 1000;
+  long sum = 0;
+
+  std::printf("ns per version kept: a copy of std::map and s21::map against "
+              "a persistent_map snapshot, then insert and erase that make a "
+              "new version\n");
+  std::printf("%-10s %14s %14s %14s %14s %14s %14s\n", "n", "std::map copy",
+              "s21::map copy", "snapshot", "insert", "erase", "map insert");
+
+  for (std::size_t n : {1000UL, 100000UL, 1000000UL}) {
+    std::vector<long> keys(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      keys[i] = static_cast<long>(2 * i);
+    }
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(n));
+    std::map<long, long> standard;
+    s21::map<long, long> plain;
+    s21::persistent_map<long, long> persistent;
+
+    for (long key : keys) {
+      standard.emplace(key, key);
+      plain.emplace(key, key);
+    }
+
+    persistent = persistent.insert(standard.begin(), standard.end());
+    std::size_t copies = n >= 1000000 ? 3 : 20;
+
+    double std_ns = MeasureNs(copies, [&]() {
+      for (std::size_t i = 0; i < copies; ++i) {
+        std::map<long, long> copy = standard;
+        sum += copy.size();
+      }
+    });
+    double plain_ns = MeasureNs(copies, [&]() {
+      for (std::size_t i = 0; i < copies; ++i) {
+        s21::map<long, long> copy = plain;
+        sum += copy.size();
+      }
+    });
+
+    std::vector<s21::persistent_map<long, long>> kept;
+    kept.reserve(versions);
+    double snapshot_ns = MeasureNs(versions, [&]() {
+      for (std::size_t i = 0; i < versions; ++i) kept.push_back(persistent);
+    });
+    kept.clear();
+
+    /*Each insert and erase keeps the version it was made from, so every
+      one of them copies its path*/
+    s21::persistent_map<long, long> last = persistent;
+    double insert_ns = MeasureNs(versions, [&]() {
+      for (std::size_t i = 0; i < versions; ++i) {
+        kept.push_back(last);
+        last = last.insert({keys[i % n] + 1, 0});
+      }
+    });
+    double erase_ns = MeasureNs(versions, [&]() {
+      for (std::size_t i = 0; i < versions; ++i) {
+        kept.push_back(last);
+        last = last.erase(keys[i % n]);
+      }
+    });
+    double map_ns = MeasureNs(versions, [&]() {
+      for (std::size_t i = 0; i < versions; ++i) {
+        plain.emplace(keys[i % n] + 1, 0);
+      }
+    });
+    sum += last.size() + kept.size() + plain.size();
+
+    std::printf("%-10zu %14.0f %14.0f %14.0f %14.0f %14.0f %14.0f   (%ld)\n", n,
+                std_ns, plain_ns, snapshot_ns, insert_ns, erase_ns, map_ns,
+                sum % 10);
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../vector/s21_vector.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+template <class Vector>
+Vector Filled(std::size_t n) {
+  Vector v;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    v.push_back(static_cast<int>(i));
+  }
+
+  return v;
+}
+
+template <class Vector>
+double Copy(std::size_t n, std::size_t rounds) {
+  Vector source = Filled<Vector>(n);
+  long sum = 0;
+
+  double ns = MeasureNs(n * rounds, [&]() {
+    for (std::size_t i = 0; i < rounds; ++i) {
+      Vector copy(source);
+      sum += copy[i % n];
+    }
+  });
+
+  return sum < 0 ? 0 : ns;
+}
+
+template <class Vector>
+double PushBack(std::size_t n) {
+  Vector v;
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      v.push_back(static_cast<int>(i));
+    }
+  });
+}
+
+template <class Vector>
+double InsertFront(std::size_t n) {
+  Vector v;
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      v.insert(v.begin(), static_cast<int>(i));
+    }
+  });
+}
+
+template <class Vector>
+double EraseFront(std::size_t n) {
+  Vector v = Filled<Vector>(n);
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      v.erase(v.begin());
+    }
+  });
+}
+
+void Report(const char *name, double s21_ns, double std_ns) {
+  std::printf("%-28s %12.2f %12.2f\n", name, s21_ns, std_ns);
+}
+
+}  // namespace
+
+int main() {
+  using S21 = s21::vector<int>;
+  using Std = std::vector<int>;
+
+  std::printf("%-28s %12s %12s\n", "ns per element", "s21::vector",
+              "std::vector");
+  Report("copy construct", Copy<S21>(100000, 200), Copy<Std>(100000, 200));
+  Report("push_back with growth", PushBack<S21>(10000000),
+         PushBack<Std>(10000000));
+  Report("insert at front", InsertFront<S21>(50000),
+         InsertFront<Std>(50000));
+  Report("erase at front", EraseFront<S21>(50000), EraseFront<Std>(50000));
+
+  return 0;
+}
\ No newline at end of file
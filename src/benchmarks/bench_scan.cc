@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../set/s21_set.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+std::vector<long> ShuffledKeys(std::size_t n) {
+  std::vector<long> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i) * 7;
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+
+  return keys;
+}
+
+/*Half of the keys are erased again before scanning, so neighbours in key
+  order are scattered over memory*/
+template <class Set>
+void Run(const char *name, const std::vector<long> &keys) {
+  Set s;
+  long sum = 0;
+  std::size_t half = keys.size() / 2;
+
+  double insert_ns = MeasureNs(keys.size(), [&]() {
+    for (long key : keys) s.insert(key);
+  });
+  double erase_ns = MeasureNs(half, [&]() {
+    for (std::size_t i = 0; i < half; ++i) s.erase(s.find(keys[i]));
+  });
+  double scan_ns = MeasureNs(keys.size() - half, [&]() {
+    for (long key : s) sum += key;
+  });
+  double reverse_ns = MeasureNs(keys.size() - half, [&]() {
+    for (auto it = s.end(); it != s.begin();) sum += *--it;
+  });
+
+  std::printf("%-20s %10.1f %10.1f %10.1f %10.1f   (%ld)\n", name, insert_ns,
+              erase_ns, scan_ns, reverse_ns, sum % 10);
+}
+
+}  // namespace
+
+int main() {
+  for (std::size_t n : {10000UL, 1000000UL}) {
+    std::vector<long> keys = ShuffledKeys(n);
+
+    std::printf("n = %zu, ns per element\n", n);
+    std::printf("%-20s %10s %10s %10s %10s\n", "", "insert", "erase", "scan",
+                "reverse");
+    Run<s21::set<long>>("s21::set", keys);
+    Run<s21::threaded_set<long>>("s21::threaded_set", keys);
+    Run<std::set<long>>("std::set", keys);
+  }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../vector/s21_vector.h"
+
+namespace {
+
+template <typename F>
+double MeasureNs(std::size_t ops, F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+}
+
+template <class Vector, typename T>
+double MiddleInsert(std::size_t n, const T &value) {
+  Vector v;
+
+  return MeasureNs(n, [&]() {
+    for (std::size_t i = 0; i < n; ++i) {
+      v.insert(v.begin() + v.size() / 2, value);
+    }
+  });
+}
+
+template <class Vector, typename T>
+double MiddleInsertMany(std::size_t rounds, const T &value) {
+  Vector v;
+
+  return MeasureNs(rounds * 8, [&]() {
+    for (std::size_t i = 0; i < rounds; ++i) {
+      v.insert_many(v.begin() + v.size() / 2, value, value, value, value,
+                    value, value, value, value);
+    }
+  });
+}
+
+template <class Vector, typename T>
+double StdMiddleInsertMany(std::size_t rounds, const T &value) {
+  Vector v;
+
+  return MeasureNs(rounds * 8, [&]() {
+    for (std::size_t i = 0; i < rounds; ++i) {
+      T items[] = {value, value, value, value, value, value, value, value};
+      v.insert(v.begin() + v.size() / 2, items, items + 8);
+    }
+  });
+}
+
+void Report(const char *name, double s21_ns, double std_ns) {
+  std::printf("%-28s %12.1f %12.1f\n", name, s21_ns, std_ns);
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t n = 20000;
+  const std::string word = "a string too long for the small buffer";
+
+  std::printf("%-28s %12s %12s\n", "ns per element", "s21::vector",
+              "std::vector");
+  Report("insert middle <int>", MiddleInsert<s21::vector<int>>(n, 7),
+         MiddleInsert<std::vector<int>>(n, 7));
+  Report("insert middle <string>",
+         MiddleInsert<s21::vector<std::string>>(n, word),
+         MiddleInsert<std::vector<std::string>>(n, word));
+  Report("insert_many x8 <int>",
+         MiddleInsertMany<s21::vector<int>>(n / 8, 7),
+         StdMiddleInsertMany<std::vector<int>>(n / 8, 7));
+  Report("insert_many x8 <string>",
+         MiddleInsertMany<s21::vector<std::string>>(n / 8, word),
+         StdMiddleInsertMany<std::vector<std::string>>(n / 8, word));
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,1504 @@
+#ifndef CPP_S21_CONTAINERS_BTREE_S21_BTREE_H
+#define CPP_S21_CONTAINERS_BTREE_S21_BTREE_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../allocator/s21_pool_allocator.h"
+#include "../helper/helper.h"
+
+namespace s21 {
+/*Ordered storage behind btree_map, btree_set and btree_multiset. A node
+  keeps up to kNodeSlots values side by side in a block of about kNodeBytes
+  and is searched with a binary search over that block, so a lookup costs
+  one likely cache miss per level instead of one per comparison. Values
+  move between nodes on insert and erase, which invalidates iterators into
+  the nodes touched.*/
+template <typename K, typename T, class Compare, class Extracter,
+          class Alloc = s21::pool_allocator<T>>
+class BTree {
+  struct Node;
+  struct InternalNode;
+
+  using leaf_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_allocator = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<InternalNode>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+
+ public:
+  class BTreeIterator;
+  class BTreeConstIterator;
+
+  using key_type = K;
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = BTreeIterator;
+  using const_iterator = BTreeConstIterator;
+  using allocator_type = Alloc;
+
+  static constexpr size_type kNodeBytes = 256;
+  static constexpr size_type kNodeSlots =
+      (kNodeBytes - 2 * sizeof(void *)) / sizeof(value_type) > 3
+          ? (kNodeBytes - 2 * sizeof(void *)) / sizeof(value_type)
+          : 3;
+
+  class BTreeIterator {
+    friend class BTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = BTree::value_type;
+    using pointer = BTree::pointer;
+    using reference = BTree::reference;
+
+    BTreeIterator() noexcept;
+
+    iterator &operator++() noexcept;
+    iterator operator++(int) noexcept;
+    iterator &operator--() noexcept;
+    iterator operator--(int) noexcept;
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+
+   protected:
+    Node *node_;
+    size_type position_;
+
+    BTreeIterator(Node *node, size_type position) noexcept;
+  };
+
+  class BTreeConstIterator : public BTreeIterator {
+    friend class BTree;
+
+   public:
+    using reference = BTree::const_reference;
+    using pointer = const value_type *;
+
+    BTreeConstIterator() noexcept;
+    BTreeConstIterator(const iterator &other) noexcept;
+
+    const_reference operator*() const noexcept;
+    const value_type *operator->() const noexcept;
+  };
+
+  BTree();
+  explicit BTree(const allocator_type &alloc);
+  BTree(const BTree &other);
+  BTree(BTree &&other) noexcept;
+  ~BTree();
+
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept;
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
+
+  void clear();
+  std::pair<iterator, bool> insert_unique(const value_type &val);
+  std::pair<iterator, bool> insert_unique(value_type &&val);
+  iterator insert_equal(const value_type &val);
+  iterator insert_equal(value_type &&val);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args &&...args);
+  template <typename... Args>
+  iterator emplace_equal(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace_unique(const key_type &key,
+                                               Args &&...args);
+  template <typename V>
+  iterator insert_hint_unique(const_iterator hint, V &&val);
+  template <typename V>
+  iterator insert_hint_equal(const_iterator hint, V &&val);
+  template <typename... Args>
+  iterator emplace_hint_unique(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint_equal(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void insert_unique(InputIt first, InputIt last);
+  template <typename InputIt>
+  void insert_equal(InputIt first, InputIt last);
+  iterator erase(const_iterator pos);
+  void swap(BTree &other) noexcept;
+  void merge_unique(BTree &other);
+  void merge_equal(BTree &other);
+
+  template <typename Key>
+  iterator search(const Key &key) const noexcept;
+  template <typename Key>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key>
+  iterator lower_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key>
+  iterator upper_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator upper_bound(const Key &key) const noexcept;
+  template <typename Key>
+  size_type count(const Key &key) const noexcept;
+  template <typename Key>
+  std::pair<iterator, iterator> equal_range(const Key &key) noexcept;
+  template <typename Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const noexcept;
+
+ private:
+  static constexpr size_type kMinNodeValues = kNodeSlots / 2;
+  static constexpr bool kRelocatable =
+      is_trivially_relocatable_v<value_type> &&
+      std::is_nothrow_move_constructible<value_type>::value;
+
+  struct Node {
+    InternalNode *parent_;
+    unsigned short position_;
+    unsigned short count_;
+    bool leaf_;
+    alignas(value_type) unsigned char slots_[kNodeSlots * sizeof(value_type)];
+
+    value_type *Slot(size_type i) noexcept {
+      return reinterpret_cast<value_type *>(slots_) + i;
+    }
+  };
+
+  struct InternalNode : Node {
+    Node *children_[kNodeSlots + 1];
+  };
+
+  Node *root_;
+  Node *leftmost_;
+  Node *rightmost_;
+  size_type size_;
+  Compare comp_;
+  Extracter extracter_;
+  leaf_allocator alloc_;
+
+  Node *CreateNode(bool leaf);
+  void DestroyNode(Node *node) noexcept;
+  void DestroySubtree(Node *node) noexcept;
+  void FreeSubtree(Node *node) noexcept;
+  Node *CopySubtree(Node *src);
+  void CopyTree(const BTree &other);
+  void Steal(BTree &other) noexcept;
+
+  static Node *Child(Node *node, size_type i) noexcept;
+  static void SetChild(Node *node, size_type i, Node *child) noexcept;
+  static void MoveSlots(value_type *dst, value_type *src,
+                        size_type n) noexcept;
+
+  template <typename Key>
+  size_type LowerIndex(Node *node, const Key &key) const noexcept;
+  template <typename Key>
+  size_type UpperIndex(Node *node, const Key &key) const noexcept;
+  template <typename Key>
+  iterator LowerBound(const Key &key) const noexcept;
+  template <typename Key>
+  iterator UpperBound(const Key &key) const noexcept;
+
+  std::pair<iterator, bool> GetInsertUniqPos(const key_type &key) const;
+  iterator GetInsertEqPos(const key_type &key) const;
+  std::pair<iterator, bool> GetHintUniqPos(const_iterator hint,
+                                           const key_type &key) const;
+  iterator GetHintEqPos(const_iterator hint, const key_type &key) const;
+  iterator LeafPos(iterator pos) const noexcept;
+  template <typename... Args>
+  iterator InsertAt(iterator pos, Args &&...args);
+  std::pair<Node *, size_type> Split(Node *node, size_type i);
+
+  iterator RebalanceAfterErase(iterator pos);
+  bool MergeOrRotate(iterator &pos);
+  void Merge(Node *left, Node *right) noexcept;
+  void RotateLeft(Node *node, Node *right, size_type n) noexcept;
+  void RotateRight(Node *left, Node *node, size_type n) noexcept;
+  void ShrinkRoot() noexcept;
+};
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTree()
+    : root_(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      size_(0),
+      comp_(),
+      extracter_(),
+      alloc_() {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTree(const allocator_type &alloc)
+    : root_(nullptr),
+      leftmost_(nullptr),
+      rightmost_(nullptr),
+      size_(0),
+      comp_(),
+      extracter_(),
+      alloc_(alloc) {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTree(const BTree &other)
+    : BTree(leaf_traits::select_on_container_copy_construction(other.alloc_)) {
+  CopyTree(other);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTree(BTree &&other) noexcept
+    : BTree() {
+  swap(other);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::~BTree() {
+  clear();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc> &
+BTree<K, T, Compare, Extracter, Alloc>::operator=(const BTree &other) {
+  if (this != &other) {
+    clear();
+    CopyTree(other);
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc> &
+BTree<K, T, Compare, Extracter, Alloc>::operator=(BTree &&other) noexcept {
+  if (this != &other) {
+    clear();
+
+    if constexpr (leaf_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    }
+
+    Steal(other);
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::begin() noexcept {
+  return iterator(leftmost_, 0);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::begin() const noexcept {
+  return iterator(leftmost_, 0);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::cbegin() const noexcept {
+  return begin();
+}
+
+/*End sits one past the last value of the rightmost leaf, so stepping back
+  from it needs no special case*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::end() noexcept {
+  return iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::end() const noexcept {
+  return iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::cend() const noexcept {
+  return end();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool BTree<K, T, Compare, Extracter, Alloc>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::size_type
+BTree<K, T, Compare, Extracter, Alloc>::size() const noexcept {
+  return size_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::size_type
+BTree<K, T, Compare, Extracter, Alloc>::max_size() const {
+  return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::allocator_type
+BTree<K, T, Compare, Extracter, Alloc>::get_allocator() const noexcept {
+  return allocator_type(alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::clear() {
+  if (root_ == nullptr) {
+    return;
+  }
+
+  if constexpr (is_releasable_allocator<leaf_allocator>::value) {
+    if (alloc_.unique()) {
+      DestroySubtree(root_);
+      alloc_.release();
+
+    } else {
+      FreeSubtree(root_);
+    }
+
+  } else {
+    FreeSubtree(root_);
+  }
+
+  root_ = leftmost_ = rightmost_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::insert_unique(const value_type &val) {
+  std::pair<iterator, bool> res = GetInsertUniqPos(extracter_(val));
+
+  if (!res.second) {
+    return res;
+  }
+
+  return std::make_pair(InsertAt(res.first, val), true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::insert_unique(value_type &&val) {
+  std::pair<iterator, bool> res = GetInsertUniqPos(extracter_(val));
+
+  if (!res.second) {
+    return res;
+  }
+
+  return std::make_pair(InsertAt(res.first, std::move(val)), true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::insert_equal(const value_type &val) {
+  return InsertAt(GetInsertEqPos(extracter_(val)), val);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::insert_equal(value_type &&val) {
+  return InsertAt(GetInsertEqPos(extracter_(val)), std::move(val));
+}
+
+/*The key is only known once the value exists, so it is built up front and
+  moved into its slot*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::emplace_unique(Args &&...args) {
+  return insert_unique(value_type(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::emplace_equal(Args &&...args) {
+  return insert_equal(value_type(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::try_emplace_unique(
+    const key_type &key, Args &&...args) {
+  std::pair<iterator, bool> res = GetInsertUniqPos(key);
+
+  if (!res.second) {
+    return res;
+  }
+
+  return std::make_pair(InsertAt(res.first, std::forward<Args>(args)...),
+                        true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename V>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::insert_hint_unique(const_iterator hint,
+                                                           V &&val) {
+  std::pair<iterator, bool> res = GetHintUniqPos(hint, extracter_(val));
+
+  if (!res.second) {
+    return res.first;
+  }
+
+  return InsertAt(res.first, std::forward<V>(val));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename V>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::insert_hint_equal(const_iterator hint,
+                                                          V &&val) {
+  return InsertAt(GetHintEqPos(hint, extracter_(val)), std::forward<V>(val));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::emplace_hint_unique(
+    const_iterator hint, Args &&...args) {
+  return insert_hint_unique(hint, value_type(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::emplace_hint_equal(
+    const_iterator hint, Args &&...args) {
+  return insert_hint_equal(hint, value_type(std::forward<Args>(args)...));
+}
+
+/*Sorted input always lands after the last value, which the end hint turns
+  into an append to the rightmost leaf*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename InputIt>
+void BTree<K, T, Compare, Extracter, Alloc>::insert_unique(InputIt first,
+                                                           InputIt last) {
+  for (; first != last; ++first) {
+    insert_hint_unique(cend(), *first);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename InputIt>
+void BTree<K, T, Compare, Extracter, Alloc>::insert_equal(InputIt first,
+                                                          InputIt last) {
+  for (; first != last; ++first) {
+    insert_hint_equal(cend(), *first);
+  }
+}
+
+/*A value in an internal node is replaced by its predecessor, which always
+  sits last in a leaf, so the hole is always opened in a leaf*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::erase(const_iterator pos) {
+  iterator hole(pos.node_, pos.position_);
+  bool internal = !hole.node_->leaf_;
+
+  hole.node_->Slot(hole.position_)->~value_type();
+
+  if (internal) {
+    iterator inner = hole;
+    --hole;
+    MoveSlots(inner.node_->Slot(inner.position_),
+              hole.node_->Slot(hole.position_), 1);
+  }
+
+  Node *leaf = hole.node_;
+  MoveSlots(leaf->Slot(hole.position_), leaf->Slot(hole.position_ + 1),
+            leaf->count_ - hole.position_ - 1);
+  --leaf->count_;
+  --size_;
+
+  iterator next = RebalanceAfterErase(hole);
+
+  if (internal) {
+    ++next;
+  }
+
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::swap(BTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::merge_unique(BTree &other) {
+  if (this == &other) {
+    return;
+  }
+
+  for (iterator i = other.begin(); i != other.end();) {
+    std::pair<iterator, bool> res = GetInsertUniqPos(extracter_(*i));
+
+    if (res.second) {
+      InsertAt(res.first, std::move(*i));
+      i = other.erase(i);
+
+    } else {
+      ++i;
+    }
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::merge_equal(BTree &other) {
+  if (this == &other) {
+    return;
+  }
+
+  for (iterator i = other.begin(); i != other.end();) {
+    insert_equal(std::move(*i));
+    i = other.erase(i);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::search(const Key &key) const noexcept {
+  Node *node = root_;
+
+  while (node != nullptr) {
+    size_type i = LowerIndex(node, key);
+
+    if (i < node->count_ && !comp_(key, extracter_(*node->Slot(i)))) {
+      return iterator(node, i);
+    }
+
+    if (node->leaf_) {
+      break;
+    }
+
+    node = Child(node, i);
+  }
+
+  return iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+bool BTree<K, T, Compare, Extracter, Alloc>::contains(
+    const Key &key) const noexcept {
+  return search(key) != end();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::lower_bound(const Key &key) noexcept {
+  return LowerBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::lower_bound(
+    const Key &key) const noexcept {
+  return LowerBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::upper_bound(const Key &key) noexcept {
+  return UpperBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator
+BTree<K, T, Compare, Extracter, Alloc>::upper_bound(
+    const Key &key) const noexcept {
+  return UpperBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::size_type
+BTree<K, T, Compare, Extracter, Alloc>::count(const Key &key) const noexcept {
+  size_type found = 0;
+
+  for (iterator i = LowerBound(key), last = UpperBound(key); i != last; ++i) {
+    ++found;
+  }
+
+  return found;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator,
+          typename BTree<K, T, Compare, Extracter, Alloc>::iterator>
+BTree<K, T, Compare, Extracter, Alloc>::equal_range(const Key &key) noexcept {
+  return std::make_pair(LowerBound(key), UpperBound(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator,
+          typename BTree<K, T, Compare, Extracter, Alloc>::const_iterator>
+BTree<K, T, Compare, Extracter, Alloc>::equal_range(
+    const Key &key) const noexcept {
+  return std::make_pair(const_iterator(LowerBound(key)),
+                        const_iterator(UpperBound(key)));
+}
+
+/*Nodes*/
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::Node *
+BTree<K, T, Compare, Extracter, Alloc>::CreateNode(bool leaf) {
+  Node *node = nullptr;
+
+  if (leaf) {
+    node = ::new (static_cast<void *>(leaf_traits::allocate(alloc_, 1))) Node;
+
+  } else {
+    internal_allocator alloc(alloc_);
+    node = ::new (static_cast<void *>(internal_traits::allocate(alloc, 1)))
+        InternalNode;
+  }
+
+  node->parent_ = nullptr;
+  node->position_ = 0;
+  node->count_ = 0;
+  node->leaf_ = leaf;
+
+  return node;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::DestroyNode(Node *node) noexcept {
+  if (node->leaf_) {
+    leaf_traits::deallocate(alloc_, node, 1);
+
+  } else {
+    internal_allocator alloc(alloc_);
+    internal_traits::deallocate(alloc, static_cast<InternalNode *>(node), 1);
+  }
+}
+
+/*Runs the value destructors only; the memory goes back with the pool*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::DestroySubtree(
+    Node *node) noexcept {
+  if constexpr (!std::is_trivially_destructible<value_type>::value) {
+    for (size_type i = 0; i < node->count_; ++i) {
+      node->Slot(i)->~value_type();
+    }
+
+    if (!node->leaf_) {
+      for (size_type i = 0; i <= node->count_; ++i) {
+        DestroySubtree(Child(node, i));
+      }
+    }
+
+  } else {
+    (void)node;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::FreeSubtree(Node *node) noexcept {
+  for (size_type i = 0; i < node->count_; ++i) {
+    node->Slot(i)->~value_type();
+  }
+
+  if (!node->leaf_) {
+    for (size_type i = 0; i <= node->count_; ++i) {
+      FreeSubtree(Child(node, i));
+    }
+  }
+
+  DestroyNode(node);
+}
+
+/*Children are copied before their parent, so the first node allocated is
+  a leaf. A lazily pooled allocator creates its pool there, and the internal
+  node allocator rebound from it afterwards shares that pool.*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::Node *
+BTree<K, T, Compare, Extracter, Alloc>::CopySubtree(Node *src) {
+  Node *children[kNodeSlots + 1];
+
+  if (!src->leaf_) {
+    for (size_type i = 0; i <= src->count_; ++i) {
+      children[i] = CopySubtree(Child(src, i));
+    }
+  }
+
+  Node *node = CreateNode(src->leaf_);
+
+  for (; node->count_ < src->count_; ++node->count_) {
+    ::new (static_cast<void *>(node->Slot(node->count_)))
+        value_type(*src->Slot(node->count_));
+  }
+
+  if (!src->leaf_) {
+    for (size_type i = 0; i <= src->count_; ++i) {
+      SetChild(node, i, children[i]);
+    }
+  }
+
+  return node;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::CopyTree(const BTree &other) {
+  if (other.root_ == nullptr) {
+    return;
+  }
+
+  root_ = CopySubtree(other.root_);
+  size_ = other.size_;
+
+  for (leftmost_ = root_; !leftmost_->leaf_;) {
+    leftmost_ = Child(leftmost_, 0);
+  }
+
+  for (rightmost_ = root_; !rightmost_->leaf_;) {
+    rightmost_ = Child(rightmost_, rightmost_->count_);
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::Steal(BTree &other) noexcept {
+  root_ = other.root_;
+  leftmost_ = other.leftmost_;
+  rightmost_ = other.rightmost_;
+  size_ = other.size_;
+
+  other.root_ = other.leftmost_ = other.rightmost_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::Node *
+BTree<K, T, Compare, Extracter, Alloc>::Child(Node *node,
+                                              size_type i) noexcept {
+  return static_cast<InternalNode *>(node)->children_[i];
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::SetChild(Node *node, size_type i,
+                                                      Node *child) noexcept {
+  static_cast<InternalNode *>(node)->children_[i] = child;
+  child->parent_ = static_cast<InternalNode *>(node);
+  child->position_ = static_cast<unsigned short>(i);
+}
+
+/*Moves n values that may overlap the destination and leaves the source
+  slots unconstructed*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::MoveSlots(value_type *dst,
+                                                       value_type *src,
+                                                       size_type n) noexcept {
+  if (n == 0 || dst == src) {
+    return;
+  }
+
+  if constexpr (kRelocatable) {
+    std::memmove(static_cast<void *>(dst), static_cast<const void *>(src),
+                 n * sizeof(value_type));
+
+  } else if (dst < src) {
+    for (size_type i = 0; i < n; ++i) {
+      ::new (static_cast<void *>(dst + i)) value_type(std::move(src[i]));
+      src[i].~value_type();
+    }
+
+  } else {
+    for (size_type i = n; i > 0; --i) {
+      ::new (static_cast<void *>(dst + i - 1))
+          value_type(std::move(src[i - 1]));
+      src[i - 1].~value_type();
+    }
+  }
+}
+
+/*Lookup*/
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::size_type
+BTree<K, T, Compare, Extracter, Alloc>::LowerIndex(
+    Node *node, const Key &key) const noexcept {
+  size_type low = 0;
+  size_type high = node->count_;
+
+  while (low < high) {
+    size_type mid = (low + high) / 2;
+
+    if (comp_(extracter_(*node->Slot(mid)), key)) {
+      low = mid + 1;
+
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::size_type
+BTree<K, T, Compare, Extracter, Alloc>::UpperIndex(
+    Node *node, const Key &key) const noexcept {
+  size_type low = 0;
+  size_type high = node->count_;
+
+  while (low < high) {
+    size_type mid = (low + high) / 2;
+
+    if (comp_(key, extracter_(*node->Slot(mid)))) {
+      high = mid;
+
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  return low;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::LowerBound(
+    const Key &key) const noexcept {
+  iterator bound(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+
+  for (Node *node = root_; node != nullptr;) {
+    size_type i = LowerIndex(node, key);
+
+    if (i < node->count_) {
+      bound = iterator(node, i);
+    }
+
+    node = node->leaf_ ? nullptr : Child(node, i);
+  }
+
+  return bound;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::UpperBound(
+    const Key &key) const noexcept {
+  iterator bound(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+
+  for (Node *node = root_; node != nullptr;) {
+    size_type i = UpperIndex(node, key);
+
+    if (i < node->count_) {
+      bound = iterator(node, i);
+    }
+
+    node = node->leaf_ ? nullptr : Child(node, i);
+  }
+
+  return bound;
+}
+
+/*Insertion*/
+
+/*Returns the equal value or the leaf slot the key belongs in*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::GetInsertUniqPos(
+    const key_type &key) const {
+  Node *node = root_;
+
+  while (node != nullptr) {
+    size_type i = LowerIndex(node, key);
+
+    if (i < node->count_ && !comp_(key, extracter_(*node->Slot(i)))) {
+      return std::make_pair(iterator(node, i), false);
+    }
+
+    if (node->leaf_) {
+      return std::make_pair(iterator(node, i), true);
+    }
+
+    node = Child(node, i);
+  }
+
+  return std::make_pair(iterator(), true);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::GetInsertEqPos(
+    const key_type &key) const {
+  Node *node = root_;
+
+  while (node != nullptr) {
+    size_type i = UpperIndex(node, key);
+
+    if (node->leaf_) {
+      return iterator(node, i);
+    }
+
+    node = Child(node, i);
+  }
+
+  return iterator();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::iterator, bool>
+BTree<K, T, Compare, Extracter, Alloc>::GetHintUniqPos(
+    const_iterator hint, const key_type &key) const {
+  if (root_ == nullptr) {
+    return std::make_pair(iterator(), true);
+  }
+
+  iterator pos(hint.node_, hint.position_);
+  iterator last = end();
+
+  if (pos == last || comp_(key, extracter_(*pos))) {
+    iterator before = pos;
+
+    if (pos.node_ == leftmost_ && pos.position_ == 0) {
+      return std::make_pair(pos, true);
+    }
+
+    if (comp_(extracter_(*--before), key)) {
+      return std::make_pair(LeafPos(pos), true);
+    }
+
+  } else if (comp_(extracter_(*pos), key)) {
+    iterator after = pos;
+
+    if (++after == last || comp_(key, extracter_(*after))) {
+      return std::make_pair(LeafPos(after), true);
+    }
+
+  } else {
+    return std::make_pair(pos, false);
+  }
+
+  return GetInsertUniqPos(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::GetHintEqPos(
+    const_iterator hint, const key_type &key) const {
+  if (root_ == nullptr) {
+    return iterator();
+  }
+
+  iterator pos(hint.node_, hint.position_);
+  iterator before = pos;
+
+  if ((pos == end() || !comp_(extracter_(*pos), key)) &&
+      ((pos.node_ == leftmost_ && pos.position_ == 0) ||
+       !comp_(key, extracter_(*--before)))) {
+    return LeafPos(pos);
+  }
+
+  return GetInsertEqPos(key);
+}
+
+/*Inserting before a value of an internal node is the same as appending to
+  the leaf holding its predecessor*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::LeafPos(iterator pos) const noexcept {
+  if (pos.node_->leaf_) {
+    return pos;
+  }
+
+  --pos;
+  ++pos.position_;
+  return pos;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::InsertAt(iterator pos,
+                                                 Args &&...args) {
+  if (root_ == nullptr) {
+    root_ = leftmost_ = rightmost_ = CreateNode(true);
+    pos = iterator(root_, 0);
+  }
+
+  Node *node = pos.node_;
+  size_type i = pos.position_;
+
+  if (node->count_ == kNodeSlots) {
+    std::tie(node, i) = Split(node, i);
+  }
+
+  MoveSlots(node->Slot(i + 1), node->Slot(i), node->count_ - i);
+
+  try {
+    ::new (static_cast<void *>(node->Slot(i)))
+        value_type(std::forward<Args>(args)...);
+
+  } catch (...) {
+    MoveSlots(node->Slot(i), node->Slot(i + 1), node->count_ - i);
+
+    if (size_ == 0) {
+      DestroyNode(root_);
+      root_ = leftmost_ = rightmost_ = nullptr;
+    }
+
+    throw;
+  }
+
+  ++node->count_;
+  ++size_;
+
+  return iterator(node, i);
+}
+
+/*Moves the upper part of a full node into a new right sibling and lifts
+  the separator into the parent, splitting the parent first if it is full
+  too. Appends keep the left node full and prepends keep the right node
+  nearly full, so sorted input packs the leaves. Returns where slot i
+  ended up.*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+std::pair<typename BTree<K, T, Compare, Extracter, Alloc>::Node *,
+          typename BTree<K, T, Compare, Extracter, Alloc>::size_type>
+BTree<K, T, Compare, Extracter, Alloc>::Split(Node *node, size_type i) {
+  if (node == root_) {
+    Node *root = CreateNode(false);
+    SetChild(root, 0, node);
+    root_ = root;
+
+  } else if (node->parent_->count_ == kNodeSlots) {
+    Split(node->parent_, node->position_);
+  }
+
+  Node *sibling = CreateNode(node->leaf_);
+  InternalNode *parent = node->parent_;
+  size_type at = node->position_;
+  size_type mid = node->count_ / 2;
+
+  if (i == node->count_) {
+    mid = node->count_ - 1;
+
+  } else if (i == 0) {
+    mid = 1;
+  }
+
+  size_type moved = node->count_ - mid - 1;
+
+  MoveSlots(sibling->Slot(0), node->Slot(mid + 1), moved);
+
+  if (!node->leaf_) {
+    for (size_type c = 0; c <= moved; ++c) {
+      SetChild(sibling, c, Child(node, mid + 1 + c));
+    }
+  }
+
+  MoveSlots(parent->Slot(at + 1), parent->Slot(at), parent->count_ - at);
+
+  for (size_type c = parent->count_; c > at; --c) {
+    SetChild(parent, c + 1, Child(parent, c));
+  }
+
+  MoveSlots(parent->Slot(at), node->Slot(mid), 1);
+  SetChild(parent, at + 1, sibling);
+  ++parent->count_;
+
+  sibling->count_ = static_cast<unsigned short>(moved);
+  node->count_ = static_cast<unsigned short>(mid);
+
+  if (rightmost_ == node) {
+    rightmost_ = sibling;
+  }
+
+  if (i <= mid) {
+    return std::make_pair(node, i);
+  }
+
+  return std::make_pair(sibling, i - mid - 1);
+}
+
+/*Erasure*/
+
+/*Refills underfull nodes from the leaf up. Only the first step can move
+  the values around pos, so that is where the result is tracked; a result
+  left past the end of its node is then stepped onto the next value.*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::RebalanceAfterErase(iterator pos) {
+  iterator res = pos;
+  bool first = true;
+
+  while (true) {
+    if (pos.node_ == root_) {
+      ShrinkRoot();
+
+      if (root_ == nullptr) {
+        return end();
+      }
+
+      break;
+    }
+
+    if (pos.node_->count_ >= kMinNodeValues) {
+      break;
+    }
+
+    bool merged = MergeOrRotate(pos);
+
+    if (first) {
+      res = pos;
+      first = false;
+    }
+
+    if (!merged) {
+      break;
+    }
+
+    pos.position_ = pos.node_->position_;
+    pos.node_ = pos.node_->parent_;
+  }
+
+  if (res.position_ == res.node_->count_) {
+    res.position_ = res.node_->count_ - 1;
+    ++res;
+  }
+
+  return res;
+}
+
+/*Merges the node with a sibling when both fit into one node, otherwise
+  borrows values from a sibling. Borrowing is skipped when the erased
+  value was at the far end of a non-empty node, which keeps erasing a run
+  from one side cheap. Returns whether the parent lost a value.*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool BTree<K, T, Compare, Extracter, Alloc>::MergeOrRotate(iterator &pos) {
+  Node *node = pos.node_;
+  InternalNode *parent = node->parent_;
+  Node *left = node->position_ > 0 ? Child(parent, node->position_ - 1)
+                                   : nullptr;
+  Node *right = node->position_ < parent->count_
+                    ? Child(parent, node->position_ + 1)
+                    : nullptr;
+
+  if (left != nullptr && 1u + left->count_ + node->count_ <= kNodeSlots) {
+    pos.position_ += 1 + left->count_;
+    pos.node_ = left;
+    Merge(left, node);
+    return true;
+  }
+
+  if (right != nullptr) {
+    if (1u + node->count_ + right->count_ <= kNodeSlots) {
+      Merge(node, right);
+      return true;
+    }
+
+    if (right->count_ > kMinNodeValues &&
+        (node->count_ == 0 || pos.position_ > 0)) {
+      size_type n = (right->count_ - node->count_) / 2;
+      RotateLeft(node, right, n < right->count_ ? n : right->count_ - 1u);
+      return false;
+    }
+  }
+
+  if (left != nullptr && left->count_ > kMinNodeValues &&
+      (node->count_ == 0 || pos.position_ < node->count_)) {
+    size_type n = (left->count_ - node->count_) / 2;
+    n = n < left->count_ ? n : left->count_ - 1u;
+    RotateRight(left, node, n);
+    pos.position_ += n;
+  }
+
+  return false;
+}
+
+/*Pulls the separator down into left and appends right to it*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::Merge(Node *left,
+                                                   Node *right) noexcept {
+  InternalNode *parent = left->parent_;
+  size_type at = left->position_;
+
+  MoveSlots(left->Slot(left->count_), parent->Slot(at), 1);
+  MoveSlots(left->Slot(left->count_ + 1), right->Slot(0), right->count_);
+
+  if (!left->leaf_) {
+    for (size_type c = 0; c <= right->count_; ++c) {
+      SetChild(left, left->count_ + 1 + c, Child(right, c));
+    }
+  }
+
+  left->count_ += 1 + right->count_;
+
+  MoveSlots(parent->Slot(at), parent->Slot(at + 1), parent->count_ - at - 1);
+
+  for (size_type c = at + 1; c < parent->count_; ++c) {
+    SetChild(parent, c, Child(parent, c + 1));
+  }
+
+  --parent->count_;
+
+  if (rightmost_ == right) {
+    rightmost_ = left;
+  }
+
+  DestroyNode(right);
+}
+
+/*Shifts n values from right through the separator onto the end of node*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::RotateLeft(Node *node,
+                                                        Node *right,
+                                                        size_type n) noexcept {
+  InternalNode *parent = node->parent_;
+  size_type at = node->position_;
+
+  MoveSlots(node->Slot(node->count_), parent->Slot(at), 1);
+  MoveSlots(node->Slot(node->count_ + 1), right->Slot(0), n - 1);
+  MoveSlots(parent->Slot(at), right->Slot(n - 1), 1);
+  MoveSlots(right->Slot(0), right->Slot(n), right->count_ - n);
+
+  if (!node->leaf_) {
+    for (size_type c = 0; c < n; ++c) {
+      SetChild(node, node->count_ + 1 + c, Child(right, c));
+    }
+
+    for (size_type c = 0; c + n <= right->count_; ++c) {
+      SetChild(right, c, Child(right, c + n));
+    }
+  }
+
+  node->count_ += n;
+  right->count_ -= n;
+}
+
+/*Shifts n values from left through the separator onto the front of node*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::RotateRight(Node *left,
+                                                         Node *node,
+                                                         size_type n) noexcept {
+  InternalNode *parent = left->parent_;
+  size_type at = left->position_;
+
+  MoveSlots(node->Slot(n), node->Slot(0), node->count_);
+  MoveSlots(node->Slot(n - 1), parent->Slot(at), 1);
+  MoveSlots(node->Slot(0), left->Slot(left->count_ - n + 1), n - 1);
+  MoveSlots(parent->Slot(at), left->Slot(left->count_ - n), 1);
+
+  if (!node->leaf_) {
+    for (size_type c = node->count_ + 1; c > 0; --c) {
+      SetChild(node, c - 1 + n, Child(node, c - 1));
+    }
+
+    for (size_type c = 0; c < n; ++c) {
+      SetChild(node, c, Child(left, left->count_ - n + 1 + c));
+    }
+  }
+
+  left->count_ -= n;
+  node->count_ += n;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void BTree<K, T, Compare, Extracter, Alloc>::ShrinkRoot() noexcept {
+  if (root_->count_ > 0) {
+    return;
+  }
+
+  Node *old = root_;
+
+  if (old->leaf_) {
+    root_ = leftmost_ = rightmost_ = nullptr;
+
+  } else {
+    root_ = Child(old, 0);
+    root_->parent_ = nullptr;
+    root_->position_ = 0;
+  }
+
+  DestroyNode(old);
+}
+
+/*Iterators*/
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTreeIterator::BTreeIterator() noexcept
+    : node_(nullptr), position_(0) {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::BTreeIterator::BTreeIterator(
+    Node *node, size_type position) noexcept
+    : node_(node), position_(position) {}
+
+/*From a leaf the next value is either beside this one or in the nearest
+  ancestor entered from the left; from an internal node it is the first
+  value of the leftmost leaf of the right subtree*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator &
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator++() noexcept {
+  if (!node_->leaf_) {
+    node_ = Child(node_, position_ + 1);
+
+    while (!node_->leaf_) {
+      node_ = Child(node_, 0);
+    }
+
+    position_ = 0;
+    return *this;
+  }
+
+  if (++position_ < node_->count_) {
+    return *this;
+  }
+
+  Node *node = node_;
+  size_type position = position_;
+
+  while (position == node->count_ && node->parent_ != nullptr) {
+    position = node->position_;
+    node = node->parent_;
+  }
+
+  if (position < node->count_) {
+    node_ = node;
+    position_ = position;
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator++(int) noexcept {
+  iterator tmp = *this;
+  ++(*this);
+  return tmp;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator &
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator--() noexcept {
+  if (!node_->leaf_) {
+    node_ = Child(node_, position_);
+
+    while (!node_->leaf_) {
+      node_ = Child(node_, node_->count_);
+    }
+
+    position_ = node_->count_ - 1;
+    return *this;
+  }
+
+  if (position_ > 0) {
+    --position_;
+    return *this;
+  }
+
+  Node *node = node_;
+  size_type position = 0;
+
+  while (position == 0 && node->parent_ != nullptr) {
+    position = node->position_;
+    node = node->parent_;
+  }
+
+  if (position > 0) {
+    node_ = node;
+    position_ = position - 1;
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::iterator
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator--(int) noexcept {
+  iterator tmp = *this;
+  --(*this);
+  return tmp;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::reference
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator*() const noexcept {
+  return *node_->Slot(position_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::pointer
+BTree<K, T, Compare, Extracter, Alloc>::iterator::operator->() const noexcept {
+  return node_->Slot(position_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool BTree<K, T, Compare, Extracter, Alloc>::iterator::operator==(
+    const iterator &other) const noexcept {
+  return node_ == other.node_ && position_ == other.position_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool BTree<K, T, Compare, Extracter, Alloc>::iterator::operator!=(
+    const iterator &other) const noexcept {
+  return !(*this == other);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter,
+      Alloc>::const_iterator::BTreeConstIterator() noexcept
+    : BTreeIterator() {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+BTree<K, T, Compare, Extracter, Alloc>::const_iterator::BTreeConstIterator(
+    const iterator &other) noexcept
+    : BTreeIterator(other) {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename BTree<K, T, Compare, Extracter, Alloc>::const_reference
+BTree<K, T, Compare, Extracter, Alloc>::const_iterator::operator*()
+    const noexcept {
+  return *BTreeIterator::node_->Slot(BTreeIterator::position_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+const typename BTree<K, T, Compare, Extracter, Alloc>::value_type *
+BTree<K, T, Compare, Extracter, Alloc>::const_iterator::operator->()
+    const noexcept {
+  return BTreeIterator::node_->Slot(BTreeIterator::position_);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
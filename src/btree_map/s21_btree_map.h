@@ -0,0 +1,470 @@
+#ifndef CPP_S21_CONTAINERS_BTREE_MAP_S21_BTREE_MAP_H
+#define CPP_S21_CONTAINERS_BTREE_MAP_S21_BTREE_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../btree/s21_btree.h"
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*Drop-in alternative to s21::map backed by a B-tree: faster lookups and
+  less memory per element, but iterators are invalidated by any insert or
+  erase, not only by erasing the element they point to*/
+template <typename K, typename T, class Compare = s21::Compare<K, T>,
+          class Extract = s21::KeyExtract<K, T>,
+          class Alloc = s21::pool_allocator<std::pair<K, T>>>
+class btree_map {
+ public:
+  using key_type = K;
+  using mapped_value = T;
+  using value_type = std::pair<K, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+  using Container = s21::BTree<K, std::pair<K, T>, Compare, Extract, Alloc>;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  btree_map();
+  explicit btree_map(const allocator_type &alloc);
+  btree_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  btree_map(InputIt first, InputIt last);
+  btree_map(const btree_map &m);
+  btree_map(btree_map &&m) noexcept;
+  ~btree_map();
+
+  btree_map &operator=(const btree_map &m);
+  btree_map &operator=(btree_map &&m) noexcept;
+
+  T &at(const key_type &k) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  T &at(const Key &k) const;
+  T &operator[](const key_type &k);
+  T &operator[](key_type &&k);
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
+
+  void clear();
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_value &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_value &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  iterator erase(iterator pos);
+  void swap(btree_map &other);
+  void merge(btree_map &other);
+
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key);
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key &key) const;
+  bool contains(const key_type &key) const noexcept;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const noexcept;
+  size_type count(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const Key &key) const;
+
+  template <typename... Args>
+  s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+ private:
+  Container map_;
+};
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map() : map_() {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map(const allocator_type &alloc)
+    : map_(alloc) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map(
+    std::initializer_list<value_type> const &items)
+    : btree_map(items.begin(), items.end()) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename InputIt>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map(InputIt first, InputIt last)
+    : btree_map() {
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map(const btree_map &m)
+    : map_(m.map_) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::btree_map(btree_map &&m) noexcept
+    : map_(std::move(m.map_)) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc>::~btree_map() {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc> &
+btree_map<K, T, Compare, Extract, Alloc>::operator=(const btree_map &m) {
+  map_ = m.map_;
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+btree_map<K, T, Compare, Extract, Alloc> &
+btree_map<K, T, Compare, Extract, Alloc>::operator=(btree_map &&m) noexcept {
+  map_ = std::move(m.map_);
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+T &btree_map<K, T, Compare, Extract, Alloc>::at(const key_type &k) const {
+  iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("btree_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename Key, typename C, typename>
+T &btree_map<K, T, Compare, Extract, Alloc>::at(const Key &k) const {
+  iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("btree_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+T &btree_map<K, T, Compare, Extract, Alloc>::operator[](const key_type &k) {
+  return try_emplace(k).first->second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+T &btree_map<K, T, Compare, Extract, Alloc>::operator[](key_type &&k) {
+  return try_emplace(std::move(k)).first->second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::begin() noexcept {
+  return map_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::begin() const noexcept {
+  return map_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::cbegin() const noexcept {
+  return map_.cbegin();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::end() noexcept {
+  return map_.end();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::end() const noexcept {
+  return map_.end();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::cend() const noexcept {
+  return map_.cend();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool btree_map<K, T, Compare, Extract, Alloc>::empty() const noexcept {
+  return map_.empty();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::size_type
+btree_map<K, T, Compare, Extract, Alloc>::size() const noexcept {
+  return map_.size();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::size_type
+btree_map<K, T, Compare, Extract, Alloc>::max_size() const {
+  return map_.max_size();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::allocator_type
+btree_map<K, T, Compare, Extract, Alloc>::get_allocator() const noexcept {
+  return map_.get_allocator();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+void btree_map<K, T, Compare, Extract, Alloc>::clear() {
+  map_.clear();
+}
+
+/*Sorted input is appended leaf by leaf*/
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename InputIt>
+void btree_map<K, T, Compare, Extract, Alloc>::assign_sorted(InputIt first,
+                                                             InputIt last) {
+  map_.clear();
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::insert(const value_type &value) {
+  return map_.insert_unique(value);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::insert(value_type &&value) {
+  return map_.insert_unique(std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::insert(const_iterator hint,
+                                                 const value_type &value) {
+  return map_.insert_hint_unique(hint, value);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::insert(const_iterator hint,
+                                                 value_type &&value) {
+  return map_.insert_hint_unique(hint, std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::insert(const key_type &key,
+                                                 const mapped_value &obj) {
+  iterator inserter = map_.search(key);
+
+  if (inserter == end()) {
+    return std::pair<iterator, bool>(inserter, false);
+  }
+
+  inserter->second = obj;
+  return std::pair<iterator, bool>(inserter, true);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::insert_or_assign(
+    const key_type &key, const mapped_value &obj) {
+  std::pair<iterator, bool> creep = try_emplace(key, obj);
+
+  if (creep.second) {
+    return creep;
+  }
+
+  creep.first->second = obj;
+  return creep;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename... Args>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::emplace(Args &&...args) {
+  return map_.emplace_unique(std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename... Args>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::emplace_hint(const_iterator hint,
+                                                       Args &&...args) {
+  return map_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+}
+
+/*The mapped value is only built when the key is missing*/
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename... Args>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::try_emplace(const key_type &key,
+                                                      Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename... Args>
+std::pair<typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>
+btree_map<K, T, Compare, Extract, Alloc>::try_emplace(key_type &&key,
+                                                      Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::erase(iterator pos) {
+  return map_.erase(pos);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+void btree_map<K, T, Compare, Extract, Alloc>::swap(btree_map &other) {
+  map_.swap(other.map_);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+void btree_map<K, T, Compare, Extract, Alloc>::merge(btree_map &other) {
+  map_.merge_unique(other.map_);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::find(const key_type &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::find(const key_type &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename Key, typename C, typename>
+typename btree_map<K, T, Compare, Extract, Alloc>::iterator
+btree_map<K, T, Compare, Extract, Alloc>::find(const Key &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename Key, typename C, typename>
+typename btree_map<K, T, Compare, Extract, Alloc>::const_iterator
+btree_map<K, T, Compare, Extract, Alloc>::find(const Key &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool btree_map<K, T, Compare, Extract, Alloc>::contains(
+    const key_type &key) const noexcept {
+  return map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename Key, typename C, typename>
+bool btree_map<K, T, Compare, Extract, Alloc>::contains(
+    const Key &key) const noexcept {
+  return map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename btree_map<K, T, Compare, Extract, Alloc>::size_type
+btree_map<K, T, Compare, Extract, Alloc>::count(const key_type &key) const {
+  return map_.count(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename Key, typename C, typename>
+typename btree_map<K, T, Compare, Extract, Alloc>::size_type
+btree_map<K, T, Compare, Extract, Alloc>::count(const Key &key) const {
+  return map_.count(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename... Args>
+s21::vector<std::pair<
+    typename btree_map<K, T, Compare, Extract, Alloc>::iterator, bool>>
+btree_map<K, T, Compare, Extract, Alloc>::insert_many(Args &&...args) {
+  s21::vector<std::pair<iterator, bool>> res;
+
+  (res.push_back(insert(std::forward<Args>(args))), ...);
+
+  return res;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator>(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+               const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator>=(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+                const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator<(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+               const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator<=(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+                const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator==(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+                const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator!=(const btree_map<K, T, Compare, Extract, Alloc> &lhs,
+                const btree_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef CPP_S21_CONTAINERS_BTREE_MULTISET_S21_BTREE_MULTISET_H
+#define CPP_S21_CONTAINERS_BTREE_MULTISET_S21_BTREE_MULTISET_H
+
+#include <initializer_list>
+
+#include "../btree/s21_btree.h"
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*Drop-in alternative to s21::multiset backed by a B-tree. Any insert or
+  erase may invalidate iterators*/
+template <typename T, class Extract = s21::KeyExtract<T, T>,
+          class Compare = s21::Compare<T, T>,
+          class Alloc = s21::pool_allocator<T>>
+class btree_multiset {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+  using Container = BTree<T, T, Compare, Extract, Alloc>;
+
+  btree_multiset() : multiset_() {}
+  explicit btree_multiset(const allocator_type &alloc) : multiset_(alloc) {}
+  btree_multiset(std::initializer_list<value_type> const &items)
+      : btree_multiset(items.begin(), items.end()) {}
+  template <typename InputIt>
+  btree_multiset(InputIt first, InputIt last) : multiset_() {
+    multiset_.insert_equal(first, last);
+  }
+  btree_multiset(const btree_multiset &s) : multiset_(s.multiset_) {}
+  btree_multiset(btree_multiset &&s) noexcept
+      : multiset_(std::move(s.multiset_)) {}
+  ~btree_multiset() {}
+
+  btree_multiset &operator=(const btree_multiset &other) {
+    if (this != &other) {
+      multiset_ = other.multiset_;
+    }
+    return *this;
+  }
+  btree_multiset &operator=(btree_multiset &&s) noexcept {
+    if (this != &s) {
+      multiset_ = std::move(s.multiset_);
+    }
+    return *this;
+  }
+
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  iterator begin() { return multiset_.begin(); }
+  const_iterator begin() const noexcept { return multiset_.begin(); }
+  iterator end() { return multiset_.end(); }
+  const_iterator end() const noexcept { return multiset_.end(); }
+
+  const_iterator cbegin() const noexcept { return multiset_.cbegin(); }
+  const_iterator cend() const noexcept { return multiset_.cend(); }
+
+  bool empty() const noexcept { return multiset_.empty(); }
+  size_type size() const noexcept { return multiset_.size(); }
+  size_type max_size() const { return multiset_.max_size(); }
+  allocator_type get_allocator() const noexcept {
+    return multiset_.get_allocator();
+  }
+
+  void clear() { multiset_.clear(); }
+  /*Sorted input is appended leaf by leaf*/
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    multiset_.clear();
+    multiset_.insert_equal(first, last);
+  }
+  iterator insert(const value_type &value) {
+    return multiset_.insert_equal(value);
+  }
+  iterator insert(value_type &&value) {
+    return multiset_.insert_equal(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return multiset_.insert_hint_equal(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return multiset_.insert_hint_equal(hint, std::move(value));
+  }
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return multiset_.emplace_equal(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return multiset_.emplace_hint_equal(hint, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> results;
+    (results.push_back(std::make_pair(insert(std::forward<Args>(args)), true)),
+     ...);
+    return results;
+  }
+
+  iterator erase(iterator pos) { return multiset_.erase(pos); }
+  void swap(btree_multiset &other) { multiset_.swap(other.multiset_); }
+  void merge(btree_multiset &other) { multiset_.merge_equal(other.multiset_); }
+
+  iterator find(const T &key) const { return multiset_.search(key); }
+  bool contains(const T &key) const { return multiset_.contains(key); }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key) const {
+    return multiset_.search(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const {
+    return multiset_.contains(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const Key &key) const {
+    return multiset_.count(key);
+  }
+
+  size_type count(const T &key) const { return multiset_.count(key); }
+  std::pair<iterator, iterator> equal_range(const T &key) {
+    return multiset_.equal_range(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(const T &key) const {
+    return multiset_.equal_range(key);
+  }
+  iterator lower_bound(const T &key) { return multiset_.lower_bound(key); }
+  const_iterator lower_bound(const T &key) const {
+    return multiset_.lower_bound(key);
+  }
+  iterator upper_bound(const T &key) { return multiset_.upper_bound(key); }
+  const_iterator upper_bound(const T &key) const {
+    return multiset_.upper_bound(key);
+  }
+
+ private:
+  Container multiset_;
+};
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator>(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+               const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator>=(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+                const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator<(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+               const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator<=(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+                const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator==(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+                const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator!=(const btree_multiset<T, Extract, Compare, Alloc> &lhs,
+                const btree_multiset<T, Extract, Compare, Alloc> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
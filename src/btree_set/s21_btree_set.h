@@ -0,0 +1,172 @@
+#ifndef CPP_S21_CONTAINERS_BTREE_SET_S21_BTREE_SET_H
+#define CPP_S21_CONTAINERS_BTREE_SET_S21_BTREE_SET_H
+
+#include <initializer_list>
+
+#include "../btree/s21_btree.h"
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*Drop-in alternative to s21::set backed by a B-tree. Any insert or erase
+  may invalidate iterators*/
+template <typename T, class Extract = s21::KeyExtract<T, T>,
+          class Compare = s21::Compare<T, T>,
+          class Alloc = s21::pool_allocator<T>>
+class btree_set {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+  using Container = BTree<T, T, Compare, Extract, Alloc>;
+
+  btree_set() : set_() {}
+  explicit btree_set(const allocator_type &alloc) : set_(alloc) {}
+  btree_set(std::initializer_list<value_type> const &items)
+      : btree_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  btree_set(InputIt first, InputIt last) : set_() {
+    set_.insert_unique(first, last);
+  }
+  btree_set(const btree_set &s) : set_(s.set_) {}
+  btree_set(btree_set &&s) noexcept : set_(std::move(s.set_)) {}
+  ~btree_set() {}
+
+  btree_set &operator=(const btree_set &other) {
+    if (this != &other) {
+      set_ = other.set_;
+    }
+    return *this;
+  }
+  btree_set &operator=(btree_set &&s) noexcept {
+    if (this != &s) {
+      set_ = std::move(s.set_);
+    }
+    return *this;
+  }
+
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  iterator begin() { return set_.begin(); }
+  const_iterator begin() const noexcept { return set_.begin(); }
+  iterator end() { return set_.end(); }
+  const_iterator end() const noexcept { return set_.end(); }
+
+  const_iterator cbegin() const noexcept { return set_.cbegin(); }
+  const_iterator cend() const noexcept { return set_.cend(); }
+
+  bool empty() const noexcept { return set_.empty(); }
+  size_type size() const noexcept { return set_.size(); }
+  size_type max_size() const { return set_.max_size(); }
+  allocator_type get_allocator() const noexcept {
+    return set_.get_allocator();
+  }
+
+  void clear() { set_.clear(); }
+  /*Sorted input is appended leaf by leaf*/
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    set_.clear();
+    set_.insert_unique(first, last);
+  }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return set_.insert_unique(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return set_.insert_unique(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return set_.insert_hint_unique(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return set_.insert_hint_unique(hint, std::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return set_.emplace_unique(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return set_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> results;
+    (results.push_back(insert(std::forward<Args>(args))), ...);
+    return results;
+  }
+
+  iterator erase(iterator pos) { return set_.erase(pos); }
+  void swap(btree_set &other) { set_.swap(other.set_); }
+  void merge(btree_set &other) { set_.merge_unique(other.set_); }
+
+  iterator find(const T &key) const { return set_.search(key); }
+  bool contains(const T &key) const { return set_.contains(key); }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key) const {
+    return set_.search(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const {
+    return set_.contains(key);
+  }
+
+  iterator lower_bound(const T &key) { return set_.lower_bound(key); }
+  const_iterator lower_bound(const T &key) const {
+    return set_.lower_bound(key);
+  }
+  iterator upper_bound(const T &key) { return set_.upper_bound(key); }
+  const_iterator upper_bound(const T &key) const {
+    return set_.upper_bound(key);
+  }
+
+ private:
+  Container set_;
+};
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator>(const btree_set<T, Extract, Compare, Alloc> &lhs,
+               const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator>=(const btree_set<T, Extract, Compare, Alloc> &lhs,
+                const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator<(const btree_set<T, Extract, Compare, Alloc> &lhs,
+               const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator<=(const btree_set<T, Extract, Compare, Alloc> &lhs,
+                const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator==(const btree_set<T, Extract, Compare, Alloc> &lhs,
+                const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator!=(const btree_set<T, Extract, Compare, Alloc> &lhs,
+                const btree_set<T, Extract, Compare, Alloc> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
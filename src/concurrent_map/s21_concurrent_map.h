@@ -0,0 +1,527 @@
+#ifndef CPP_S21_CONTAINERS_CONCURRENT_MAP_S21_CONCURRENT_MAP_H
+#define CPP_S21_CONTAINERS_CONCURRENT_MAP_S21_CONCURRENT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../helper/helper.h"
+#include "../map/s21_map.h"
+
+namespace s21 {
+/*Map that many threads can use at once. Keys are spread over shards by
+  hash, and every shard is an s21::map behind its own reader-writer lock,
+  so threads only wait for each other when they touch the same shard and
+  one of them writes. Batch calls sort their items by shard first and take
+  each shard's lock once for all the items that land in it.
+
+  Each shard has its own pool, which only the thread holding its lock uses.
+  Values are handed out by copy or to a callback run under the lock, never
+  by reference, since another thread may erase them right after. Whole-map
+  calls (size, for_each) visit shards one after another and may see writes
+  that land in between; snapshot locks every shard at once*/
+template <typename K, typename T, class Compare = s21::Compare<K, T>,
+          class Extract = s21::KeyExtract<K, T>, class Hash = std::hash<K>,
+          class Alloc = s21::pool_allocator<std::pair<K, T>>>
+class concurrent_map {
+ public:
+  using key_type = K;
+  using mapped_value = T;
+  using value_type = std::pair<K, T>;
+  using size_type = size_t;
+  using hasher = Hash;
+  using allocator_type = Alloc;
+  using Container = s21::map<K, T, Compare, Extract, false, Alloc>;
+
+  static constexpr size_type kDefaultShards = 64;
+
+  explicit concurrent_map(size_type shards = kDefaultShards);
+  concurrent_map(std::initializer_list<value_type> const &items);
+  concurrent_map(const concurrent_map &other) = delete;
+  concurrent_map &operator=(const concurrent_map &other) = delete;
+  ~concurrent_map();
+
+  size_type shard_count() const noexcept;
+  bool empty() const;
+  size_type size() const;
+  void clear();
+
+  bool insert(const value_type &value);
+  bool insert(value_type &&value);
+  bool insert_or_assign(const key_type &key, const mapped_value &obj);
+  template <typename... Args>
+  bool try_emplace(const key_type &key, Args &&...args);
+  template <typename F>
+  bool upsert(const key_type &key, const mapped_value &obj, F &&f);
+  template <typename F>
+  bool update(const key_type &key, F &&f);
+  size_type erase(const key_type &key);
+
+  T at(const key_type &key) const;
+  template <typename F>
+  bool visit(const key_type &key, F &&f) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+
+  template <typename ForwardIt>
+  size_type insert(ForwardIt first, ForwardIt last);
+  template <typename ForwardIt>
+  size_type insert_or_assign(ForwardIt first, ForwardIt last);
+  template <typename ForwardIt>
+  size_type erase(ForwardIt first, ForwardIt last);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+
+  template <typename F>
+  void for_each(F &&f) const;
+  Container snapshot() const;
+
+ private:
+  /*A shard per cache line, so taking one lock does not bounce its
+    neighbours' lines between cores*/
+  static constexpr size_type kCacheLine = 64;
+
+  struct alignas(kCacheLine) Shard {
+    mutable std::shared_mutex lock_;
+    Container map_;
+  };
+
+  using read_lock = std::shared_lock<std::shared_mutex>;
+  using write_lock = std::unique_lock<std::shared_mutex>;
+
+  size_type shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+  Hash hash_;
+  Compare comp_;
+  Extract extracter_;
+
+  /*An item of a batch and its position in the batch*/
+  template <typename ForwardIt>
+  using Entry = std::pair<ForwardIt, size_type>;
+
+  size_type ShardOf(const key_type &key) const;
+  template <typename ForwardIt, typename F>
+  void ForEachRun(ForwardIt first, ForwardIt last, F &&visit) const;
+};
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::concurrent_map(
+    size_type shards)
+    : shard_count_(shards > 0 ? shards : 1),
+      shards_(new Shard[shard_count_]),
+      hash_(),
+      comp_(),
+      extracter_() {}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::concurrent_map(
+    std::initializer_list<value_type> const &items)
+    : concurrent_map() {
+  insert(items.begin(), items.end());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::~concurrent_map() {}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::shard_count()
+    const noexcept {
+  return shard_count_;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::empty() const {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    read_lock lock(shards_[i].lock_);
+
+    if (!shards_[i].map_.empty()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size() const {
+  size_type total = 0;
+
+  for (size_type i = 0; i < shard_count_; ++i) {
+    read_lock lock(shards_[i].lock_);
+    total += shards_[i].map_.size();
+  }
+
+  return total;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+void concurrent_map<K, T, Compare, Extract, Hash, Alloc>::clear() {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    write_lock lock(shards_[i].lock_);
+    shards_[i].map_.clear();
+  }
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::insert(
+    const value_type &value) {
+  Shard &shard = shards_[ShardOf(value.first)];
+  write_lock lock(shard.lock_);
+
+  return shard.map_.insert(value).second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::insert(
+    value_type &&value) {
+  Shard &shard = shards_[ShardOf(value.first)];
+  write_lock lock(shard.lock_);
+
+  return shard.map_.insert(std::move(value)).second;
+}
+
+/*Returns true when the key was added and false when its value was replaced*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::insert_or_assign(
+    const key_type &key, const mapped_value &obj) {
+  Shard &shard = shards_[ShardOf(key)];
+  write_lock lock(shard.lock_);
+
+  return shard.map_.insert_or_assign(key, obj).second;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename... Args>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::try_emplace(
+    const key_type &key, Args &&...args) {
+  Shard &shard = shards_[ShardOf(key)];
+  write_lock lock(shard.lock_);
+
+  return shard.map_.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+/*Adds obj under key, or calls f on the value already there, in one hold of
+  the lock; counting into the map from many threads needs nothing else*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename F>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::upsert(
+    const key_type &key, const mapped_value &obj, F &&f) {
+  Shard &shard = shards_[ShardOf(key)];
+  write_lock lock(shard.lock_);
+  auto placed = shard.map_.try_emplace(key, obj);
+
+  if (!placed.second) {
+    f(placed.first->second);
+  }
+
+  return placed.second;
+}
+
+/*Calls f on the value under key while holding the lock; false if there is
+  no such key*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename F>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::update(
+    const key_type &key, F &&f) {
+  Shard &shard = shards_[ShardOf(key)];
+  write_lock lock(shard.lock_);
+  auto found = shard.map_.find(key);
+
+  if (found == shard.map_.end()) {
+    return false;
+  }
+
+  f(found->second);
+  return true;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::erase(
+    const key_type &key) {
+  Shard &shard = shards_[ShardOf(key)];
+  write_lock lock(shard.lock_);
+
+  return shard.map_.erase(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+T concurrent_map<K, T, Compare, Extract, Hash, Alloc>::at(
+    const key_type &key) const {
+  const Shard &shard = shards_[ShardOf(key)];
+  read_lock lock(shard.lock_);
+  auto found = shard.map_.find(key);
+
+  if (found == shard.map_.end()) {
+    throw std::out_of_range("concurrent_map::at: key not found");
+  }
+
+  return found->second;
+}
+
+/*Calls f on the value under key with the shard locked for reading, which
+  saves copying the value out*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename F>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::visit(
+    const key_type &key, F &&f) const {
+  const Shard &shard = shards_[ShardOf(key)];
+  read_lock lock(shard.lock_);
+  auto found = shard.map_.find(key);
+
+  if (found == shard.map_.end()) {
+    return false;
+  }
+
+  f(static_cast<const T &>(found->second));
+  return true;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+bool concurrent_map<K, T, Compare, Extract, Hash, Alloc>::contains(
+    const key_type &key) const {
+  const Shard &shard = shards_[ShardOf(key)];
+  read_lock lock(shard.lock_);
+
+  return shard.map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::count(
+    const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/*Returns how many of the values were added*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename ForwardIt>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::insert(ForwardIt first,
+                                                            ForwardIt last) {
+  size_type added = 0;
+
+  ForEachRun(first, last,
+             [&](Shard &shard, const Entry<ForwardIt> *from,
+                 const Entry<ForwardIt> *to) {
+               write_lock lock(shard.lock_);
+
+               for (; from != to; ++from) {
+                 if (shard.map_.insert(*from->first).second) {
+                   ++added;
+                 }
+               }
+             });
+
+  return added;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename ForwardIt>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::insert_or_assign(
+    ForwardIt first, ForwardIt last) {
+  size_type added = 0;
+
+  ForEachRun(first, last,
+             [&](Shard &shard, const Entry<ForwardIt> *from,
+                 const Entry<ForwardIt> *to) {
+               write_lock lock(shard.lock_);
+
+               for (; from != to; ++from) {
+                 const value_type &value = *from->first;
+
+                 if (shard.map_.insert_or_assign(value.first, value.second)
+                         .second) {
+                   ++added;
+                 }
+               }
+             });
+
+  return added;
+}
+
+/*Takes keys; returns how many were there to erase*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename ForwardIt>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::erase(ForwardIt first,
+                                                           ForwardIt last) {
+  size_type erased = 0;
+
+  ForEachRun(first, last,
+             [&](Shard &shard, const Entry<ForwardIt> *from,
+                 const Entry<ForwardIt> *to) {
+               write_lock lock(shard.lock_);
+
+               for (; from != to; ++from) {
+                 erased += shard.map_.erase(*from->first);
+               }
+             });
+
+  return erased;
+}
+
+/*Writes one bool per key, in the order of the keys*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename ForwardIt, typename OutputIt>
+OutputIt concurrent_map<K, T, Compare, Extract, Hash, Alloc>::contains_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  std::vector<char> found(std::distance(first, last), 0);
+
+  ForEachRun(first, last,
+             [&](const Shard &shard, const Entry<ForwardIt> *from,
+                 const Entry<ForwardIt> *to) {
+               read_lock lock(shard.lock_);
+
+               for (; from != to; ++from) {
+                 found[from->second] = shard.map_.contains(*from->first);
+               }
+             });
+
+  for (char hit : found) {
+    *out++ = hit != 0;
+  }
+
+  return out;
+}
+
+/*Calls f on every value, shard by shard, each shard locked for reading
+  while it is walked. Values come in key order within a shard only*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename F>
+void concurrent_map<K, T, Compare, Extract, Hash, Alloc>::for_each(
+    F &&f) const {
+  for (size_type i = 0; i < shard_count_; ++i) {
+    read_lock lock(shards_[i].lock_);
+
+    for (const auto &value : shards_[i].map_) {
+      f(value);
+    }
+  }
+}
+
+/*An ordinary map of everything in the map at one moment. Every shard is
+  locked for reading, always in the same order so that two snapshots
+  cannot deadlock, and the shards are merged in key order*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::Container
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::snapshot() const {
+  std::vector<read_lock> locks;
+  locks.reserve(shard_count_);
+  size_type total = 0;
+
+  for (size_type i = 0; i < shard_count_; ++i) {
+    locks.emplace_back(shards_[i].lock_);
+    total += shards_[i].map_.size();
+  }
+
+  std::vector<value_type> values;
+  values.reserve(total);
+
+  for (size_type i = 0; i < shard_count_; ++i) {
+    for (const auto &value : shards_[i].map_) {
+      values.push_back(value);
+    }
+  }
+
+  locks.clear();
+  std::sort(values.begin(), values.end(),
+            [this](const value_type &lhs, const value_type &rhs) {
+              return comp_(extracter_(lhs), extracter_(rhs));
+            });
+
+  Container merged;
+  merged.assign_sorted(values.begin(), values.end());
+
+  return merged;
+}
+
+/*std::hash leaves integers as they are, which would put keys that share a
+  stride with the shard count in one shard; a 64-bit finalizer mixes every
+  bit of the hash into the low ones first*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+typename concurrent_map<K, T, Compare, Extract, Hash, Alloc>::size_type
+concurrent_map<K, T, Compare, Extract, Hash, Alloc>::ShardOf(
+    const key_type &key) const {
+  std::uint64_t h = static_cast<std::uint64_t>(hash_(key));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+
+  return static_cast<size_type>(h % shard_count_);
+}
+
+/*Orders the items by shard with a counting sort and calls visit once per
+  shard that got any, with the run of its entries*/
+template <typename K, typename T, class Compare, class Extract, class Hash,
+          class Alloc>
+template <typename ForwardIt, typename F>
+void concurrent_map<K, T, Compare, Extract, Hash, Alloc>::ForEachRun(
+    ForwardIt first, ForwardIt last, F &&visit) const {
+  std::vector<size_type> shard_of;
+  std::vector<size_type> start(shard_count_ + 1, 0);
+
+  for (ForwardIt it = first; it != last; ++it) {
+    shard_of.push_back(ShardOf(extracter_(*it)));
+    ++start[shard_of.back() + 1];
+  }
+
+  for (size_type i = 0; i < shard_count_; ++i) {
+    start[i + 1] += start[i];
+  }
+
+  std::vector<Entry<ForwardIt>> order(shard_of.size());
+  std::vector<size_type> next(start.begin(), start.end() - 1);
+  size_type pos = 0;
+
+  for (ForwardIt it = first; it != last; ++it, ++pos) {
+    order[next[shard_of[pos]]++] = Entry<ForwardIt>(it, pos);
+  }
+
+  for (size_type i = 0; i < shard_count_; ++i) {
+    if (start[i] != start[i + 1]) {
+      visit(shards_[i], order.data() + start[i], order.data() + start[i + 1]);
+    }
+  }
+}
+
+}  // namespace s21
+
+#endif
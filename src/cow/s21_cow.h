@@ -0,0 +1,145 @@
+#ifndef CPP_S21_CONTAINERS_COW_S21_COW_H
+#define CPP_S21_CONTAINERS_COW_S21_COW_H
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+/*Copy-on-write handle around a container. Copies of a handle share one
+  container and cost O(1) whatever its size, but writes to a shared
+  container are not cheap: nodes are never shared between containers, since
+  RBTree nodes carry parent and in-order links into their own tree, so the
+  first write() after a copy deep-copies the whole container, O(n) for n
+  values. Only writes through a handle nobody shares cost what they cost on
+  the container itself. Where every snapshot is followed by a write,
+  persistent_map and persistent_set are the better fit: they copy just the
+  O(log n) path to the change. A default or moved-from handle holds nothing
+  and reads as empty*/
+template <class Container>
+class cow {
+ public:
+  using container_type = Container;
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using const_iterator = typename Container::const_iterator;
+
+  cow() noexcept = default;
+  cow(std::initializer_list<value_type> const &items);
+  explicit cow(const Container &container);
+  explicit cow(Container &&container);
+  cow(const cow &other) noexcept = default;
+  cow(cow &&other) noexcept = default;
+  ~cow() = default;
+
+  cow &operator=(const cow &other) noexcept = default;
+  cow &operator=(cow &&other) noexcept = default;
+
+  const Container &read() const noexcept;
+  const Container &operator*() const noexcept;
+  const Container *operator->() const noexcept;
+  Container &write();
+
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+
+  bool shared() const noexcept;
+  void swap(cow &other) noexcept;
+
+ private:
+  std::shared_ptr<Container> body_;
+
+  static const Container &Empty() noexcept;
+};
+
+template <class Container>
+cow<Container>::cow(std::initializer_list<value_type> const &items)
+    : body_(std::make_shared<Container>(items)) {}
+
+template <class Container>
+cow<Container>::cow(const Container &container)
+    : body_(std::make_shared<Container>(container)) {}
+
+template <class Container>
+cow<Container>::cow(Container &&container)
+    : body_(std::make_shared<Container>(std::move(container))) {}
+
+template <class Container>
+const Container &cow<Container>::read() const noexcept {
+  return body_ ? *body_ : Empty();
+}
+
+template <class Container>
+const Container &cow<Container>::operator*() const noexcept {
+  return read();
+}
+
+template <class Container>
+const Container *cow<Container>::operator->() const noexcept {
+  return &read();
+}
+
+/*O(n) while another handle shares the container, which is copied then,
+  and O(1) otherwise. The reference stays good until the handle is copied,
+  after which changes have to go through write() again. Once no other
+  handle is left only this one can make new ones, so the count cannot grow
+  back behind our back; the fence pairs with the release of the handles
+  dropped meanwhile*/
+template <class Container>
+Container &cow<Container>::write() {
+  if (!body_) {
+    body_ = std::make_shared<Container>();
+
+  } else if (body_.use_count() > 1) {
+    body_ = std::make_shared<Container>(*body_);
+
+  } else {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+  return *body_;
+}
+
+template <class Container>
+typename cow<Container>::const_iterator cow<Container>::begin()
+    const noexcept {
+  return read().begin();
+}
+
+template <class Container>
+typename cow<Container>::const_iterator cow<Container>::end() const noexcept {
+  return read().end();
+}
+
+template <class Container>
+bool cow<Container>::empty() const noexcept {
+  return read().empty();
+}
+
+template <class Container>
+typename cow<Container>::size_type cow<Container>::size() const noexcept {
+  return read().size();
+}
+
+template <class Container>
+bool cow<Container>::shared() const noexcept {
+  return body_.use_count() > 1;
+}
+
+template <class Container>
+void cow<Container>::swap(cow &other) noexcept {
+  body_.swap(other.body_);
+}
+
+template <class Container>
+const Container &cow<Container>::Empty() noexcept {
+  static const Container empty;
+  return empty;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,538 @@
+#ifndef CPP_S21_CONTAINERS_FLAT_MAP_S21_FLAT_MAP_H
+#define CPP_S21_CONTAINERS_FLAT_MAP_S21_FLAT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../flat_tree/s21_flat_tree.h"
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*s21::map over one sorted s21::vector: no per-element node, lookups walk
+  contiguous memory and iterators are plain pointers. Inserts and erases
+  cost O(n) moves and invalidate iterators, so it suits tables that are
+  built once, or in bulk, and mostly read*/
+template <typename K, typename T, class Compare = s21::Compare<K, T>,
+          class Extract = s21::KeyExtract<K, T>>
+class flat_map {
+ public:
+  using key_type = K;
+  using mapped_value = T;
+  using value_type = std::pair<K, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using Container = s21::FlatTree<K, std::pair<K, T>, Compare, Extract>;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  flat_map();
+  flat_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last);
+  flat_map(const flat_map &m);
+  flat_map(flat_map &&m) noexcept;
+  ~flat_map();
+
+  flat_map &operator=(const flat_map &m);
+  flat_map &operator=(flat_map &&m) noexcept;
+
+  T &at(const key_type &k);
+  const T &at(const key_type &k) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  T &at(const Key &k);
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const T &at(const Key &k) const;
+  T &operator[](const key_type &k);
+  T &operator[](key_type &&k);
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const;
+  size_type capacity() const noexcept;
+  void reserve(size_type n);
+  void shrink_to_fit();
+
+  void clear();
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_value &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_value &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  iterator erase(iterator pos);
+  void swap(flat_map &other);
+  void merge(flat_map &other);
+
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key);
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key &key) const;
+  bool contains(const key_type &key) const noexcept;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const noexcept;
+  size_type count(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const Key &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+
+  template <typename... Args>
+  s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+ private:
+  Container map_;
+};
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract>::flat_map() : map_() {}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract>::flat_map(
+    std::initializer_list<value_type> const &items)
+    : flat_map(items.begin(), items.end()) {}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename InputIt>
+flat_map<K, T, Compare, Extract>::flat_map(InputIt first, InputIt last)
+    : flat_map() {
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract>::flat_map(const flat_map &m)
+    : map_(m.map_) {}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract>::flat_map(flat_map &&m) noexcept
+    : map_(std::move(m.map_)) {}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract>::~flat_map() {}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract> &
+flat_map<K, T, Compare, Extract>::operator=(const flat_map &m) {
+  map_ = m.map_;
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+flat_map<K, T, Compare, Extract> &
+flat_map<K, T, Compare, Extract>::operator=(flat_map &&m) noexcept {
+  map_ = std::move(m.map_);
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+T &flat_map<K, T, Compare, Extract>::at(const key_type &k) {
+  iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("flat_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+const T &flat_map<K, T, Compare, Extract>::at(const key_type &k) const {
+  const_iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("flat_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+T &flat_map<K, T, Compare, Extract>::at(const Key &k) {
+  iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("flat_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+const T &flat_map<K, T, Compare, Extract>::at(const Key &k) const {
+  const_iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("flat_map::at: key not found");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+T &flat_map<K, T, Compare, Extract>::operator[](const key_type &k) {
+  return try_emplace(k).first->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+T &flat_map<K, T, Compare, Extract>::operator[](key_type &&k) {
+  return try_emplace(std::move(k)).first->second;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::begin() noexcept {
+  return map_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::begin() const noexcept {
+  return map_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::cbegin() const noexcept {
+  return map_.cbegin();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::end() noexcept {
+  return map_.end();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::end() const noexcept {
+  return map_.end();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::cend() const noexcept {
+  return map_.cend();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool flat_map<K, T, Compare, Extract>::empty() const noexcept {
+  return map_.empty();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::size_type
+flat_map<K, T, Compare, Extract>::size() const noexcept {
+  return map_.size();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::size_type
+flat_map<K, T, Compare, Extract>::max_size() const {
+  return map_.max_size();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::size_type
+flat_map<K, T, Compare, Extract>::capacity() const noexcept {
+  return map_.capacity();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+void flat_map<K, T, Compare, Extract>::reserve(size_type n) {
+  map_.reserve(n);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+void flat_map<K, T, Compare, Extract>::shrink_to_fit() {
+  map_.shrink_to_fit();
+}
+
+template <typename K, typename T, class Compare, class Extract>
+void flat_map<K, T, Compare, Extract>::clear() {
+  map_.clear();
+}
+
+/*Sorted input skips the sort and only pays the duplicate check*/
+template <typename K, typename T, class Compare, class Extract>
+template <typename InputIt>
+void flat_map<K, T, Compare, Extract>::assign_sorted(InputIt first,
+                                                     InputIt last) {
+  map_.clear();
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::insert(const value_type &value) {
+  return map_.insert_unique(value);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::insert(value_type &&value) {
+  return map_.insert_unique(std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::insert(const_iterator hint,
+                                         const value_type &value) {
+  return map_.insert_hint_unique(hint, value);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::insert(const_iterator hint,
+                                         value_type &&value) {
+  return map_.insert_hint_unique(hint, std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename InputIt>
+void flat_map<K, T, Compare, Extract>::insert(InputIt first, InputIt last) {
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::insert(const key_type &key,
+                                         const mapped_value &obj) {
+  iterator inserter = map_.search(key);
+
+  if (inserter == end()) {
+    return std::pair<iterator, bool>(inserter, false);
+  }
+
+  inserter->second = obj;
+  return std::pair<iterator, bool>(inserter, true);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::insert_or_assign(
+    const key_type &key, const mapped_value &obj) {
+  std::pair<iterator, bool> creep = try_emplace(key, obj);
+
+  if (creep.second) {
+    return creep;
+  }
+
+  creep.first->second = obj;
+  return creep;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename... Args>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::emplace(Args &&...args) {
+  return map_.emplace_unique(std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename... Args>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::emplace_hint(const_iterator hint,
+                                               Args &&...args) {
+  return map_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+}
+
+/*The mapped value is only built when the key is missing*/
+template <typename K, typename T, class Compare, class Extract>
+template <typename... Args>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::try_emplace(const key_type &key,
+                                              Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename... Args>
+std::pair<typename flat_map<K, T, Compare, Extract>::iterator, bool>
+flat_map<K, T, Compare, Extract>::try_emplace(key_type &&key, Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::erase(iterator pos) {
+  return map_.erase(pos);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+void flat_map<K, T, Compare, Extract>::swap(flat_map &other) {
+  map_.swap(other.map_);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+void flat_map<K, T, Compare, Extract>::merge(flat_map &other) {
+  map_.merge_unique(other.map_);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::find(const key_type &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::find(const key_type &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::find(const Key &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::find(const Key &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool flat_map<K, T, Compare, Extract>::contains(
+    const key_type &key) const noexcept {
+  return map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+bool flat_map<K, T, Compare, Extract>::contains(
+    const Key &key) const noexcept {
+  return map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::size_type
+flat_map<K, T, Compare, Extract>::count(const key_type &key) const {
+  return map_.contains(key) ? 1 : 0;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename Key, typename C, typename>
+typename flat_map<K, T, Compare, Extract>::size_type
+flat_map<K, T, Compare, Extract>::count(const Key &key) const {
+  return map_.contains(key) ? 1 : 0;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::lower_bound(const key_type &key) {
+  return map_.lower_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::lower_bound(const key_type &key) const {
+  return map_.lower_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::iterator
+flat_map<K, T, Compare, Extract>::upper_bound(const key_type &key) {
+  return map_.upper_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+typename flat_map<K, T, Compare, Extract>::const_iterator
+flat_map<K, T, Compare, Extract>::upper_bound(const key_type &key) const {
+  return map_.upper_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+template <typename... Args>
+s21::vector<std::pair<
+    typename flat_map<K, T, Compare, Extract>::iterator, bool>>
+flat_map<K, T, Compare, Extract>::insert_many(Args &&...args) {
+  s21::vector<std::pair<iterator, bool>> res;
+
+  (res.push_back(insert(std::forward<Args>(args))), ...);
+
+  return res;
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator>(const flat_map<K, T, Compare, Extract> &lhs,
+               const flat_map<K, T, Compare, Extract> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator>=(const flat_map<K, T, Compare, Extract> &lhs,
+                const flat_map<K, T, Compare, Extract> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator<(const flat_map<K, T, Compare, Extract> &lhs,
+               const flat_map<K, T, Compare, Extract> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator<=(const flat_map<K, T, Compare, Extract> &lhs,
+                const flat_map<K, T, Compare, Extract> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator==(const flat_map<K, T, Compare, Extract> &lhs,
+                const flat_map<K, T, Compare, Extract> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename K, typename T, class Compare, class Extract>
+bool operator!=(const flat_map<K, T, Compare, Extract> &lhs,
+                const flat_map<K, T, Compare, Extract> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
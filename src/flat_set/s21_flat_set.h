@@ -0,0 +1,165 @@
+#ifndef CPP_S21_CONTAINERS_FLAT_SET_S21_FLAT_SET_H
+#define CPP_S21_CONTAINERS_FLAT_SET_S21_FLAT_SET_H
+
+#include <initializer_list>
+
+#include "../flat_tree/s21_flat_tree.h"
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*s21::set over one sorted s21::vector. Iterators are plain pointers to
+  const, and any insert or erase may invalidate them*/
+template <typename T, class Extract = s21::KeyExtract<T, T>,
+          class Compare = s21::Compare<T, T>>
+class flat_set {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using Container = FlatTree<T, T, Compare, Extract>;
+  using iterator = const T *;
+  using const_iterator = const T *;
+
+  flat_set() : set_() {}
+  flat_set(std::initializer_list<value_type> const &items)
+      : flat_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last) : set_() {
+    set_.insert_unique(first, last);
+  }
+  flat_set(const flat_set &s) : set_(s.set_) {}
+  flat_set(flat_set &&s) noexcept : set_(std::move(s.set_)) {}
+  ~flat_set() {}
+
+  flat_set &operator=(const flat_set &other) {
+    if (this != &other) {
+      set_ = other.set_;
+    }
+    return *this;
+  }
+  flat_set &operator=(flat_set &&s) noexcept {
+    if (this != &s) {
+      set_ = std::move(s.set_);
+    }
+    return *this;
+  }
+
+  iterator begin() const noexcept { return set_.begin(); }
+  iterator end() const noexcept { return set_.end(); }
+
+  const_iterator cbegin() const noexcept { return set_.cbegin(); }
+  const_iterator cend() const noexcept { return set_.cend(); }
+
+  bool empty() const noexcept { return set_.empty(); }
+  size_type size() const noexcept { return set_.size(); }
+  size_type max_size() const { return set_.max_size(); }
+  size_type capacity() const noexcept { return set_.capacity(); }
+  void reserve(size_type n) { set_.reserve(n); }
+  void shrink_to_fit() { set_.shrink_to_fit(); }
+
+  void clear() { set_.clear(); }
+  /*Sorted input skips the sort and only pays the duplicate check*/
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    set_.clear();
+    set_.insert_unique(first, last);
+  }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return set_.insert_unique(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return set_.insert_unique(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return set_.insert_hint_unique(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return set_.insert_hint_unique(hint, std::move(value));
+  }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    set_.insert_unique(first, last);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return set_.emplace_unique(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return set_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    s21::vector<std::pair<iterator, bool>> results;
+    (results.push_back(insert(std::forward<Args>(args))), ...);
+    return results;
+  }
+
+  iterator erase(iterator pos) { return set_.erase(pos); }
+  void swap(flat_set &other) { set_.swap(other.set_); }
+  void merge(flat_set &other) { set_.merge_unique(other.set_); }
+
+  iterator find(const T &key) const { return set_.search(key); }
+  bool contains(const T &key) const { return set_.contains(key); }
+  size_type count(const T &key) const { return set_.contains(key) ? 1 : 0; }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key) const {
+    return set_.search(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const {
+    return set_.contains(key);
+  }
+
+  iterator lower_bound(const T &key) const { return set_.lower_bound(key); }
+  iterator upper_bound(const T &key) const { return set_.upper_bound(key); }
+
+ private:
+  Container set_;
+};
+
+template <typename T, class Extract, class Compare>
+bool operator>(const flat_set<T, Extract, Compare> &lhs,
+               const flat_set<T, Extract, Compare> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare>
+bool operator>=(const flat_set<T, Extract, Compare> &lhs,
+                const flat_set<T, Extract, Compare> &rhs) {
+  return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+template <typename T, class Extract, class Compare>
+bool operator<(const flat_set<T, Extract, Compare> &lhs,
+               const flat_set<T, Extract, Compare> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare>
+bool operator<=(const flat_set<T, Extract, Compare> &lhs,
+                const flat_set<T, Extract, Compare> &rhs) {
+  return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, class Extract, class Compare>
+bool operator==(const flat_set<T, Extract, Compare> &lhs,
+                const flat_set<T, Extract, Compare> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename T, class Extract, class Compare>
+bool operator!=(const flat_set<T, Extract, Compare> &lhs,
+                const flat_set<T, Extract, Compare> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
@@ -0,0 +1,494 @@
+#ifndef CPP_S21_CONTAINERS_FLAT_TREE_S21_FLAT_TREE_H
+#define CPP_S21_CONTAINERS_FLAT_TREE_S21_FLAT_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "../helper/helper.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+/*Ordered storage behind flat_map and flat_set: the values sit sorted and
+  unique in one s21::vector. Lookups are binary searches over contiguous
+  memory, inserts and erases shift the tail, so any modification
+  invalidates iterators*/
+template <typename K, typename T, class Compare, class Extracter>
+class FlatTree {
+ public:
+  using key_type = K;
+  using value_type = T;
+  using size_type = size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  FlatTree();
+  FlatTree(const FlatTree &other);
+  FlatTree(FlatTree &&other) noexcept;
+  ~FlatTree();
+
+  FlatTree &operator=(const FlatTree &other);
+  FlatTree &operator=(FlatTree &&other) noexcept;
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type capacity() const noexcept;
+  void reserve(size_type n);
+  void shrink_to_fit();
+  void clear() noexcept;
+
+  template <typename V>
+  std::pair<iterator, bool> insert_unique(V &&val);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace_unique(const key_type &key,
+                                               Args &&...args);
+  template <typename V>
+  iterator insert_hint_unique(const_iterator hint, V &&val);
+  template <typename... Args>
+  iterator emplace_hint_unique(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void insert_unique(InputIt first, InputIt last);
+  iterator erase(const_iterator pos);
+  void swap(FlatTree &other) noexcept;
+  void merge_unique(FlatTree &other);
+
+  template <typename Key>
+  iterator search(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator search(const Key &key) const noexcept;
+  template <typename Key>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key>
+  iterator lower_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key>
+  iterator upper_bound(const Key &key) noexcept;
+  template <typename Key>
+  const_iterator upper_bound(const Key &key) const noexcept;
+
+ private:
+  s21::vector<value_type> data_;
+  Compare comp_;
+  Extracter extracter_;
+
+  bool Less(const value_type &lhs, const value_type &rhs) const;
+  template <typename Key>
+  const_iterator LowerBound(const Key &key) const noexcept;
+  template <typename Key>
+  const_iterator UpperBound(const Key &key) const noexcept;
+  template <typename Key>
+  std::pair<iterator, bool> GetInsertUniqPos(const Key &key) noexcept;
+  iterator InsertAt(const_iterator pos, value_type &&val);
+  void MergeTail(size_type sorted);
+  iterator Mutable(const_iterator pos) noexcept;
+};
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter>::FlatTree() : data_() {}
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter>::FlatTree(const FlatTree &other)
+    : data_(other.data_) {}
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter>::FlatTree(FlatTree &&other) noexcept
+    : data_(std::move(other.data_)) {}
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter>::~FlatTree() {}
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter> &
+FlatTree<K, T, Compare, Extracter>::operator=(const FlatTree &other) {
+  if (this != &other) {
+    data_ = other.data_;
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+FlatTree<K, T, Compare, Extracter> &
+FlatTree<K, T, Compare, Extracter>::operator=(FlatTree &&other) noexcept {
+  if (this != &other) {
+    data_ = std::move(other.data_);
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::begin() noexcept {
+  return data_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::begin() const noexcept {
+  return data_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::cbegin() const noexcept {
+  return data_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::end() noexcept {
+  return data_.end();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::end() const noexcept {
+  return data_.end();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::cend() const noexcept {
+  return data_.end();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+bool FlatTree<K, T, Compare, Extracter>::empty() const noexcept {
+  return data_.empty();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::size_type
+FlatTree<K, T, Compare, Extracter>::size() const noexcept {
+  return data_.size();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::size_type
+FlatTree<K, T, Compare, Extracter>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / sizeof(value_type);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::size_type
+FlatTree<K, T, Compare, Extracter>::capacity() const noexcept {
+  return data_.capacity();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::reserve(size_type n) {
+  data_.reserve(n);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::shrink_to_fit() {
+  data_.shrink_to_fit();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::clear() noexcept {
+  data_.clear();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename V>
+std::pair<typename FlatTree<K, T, Compare, Extracter>::iterator, bool>
+FlatTree<K, T, Compare, Extracter>::insert_unique(V &&val) {
+  std::pair<iterator, bool> res = GetInsertUniqPos(extracter_(val));
+
+  if (!res.second) {
+    return res;
+  }
+
+  res.first = InsertAt(res.first, value_type(std::forward<V>(val)));
+  return res;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename... Args>
+std::pair<typename FlatTree<K, T, Compare, Extracter>::iterator, bool>
+FlatTree<K, T, Compare, Extracter>::emplace_unique(Args &&...args) {
+  return insert_unique(value_type(std::forward<Args>(args)...));
+}
+
+/*The value is only built when the key is missing*/
+template <typename K, typename T, class Compare, class Extracter>
+template <typename... Args>
+std::pair<typename FlatTree<K, T, Compare, Extracter>::iterator, bool>
+FlatTree<K, T, Compare, Extracter>::try_emplace_unique(const key_type &key,
+                                                       Args &&...args) {
+  std::pair<iterator, bool> res = GetInsertUniqPos(key);
+
+  if (!res.second) {
+    return res;
+  }
+
+  res.first = InsertAt(res.first, value_type(std::forward<Args>(args)...));
+  return res;
+}
+
+/*A hint that already separates its neighbours saves the search, anything
+  else falls back to it*/
+template <typename K, typename T, class Compare, class Extracter>
+template <typename V>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::insert_hint_unique(const_iterator hint,
+                                                       V &&val) {
+  const auto &key = extracter_(val);
+
+  if ((hint == cbegin() || comp_(extracter_(hint[-1]), key)) &&
+      (hint == cend() || comp_(key, extracter_(*hint)))) {
+    return InsertAt(hint, value_type(std::forward<V>(val)));
+  }
+
+  return insert_unique(std::forward<V>(val)).first;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename... Args>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::emplace_hint_unique(const_iterator hint,
+                                                        Args &&...args) {
+  return insert_hint_unique(hint, value_type(std::forward<Args>(args)...));
+}
+
+/*Appends the whole range, sorts it and merges it into the old values once
+  instead of shifting the tail for every element*/
+template <typename K, typename T, class Compare, class Extracter>
+template <typename InputIt>
+void FlatTree<K, T, Compare, Extracter>::insert_unique(InputIt first,
+                                                       InputIt last) {
+  size_type sorted = data_.size();
+
+  if constexpr (s21::is_forward_iterator<InputIt>::value) {
+    data_.reserve(sorted + std::distance(first, last));
+  }
+
+  try {
+    for (; first != last; ++first) {
+      data_.emplace_back(*first);
+    }
+
+  } catch (...) {
+    while (data_.size() != sorted) {
+      data_.pop_back();
+    }
+
+    throw;
+  }
+
+  auto less = [this](const value_type &lhs, const value_type &rhs) {
+    return Less(lhs, rhs);
+  };
+
+  if (!std::is_sorted(begin() + sorted, end(), less)) {
+    std::stable_sort(begin() + sorted, end(), less);
+  }
+
+  MergeTail(sorted);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::erase(const_iterator pos) {
+  iterator next = Mutable(pos);
+
+  data_.erase(next);
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::swap(FlatTree &other) noexcept {
+  data_.swap(other.data_);
+}
+
+/*Keys already present stay behind in other, as with map::merge. Both
+  sides are sorted, so one walk over them splits other and one merge places
+  the moved values*/
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::merge_unique(FlatTree &other) {
+  if (this == &other) {
+    return;
+  }
+
+  size_type sorted = data_.size();
+  size_type mine = 0;
+  s21::vector<value_type> rest;
+
+  for (value_type &val : other.data_) {
+    while (mine < sorted && Less(data_[mine], val)) {
+      ++mine;
+    }
+
+    if (mine < sorted && !Less(val, data_[mine])) {
+      rest.push_back(std::move(val));
+
+    } else {
+      data_.push_back(std::move(val));
+    }
+  }
+
+  other.data_ = std::move(rest);
+  MergeTail(sorted);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::search(const Key &key) noexcept {
+  return Mutable(std::as_const(*this).search(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::search(const Key &key) const noexcept {
+  const_iterator finder = LowerBound(key);
+
+  if (finder == cend() || comp_(key, extracter_(*finder))) {
+    return cend();
+  }
+
+  return finder;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+bool FlatTree<K, T, Compare, Extracter>::contains(
+    const Key &key) const noexcept {
+  return search(key) != cend();
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::lower_bound(const Key &key) noexcept {
+  return Mutable(LowerBound(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::lower_bound(
+    const Key &key) const noexcept {
+  return LowerBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::upper_bound(const Key &key) noexcept {
+  return Mutable(UpperBound(key));
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::upper_bound(
+    const Key &key) const noexcept {
+  return UpperBound(key);
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+bool FlatTree<K, T, Compare, Extracter>::Less(const value_type &lhs,
+                                              const value_type &rhs) const {
+  return comp_(extracter_(lhs), extracter_(rhs));
+}
+
+/*Branchless: every step halves the range and only picks which half to keep,
+  which compiles to a conditional move rather than a jump the predictor
+  gets wrong half the time. The kept half may still hold the probed value,
+  which is harmless*/
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::LowerBound(const Key &key) const noexcept {
+  const_iterator base = cbegin();
+  size_type len = size();
+
+  while (len > 0) {
+    size_type half = len / 2;
+    base = comp_(extracter_(base[half]), key) ? base + (len - half) : base;
+    len = half;
+  }
+
+  return base;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+typename FlatTree<K, T, Compare, Extracter>::const_iterator
+FlatTree<K, T, Compare, Extracter>::UpperBound(const Key &key) const noexcept {
+  const_iterator base = cbegin();
+  size_type len = size();
+
+  while (len > 0) {
+    size_type half = len / 2;
+    base = !comp_(key, extracter_(base[half])) ? base + (len - half) : base;
+    len = half;
+  }
+
+  return base;
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+template <typename Key>
+std::pair<typename FlatTree<K, T, Compare, Extracter>::iterator, bool>
+FlatTree<K, T, Compare, Extracter>::GetInsertUniqPos(const Key &key) noexcept {
+  iterator pos = lower_bound(key);
+
+  return std::make_pair(pos, pos == end() || comp_(key, extracter_(*pos)));
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::InsertAt(const_iterator pos,
+                                             value_type &&val) {
+  return data_.insert_many(pos, std::move(val));
+}
+
+/*Merges the sorted run starting at index sorted into the values before it
+  and drops duplicates. The merge is stable and std::unique keeps the first
+  of equal values, so old keys win over new ones and earlier new ones over
+  later*/
+template <typename K, typename T, class Compare, class Extracter>
+void FlatTree<K, T, Compare, Extracter>::MergeTail(size_type sorted) {
+  std::inplace_merge(begin(), begin() + sorted, end(),
+                     [this](const value_type &lhs, const value_type &rhs) {
+                       return Less(lhs, rhs);
+                     });
+
+  iterator last = std::unique(
+      begin(), end(), [this](const value_type &lhs, const value_type &rhs) {
+        return !Less(lhs, rhs);
+      });
+
+  while (end() != last) {
+    data_.pop_back();
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter>
+typename FlatTree<K, T, Compare, Extracter>::iterator
+FlatTree<K, T, Compare, Extracter>::Mutable(const_iterator pos) noexcept {
+  return begin() + (pos - cbegin());
+}
+
+}  // namespace s21
+
+#endif
\ No newline at end of file
@@ -1,28 +1,68 @@
 #ifndef CPP_S21_CONTAINERS_HELPER_HELPER_H
 #define CPP_S21_CONTAINERS_HELPER_HELPER_H
 
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace s21 {
 template <typename C, typename V>
 struct KeyExtract {
-  C operator()(const std::pair<const C, V> &target) const {
+  const C &operator()(const std::pair<C, V> &target) const {
     return target.first;
   }
 
-  C operator()(const C target) const { return target; }
+  const C &operator()(const std::pair<const C, V> &target) const {
+    return target.first;
+  }
+
+  const C &operator()(const C &target) const { return target; }
 };
 
 template <typename C, typename V>
 struct Compare {
-  // bool operator()(const std::pair<C, V> &lhs,
-  //                 const std::pair<C, V> &rhs) const {
-  //   return lhs.first < rhs.first;
-  //}
+  bool operator()(const C &lhs, const C &rhs) const { return lhs < rhs; }
+};
 
+/*Like std::less: less<> is transparent, so lookups may pass anything that
+  orders against the key with <, such as a std::string_view for std::string
+  keys*/
+template <typename C = void>
+struct less {
   bool operator()(const C &lhs, const C &rhs) const { return lhs < rhs; }
 };
 
+template <>
+struct less<void> {
+  using is_transparent = void;
+
+  template <typename L, typename R>
+  bool operator()(const L &lhs, const R &rhs) const {
+    return lhs < rhs;
+  }
+};
+
+/*Multi-pass iterators let the tree containers inspect a range before
+  building from it*/
+template <typename It, class = void>
+struct is_forward_iterator : std::false_type {};
+
+template <typename It>
+struct is_forward_iterator<
+    It, std::void_t<typename std::iterator_traits<It>::iterator_category>>
+    : std::is_base_of<std::forward_iterator_tag,
+                      typename std::iterator_traits<It>::iterator_category> {};
+
+/*Types whose objects may be moved to new memory by copying their bytes and
+  forgetting the originals. Specialize it for types that own resources but
+  never point into themselves*/
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
 template <class ImputIt1, typename ImputIt2>
 bool lexicog_compare(ImputIt1 begin1, ImputIt1 end1, ImputIt2 begin2,
                      ImputIt2 end2) {
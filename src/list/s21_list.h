@@ -4,13 +4,16 @@
 #include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+#include "../allocator/s21_pool_allocator.h"
 #include "../helper/helper.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, class Alloc = s21::pool_allocator<T>>
 class list {
   struct Node;
 
@@ -24,6 +27,7 @@ class list {
   using size_type = std::size_t;
   using iterator = ListIterator;
   using const_iterator = ListConstIterator;
+  using allocator_type = Alloc;
 
   class ListIterator {
     friend class list;
@@ -77,6 +81,7 @@ class list {
   };
 
   list();
+  explicit list(const allocator_type &alloc);
   explicit list(size_type n);
   list(std::initializer_list<value_type> const &items);
   list(const list &l);
@@ -92,6 +97,7 @@ class list {
   bool empty() const noexcept;
   size_type size() const noexcept;
   size_type max_size() const noexcept;
+  allocator_type get_allocator() const noexcept;
 
   iterator begin() const noexcept;
   iterator end() const noexcept;
@@ -120,14 +126,33 @@ class list {
   void insert_many_front(Args &&...args);
 
  private:
+  /*data_ is constructed and destroyed by the list, so the sentinel can go
+    without a value*/
   struct Node {
-    value_type data_ = T();
+    Node() noexcept : next_(this), prev_(this) {}
+    explicit Node(const_reference data) : data_(data) {}
+    ~Node() {}
+
+    union {
+      value_type data_;
+    };
     Node *next_;
     Node *prev_;
   };
 
+  using node_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   size_type size_;
+  Node header_;
   Node *sentenel_;
+  node_allocator alloc_;
+
+  Node *CreateNode(const_reference data);
+  void DestroyNode(Node *node) noexcept;
+  void LinkSentinel() noexcept;
+  void Adopt(list &other) noexcept;
   void Insert(iterator pos, iterator pos2) noexcept;
   void Insert(const_iterator pos, iterator pos2) noexcept;
   void SwapItPtr(const_iterator pos, const_iterator pos2) noexcept;
@@ -135,48 +160,47 @@ class list {
   list &SortedMerge(list &left, list &right) noexcept;
 };
 
-template <typename T>
-list<T>::list() : size_(0) {
-  sentenel_ = new Node;
-  sentenel_->data_ = T();
-  sentenel_->next_ = sentenel_;
-  sentenel_->prev_ = sentenel_;
-}
+template <typename T, class Alloc>
+list<T, Alloc>::list() : size_(0), header_(), sentenel_(&header_) {}
 
-template <typename T>
-list<T>::list(size_type n) : list() {
+template <typename T, class Alloc>
+list<T, Alloc>::list(const allocator_type &alloc)
+    : size_(0), header_(), sentenel_(&header_), alloc_(alloc) {}
+
+template <typename T, class Alloc>
+list<T, Alloc>::list(size_type n) : list() {
   for (size_type i = 0; i < n; ++i) {
     push_back(T());
   }
 }
 
-template <typename T>
-list<T>::list(std::initializer_list<value_type> const &items) : list() {
+template <typename T, class Alloc>
+list<T, Alloc>::list(std::initializer_list<value_type> const &items) : list() {
   for (const auto &value : items) {
     push_back(value);
   }
 }
 
-template <typename T>
-list<T>::list(const list &l) : list() {
+template <typename T, class Alloc>
+list<T, Alloc>::list(const list &l)
+    : list(node_traits::select_on_container_copy_construction(l.alloc_)) {
   for (auto it = l.begin(); it != l.end(); ++it) {
     push_back(*it);
   }
 }
 
-template <typename T>
-list<T>::list(list &&l) noexcept : list() {
-  *this = std::move(l);
+template <typename T, class Alloc>
+list<T, Alloc>::list(list &&l) noexcept : list() {
+  swap(l);
 }
 
-template <typename T>
-list<T>::~list() {
+template <typename T, class Alloc>
+list<T, Alloc>::~list() {
   clear();
-  delete sentenel_;
 }
 
-template <typename T>
-list<T> &list<T>::operator=(const list &l) {
+template <typename T, class Alloc>
+list<T, Alloc> &list<T, Alloc>::operator=(const list &l) {
   if (this != &l) {
     clear();
 
@@ -188,37 +212,69 @@ list<T> &list<T>::operator=(const list &l) {
   return *this;
 }
 
-template <typename T>
-list<T> &list<T>::operator=(list &&l) noexcept {
+template <typename T, class Alloc>
+list<T, Alloc> &list<T, Alloc>::operator=(list &&l) noexcept {
   if (this != &l) {
     clear();
+
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(l.alloc_);
+
+    } else if (alloc_ != l.alloc_) {
+      *this = l;
+      l.clear();
+      return *this;
+    }
+
     size_ = l.size_;
     sentenel_->next_ = l.sentenel_->next_;
     sentenel_->prev_ = l.sentenel_->prev_;
-    l.sentenel_->next_->prev_ = sentenel_;
-    l.sentenel_->prev_->next_ = sentenel_;
+    LinkSentinel();
 
     l.size_ = 0;
-    l.sentenel_->next_ = l.sentenel_->prev_ = l.sentenel_;
+    l.LinkSentinel();
   }
 
   return *this;
 }
 
-template <typename T>
-typename list<T>::const_reference list<T>::front() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reference list<T, Alloc>::front()
+    const noexcept {
   return sentenel_->next_->data_;
 }
 
-template <typename T>
-typename list<T>::const_reference list<T>::back() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reference list<T, Alloc>::back()
+    const noexcept {
   return sentenel_->prev_->data_;
 }
 
-template <typename T>
-void list<T>::clear() noexcept {
-  while (!empty()) {
-    pop_back();
+template <typename T, class Alloc>
+void list<T, Alloc>::clear() noexcept {
+  if constexpr (is_releasable_allocator<node_allocator>::value) {
+    if (alloc_.unique()) {
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (Node *node = sentenel_->next_; node != sentenel_;) {
+          Node *next = node->next_;
+          std::destroy_at(&node->data_);
+          node_traits::destroy(alloc_, node);
+          node = next;
+        }
+      }
+
+      alloc_.release();
+
+    } else {
+      while (!empty()) {
+        pop_back();
+      }
+    }
+
+  } else {
+    while (!empty()) {
+      pop_back();
+    }
   }
 
   sentenel_->next_ = sentenel_;
@@ -226,46 +282,52 @@ void list<T>::clear() noexcept {
   size_ = 0;
 }
 
-template <typename T>
-bool list<T>::empty() const noexcept {
+template <typename T, class Alloc>
+bool list<T, Alloc>::empty() const noexcept {
   return begin() == end();
 }
 
-template <typename T>
-typename list<T>::size_type list<T>::size() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::size() const noexcept {
   return size_;
 }
 
-template <typename T>
-typename list<T>::size_type list<T>::max_size() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::max_size() const noexcept {
   return std::numeric_limits<size_t>::max() / sizeof(Node) / 2;
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::begin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::allocator_type list<T, Alloc>::get_allocator()
+    const noexcept {
+  return allocator_type(alloc_);
+}
+
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::begin() const noexcept {
   return ListIterator(sentenel_->next_);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::end() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::end() const noexcept {
   return ListIterator(sentenel_);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::cbegin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cbegin()
+    const noexcept {
   return ListConstIterator(sentenel_->next_);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::cend() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cend() const noexcept {
   return ListConstIterator(sentenel_);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(iterator pos,
-                                           const_reference value) {
-  Node *new_node = new Node;
-  new_node->data_ = value;
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(
+    iterator pos, const_reference value) {
+  Node *new_node = CreateNode(value);
 
   new_node->prev_ = pos.it_->prev_;
   pos.it_->prev_->next_ = new_node;
@@ -277,47 +339,53 @@ typename list<T>::iterator list<T>::insert(iterator pos,
   return pos;
 }
 
-template <typename T>
-void list<T>::erase(iterator pos) {
+template <typename T, class Alloc>
+void list<T, Alloc>::erase(iterator pos) {
   Node *current = pos.it_;
   pos.it_ = current->prev_;
   pos.it_->next_ = current->next_;
   pos.it_->next_->prev_ = pos.it_;
-  delete current;
+  DestroyNode(current);
 
   --size_;
 }
 
-template <typename T>
-void list<T>::push_back(const_reference data) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_back(const_reference data) {
   insert(end(), data);
 }
 
-template <typename T>
-void list<T>::push_front(const_reference data) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_front(const_reference data) {
   insert(begin(), data);
 }
 
-template <typename T>
-void list<T>::pop_back() {
+template <typename T, class Alloc>
+void list<T, Alloc>::pop_back() {
   erase(--end());
 }
 
-template <typename T>
-void list<T>::pop_front() {
+template <typename T, class Alloc>
+void list<T, Alloc>::pop_front() {
   erase(begin());
 }
 
-template <typename T>
-void list<T>::swap(list &other) noexcept {
-  std::swap(sentenel_, other.sentenel_);
+template <typename T, class Alloc>
+void list<T, Alloc>::swap(list &other) noexcept {
+  std::swap(sentenel_->next_, other.sentenel_->next_);
+  std::swap(sentenel_->prev_, other.sentenel_->prev_);
   std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  LinkSentinel();
+  other.LinkSentinel();
 }
 
-template <typename T>
-void list<T>::merge(list<T> &other) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::merge(list<T, Alloc> &other) noexcept {
+  Adopt(other);
+
   if (begin() == end()) {
-    *this = std::move(other);
+    splice(cend(), other);
 
   } else if (other.begin() != other.end()) {
     iterator it = begin();
@@ -356,8 +424,10 @@ void list<T>::merge(list<T> &other) noexcept {
   }
 }
 
-template <typename T>
-void list<T>::splice(const_iterator pos, list &other) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list &other) noexcept {
+  Adopt(other);
+
   const_iterator umbrella = pos;
   iterator it = other.begin();
 
@@ -368,8 +438,8 @@ void list<T>::splice(const_iterator pos, list &other) noexcept {
   }
 }
 
-template <typename T>
-void list<T>::reverse() noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::reverse() noexcept {
   Node *temp = nullptr;
   Node *next = sentenel_->next_;
 
@@ -387,8 +457,8 @@ void list<T>::reverse() noexcept {
   }
 }
 
-template <typename T>
-void list<T>::unique() {
+template <typename T, class Alloc>
+void list<T, Alloc>::unique() {
   bool met = false;
   iterator current = begin();
   iterator was;
@@ -412,14 +482,14 @@ void list<T>::unique() {
   }
 }
 
-template <typename T>
-void list<T>::sort() noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::sort() noexcept {
   if (begin() == end() || ++begin() == end()) {
     return;
   }
 
-  list left;
-  list right;
+  list left(alloc_);
+  list right(alloc_);
 
   Spliter(left, right);
 
@@ -428,10 +498,10 @@ void list<T>::sort() noexcept {
   *this = SortedMerge(left, right);
 }
 
-template <typename T>
+template <typename T, class Alloc>
 template <typename... Args>
-typename list<T>::iterator list<T>::insert_many(const_iterator pos,
-                                                Args &&...args) {
+typename list<T, Alloc>::iterator list<T, Alloc>::insert_many(
+    const_iterator pos, Args &&...args) {
   Node *current = pos.it_;
   iterator it(current);
 
@@ -440,21 +510,21 @@ typename list<T>::iterator list<T>::insert_many(const_iterator pos,
   return it;
 }
 
-template <typename T>
+template <typename T, class Alloc>
 template <typename... Args>
-void list<T>::insert_many_back(Args &&...args) {
+void list<T, Alloc>::insert_many_back(Args &&...args) {
   (push_back(std::forward<Args>(args)), ...);
 }
 
-template <typename T>
+template <typename T, class Alloc>
 template <typename... Args>
-void list<T>::insert_many_front(Args &&...args) {
+void list<T, Alloc>::insert_many_front(Args &&...args) {
   auto it = begin();
   (insert(it, std::forward<Args>(args)), ...);
 }
 
-template <typename T>
-void list<T>::Insert(iterator pos, iterator pos2) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::Insert(iterator pos, iterator pos2) noexcept {
   Node *current = pos.it_;
   Node *other = pos2.it_;
 
@@ -468,32 +538,77 @@ void list<T>::Insert(iterator pos, iterator pos2) noexcept {
   ++size_;
 }
 
-template <typename T>
-void list<T>::Insert(const_iterator pos, iterator pos2) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::Insert(const_iterator pos, iterator pos2) noexcept {
   iterator it(pos.it_->prev_);
   iterator it_2(pos2.it_);
 
   Insert(it, it_2);
 }
 
-template <typename T>
-void list<T>::SwapItPtr(const_iterator pos, const_iterator pos2) noexcept {
-  Node save = *pos.it_;
+template <typename T, class Alloc>
+typename list<T, Alloc>::Node *list<T, Alloc>::CreateNode(
+    const_reference data) {
+  Node *node = node_traits::allocate(alloc_, 1);
+
+  try {
+    node_traits::construct(alloc_, node, data);
+
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+
+  return node;
+}
+
+template <typename T, class Alloc>
+void list<T, Alloc>::DestroyNode(Node *node) noexcept {
+  std::destroy_at(&node->data_);
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+/*The sentinel lives inside the list object, so after its links were taken
+  from another list the end nodes have to be pointed back at it*/
+template <typename T, class Alloc>
+void list<T, Alloc>::LinkSentinel() noexcept {
+  if (size_ == 0) {
+    sentenel_->next_ = sentenel_->prev_ = sentenel_;
+
+  } else {
+    sentenel_->next_->prev_ = sentenel_;
+    sentenel_->prev_->next_ = sentenel_;
+  }
+}
+
+/*Nodes are relinked as they are, so we have to be able to free what other
+  allocated: pool allocators adopt each other's pool for that, any other
+  allocator has to compare equal, as for std::list*/
+template <typename T, class Alloc>
+void list<T, Alloc>::Adopt(list &other) noexcept {
+  adopt_allocations(alloc_, other.alloc_);
+}
+
+template <typename T, class Alloc>
+void list<T, Alloc>::SwapItPtr(const_iterator pos,
+                               const_iterator pos2) noexcept {
+  Node *save = pos.it_->next_;
 
   pos.it_->next_->prev_ = pos2.it_;
   pos.it_->next_ = pos2.it_->next_;
   pos2.it_->next_->prev_ = pos.it_;
-  pos2.it_->next_ = save.next_;
+  pos2.it_->next_ = save;
 
-  save = *pos2.it_;
+  save = pos2.it_->prev_;
   pos2.it_->prev_->next_ = pos.it_;
   pos2.it_->prev_ = pos.it_->prev_;
   pos.it_->prev_->next_ = pos2.it_;
-  pos.it_->prev_ = save.prev_;
+  pos.it_->prev_ = save;
 }
 
-template <typename T>
-void list<T>::Spliter(list &left, list &right) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::Spliter(list &left, list &right) noexcept {
   const_iterator it = cbegin();
 
   if (it != end()) {
@@ -511,8 +626,9 @@ void list<T>::Spliter(list &left, list &right) noexcept {
   }
 }
 
-template <typename T>
-typename list<T>::list &list<T>::SortedMerge(list &left, list &right) noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::list &list<T, Alloc>::SortedMerge(
+    list &left, list &right) noexcept {
   if (left.begin() == left.end()) {
     return right;
 
@@ -534,191 +650,199 @@ typename list<T>::list &list<T>::SortedMerge(list &left, list &right) noexcept {
   return left;
 }
 
-template <typename T>
-list<T>::ListIterator::ListIterator() : it_(nullptr) {}
+template <typename T, class Alloc>
+list<T, Alloc>::ListIterator::ListIterator() : it_(nullptr) {}
 
-template <typename T>
-list<T>::ListIterator::ListIterator(Node *src) : it_(src) {}
+template <typename T, class Alloc>
+list<T, Alloc>::ListIterator::ListIterator(Node *src) : it_(src) {}
 
-template <typename T>
-list<T>::ListIterator::ListIterator(const ListIterator &src) : it_(src.it_) {}
+template <typename T, class Alloc>
+list<T, Alloc>::ListIterator::ListIterator(const ListIterator &src)
+    : it_(src.it_) {}
 
-template <typename T>
-list<T>::ListIterator::ListIterator(ListIterator &&src) : it_(src.it_) {
+template <typename T, class Alloc>
+list<T, Alloc>::ListIterator::ListIterator(ListIterator &&src) : it_(src.it_) {
   src.it_ = nullptr;
 }
 
-template <typename T>
-typename list<T>::ListIterator &list<T>::ListIterator::operator=(
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator &list<T, Alloc>::ListIterator::operator=(
     const ListIterator &other) noexcept {
   it_ = nullptr;
   it_ = other.it_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListIterator &list<T>::ListIterator::operator=(
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator &list<T, Alloc>::ListIterator::operator=(
     ListIterator &&other) noexcept {
   it_ = other.it_;
   other.it_ = nullptr;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListIterator &list<T>::ListIterator::operator++() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator &
+list<T, Alloc>::ListIterator::operator++() noexcept {
   it_ = it_->next_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListIterator list<T>::ListIterator::operator++(int) noexcept {
-  list<T>::ListIterator old = *this;
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator
+list<T, Alloc>::ListIterator::operator++(int) noexcept {
+  list<T, Alloc>::ListIterator old = *this;
   it_ = it_->next_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListIterator &list<T>::ListIterator::operator--() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator &
+list<T, Alloc>::ListIterator::operator--() noexcept {
   it_ = it_->prev_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListIterator list<T>::ListIterator::operator--(int) noexcept {
-  list<T>::ListIterator old = *this;
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListIterator
+list<T, Alloc>::ListIterator::operator--(int) noexcept {
+  list<T, Alloc>::ListIterator old = *this;
   it_ = it_->prev_;
   return *this;
 }
 
-template <typename T>
-inline bool list<T>::ListIterator::operator==(
+template <typename T, class Alloc>
+inline bool list<T, Alloc>::ListIterator::operator==(
     const ListIterator &other) noexcept {
   return it_ == other.it_;
 }
 
-template <typename T>
-inline bool list<T>::ListIterator::operator!=(
+template <typename T, class Alloc>
+inline bool list<T, Alloc>::ListIterator::operator!=(
     const ListIterator &other) noexcept {
   return it_ != other.it_;
 }
 
-template <typename T>
-inline typename list<T>::value_type &list<T>::ListIterator::operator*()
-    const noexcept {
+template <typename T, class Alloc>
+inline typename list<T, Alloc>::value_type &
+list<T, Alloc>::ListIterator::operator*() const noexcept {
   return it_->data_;
 }
 
-template <typename T>
-list<T>::ListConstIterator::ListConstIterator() : it_(nullptr) {}
+template <typename T, class Alloc>
+list<T, Alloc>::ListConstIterator::ListConstIterator() : it_(nullptr) {}
 
-template <typename T>
-list<T>::ListConstIterator::ListConstIterator(Node *src) : it_(src) {}
+template <typename T, class Alloc>
+list<T, Alloc>::ListConstIterator::ListConstIterator(Node *src) : it_(src) {}
 
-template <typename T>
-list<T>::ListConstIterator::ListConstIterator(const ListConstIterator &src)
+template <typename T, class Alloc>
+list<T, Alloc>::ListConstIterator::ListConstIterator(
+    const ListConstIterator &src)
     : it_(src.it_) {}
 
-template <typename T>
-list<T>::ListConstIterator::ListConstIterator(const ListIterator &src)
+template <typename T, class Alloc>
+list<T, Alloc>::ListConstIterator::ListConstIterator(const ListIterator &src)
     : ListConstIterator(src.it_){};
 
-template <typename T>
-list<T>::ListConstIterator::ListConstIterator(ListConstIterator &&src)
+template <typename T, class Alloc>
+list<T, Alloc>::ListConstIterator::ListConstIterator(ListConstIterator &&src)
     : it_(src.it_) {
   src.it_ = nullptr;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator &list<T>::ListConstIterator::operator=(
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator &
+list<T, Alloc>::ListConstIterator::operator=(
     const ListConstIterator &other) noexcept {
   it_ = nullptr;
   it_ = other.it_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator &list<T>::ListConstIterator::operator=(
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator &
+list<T, Alloc>::ListConstIterator::operator=(
     ListConstIterator &&other) noexcept {
   it_ = other.it_;
   other.it_ = nullptr;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator &
-list<T>::ListConstIterator::operator++() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator &
+list<T, Alloc>::ListConstIterator::operator++() noexcept {
   it_ = it_->next_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator list<T>::ListConstIterator::operator++(
-    int) noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator
+list<T, Alloc>::ListConstIterator::operator++(int) noexcept {
   ListConstIterator tmp(it_);
   it_ = it_->next_;
   return tmp;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator &
-list<T>::ListConstIterator::operator--() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator &
+list<T, Alloc>::ListConstIterator::operator--() noexcept {
   it_ = it_->prev_;
   return *this;
 }
 
-template <typename T>
-typename list<T>::ListConstIterator list<T>::ListConstIterator::operator--(
-    int) noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::ListConstIterator
+list<T, Alloc>::ListConstIterator::operator--(int) noexcept {
   ListConstIterator tmp(it_);
   it_ = it_->prev_;
   return tmp;
 }
 
-template <typename T>
-inline bool list<T>::ListConstIterator::operator==(
+template <typename T, class Alloc>
+inline bool list<T, Alloc>::ListConstIterator::operator==(
     const ListConstIterator &other) noexcept {
   return it_ == other.it_;
 }
 
-template <typename T>
-inline bool list<T>::ListConstIterator::operator!=(
+template <typename T, class Alloc>
+inline bool list<T, Alloc>::ListConstIterator::operator!=(
     const ListConstIterator &other) noexcept {
   return it_ != other.it_;
 }
 
-template <typename T>
-inline const typename list<T>::value_type &
-list<T>::ListConstIterator::operator*() const noexcept {
+template <typename T, class Alloc>
+inline const typename list<T, Alloc>::value_type &
+list<T, Alloc>::ListConstIterator::operator*() const noexcept {
   return it_->data_;
 }
 
-template <typename T>
-bool operator<(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T>
-bool operator<=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T>
-bool operator>(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T>
-bool operator>=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T>
-bool operator==(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return s21::is_equal(lhs, rhs);
 }
 
-template <typename T>
-bool operator!=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, class Alloc>
+bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
   return !s21::is_equal(lhs, rhs);
 }
 
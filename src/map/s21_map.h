@@ -2,15 +2,20 @@
 #define CPP_S21_CONTAINERS_MAP_S21_MAP_H
 
 #include <initializer_list>
+#include <tuple>
+#include <utility>
 
 #include "../RBtree/s21_RBtree.h"
+#include "../cow/s21_cow.h"
 #include "../helper/helper.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
 
 template <typename K, typename T, class Compare = s21::Compare<K, T>,
-          class Extract = s21::KeyExtract<K, T>>
+          class Extract = s21::KeyExtract<K, T>, bool Indexed = false,
+          class Alloc = s21::pool_allocator<std::pair<K, T>>,
+          bool Threaded = false>
 class map {
  public:
   using key_type = K;
@@ -19,12 +24,20 @@ class map {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
-  using Container = s21::RBTree<K, std::pair<K, T>, Compare, Extract>;
+  using allocator_type = Alloc;
+  using Container =
+      s21::RBTree<K, std::pair<K, T>, Compare, Extract, Indexed, Alloc,
+                  Threaded>;
   using iterator = typename Container::iterator;
   using const_iterator = typename Container::const_iterator;
+  using node_type = typename Container::node_handle;
+  using insert_return_type = typename Container::insert_return_type;
 
   map();
+  explicit map(const allocator_type &alloc);
   map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  map(InputIt first, InputIt last);
   map(const map &m);
   map(map &&m) noexcept;
   ~map();
@@ -33,7 +46,11 @@ class map {
   map &operator=(map &&m) noexcept;
 
   T &at(const key_type &k) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  T &at(const Key &k) const;
   T &operator[](const key_type &k);
+  T &operator[](key_type &&k);
 
   iterator begin() noexcept;
   const_iterator begin() const noexcept;
@@ -46,18 +63,63 @@ class map {
   bool empty() const noexcept;
   size_type size() const noexcept;
   size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
 
   void clear();
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
   std::pair<iterator, bool> insert(const key_type &key,
                                    const mapped_value &obj);
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_value &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+  insert_return_type insert(node_type &&nh);
+  node_type extract(const_iterator pos);
+  node_type extract(const key_type &key);
   iterator erase(iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key);
+  template <typename Pred>
+  size_type erase_if(Pred pred);
   void swap(map &other);
   void merge(map &other);
 
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key);
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key &key) const;
   bool contains(const key_type &key) const noexcept;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const noexcept;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  size_type count(const key_type &key) const;
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const Key &key) const;
+
+  size_type rank(const key_type &key) const;
+  iterator select(size_type k);
+  const_iterator select(size_type k) const;
+  size_type distance(const_iterator first, const_iterator last) const;
 
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
@@ -66,42 +128,80 @@ class map {
   Container map_;
 };
 
-template <typename K, typename T, class Compare, class Extract>
-map<K, T, Compare, Extract>::map() : map_(){};
-
-template <typename K, typename T, class Compare, class Extract>
-map<K, T, Compare, Extract>::map(std::initializer_list<value_type> const &items)
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map() : map_(){};
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map(
+    const allocator_type &alloc)
+    : map_(alloc) {}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map(
+    std::initializer_list<value_type> const &items)
+    : map(items.begin(), items.end()) {}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map(
+    InputIt first, InputIt last)
     : map() {
-  for (auto it : items) {
-    insert(it);
-  }
+  map_.insert_unique(first, last);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-map<K, T, Compare, Extract>::map(const map &m) : map_(m.map_) {}
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map(
+    const map &m) : map_(m.map_) {}
 
-template <typename K, typename T, class Compare, class Extract>
-map<K, T, Compare, Extract>::map(map &&m) noexcept : map_(std::move(m.map_)) {}
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map(map &&m) noexcept
+    : map_(std::move(m.map_)) {}
 
-template <typename K, typename T, class Compare, class Extract>
-map<K, T, Compare, Extract>::~map(){};
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::~map(){};
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::map &
-map<K, T, Compare, Extract>::operator=(const map &m) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map &
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::operator=(const map &m) {
   map_ = m.map_;
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::map &
-map<K, T, Compare, Extract>::operator=(map &&m) noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::map &
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::operator=(
+    map &&m) noexcept {
   map_ = std::move(m.map_);
   return *this;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-T &map<K, T, Compare, Extract>::at(const key_type &k) const {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+T &map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::at(
+    const key_type &k) const {
+  iterator finder = map_.search(k);
+
+  if (finder == end()) {
+    throw std::out_of_range("That bulshit is not contain in me!");
+  }
+
+  return finder->second;
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key, typename C, typename>
+T &map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::at(
+    const Key &k) const {
   iterator finder = map_.search(k);
 
   if (finder == end()) {
@@ -111,80 +211,150 @@ T &map<K, T, Compare, Extract>::at(const key_type &k) const {
   return finder->second;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-T &map<K, T, Compare, Extract>::operator[](const key_type &k) {
-  iterator creep = insert({k, mapped_value()}).first;
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+T &map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::operator[](
+    const key_type &k) {
+  return try_emplace(k).first->second;
+}
 
-  return creep->second;
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+T &map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::operator[](
+    key_type &&k) {
+  return try_emplace(std::move(k)).first->second;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::iterator
-map<K, T, Compare, Extract>::begin() noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::begin() noexcept {
   return map_.begin();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::const_iterator
-map<K, T, Compare, Extract>::begin() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::begin() const noexcept {
   return map_.begin();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::const_iterator
-map<K, T, Compare, Extract>::cbegin() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::cbegin() const noexcept {
   return map_.cbegin();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::iterator
-map<K, T, Compare, Extract>::end() noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::end() noexcept {
   return map_.end();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::const_iterator
-map<K, T, Compare, Extract>::end() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::end() const noexcept {
   return map_.end();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::const_iterator
-map<K, T, Compare, Extract>::cend() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::cend() const noexcept {
   return map_.cend();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool map<K, T, Compare, Extract>::empty() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::empty() const
+    noexcept {
   return map_.empty();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::size_type
-map<K, T, Compare, Extract>::size() const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size() const noexcept {
   return map_.size();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::size_type
-map<K, T, Compare, Extract>::max_size() const {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::max_size() const {
   return map_.max_size();
 }
 
-template <typename K, typename T, class Compare, class Extract>
-void map<K, T, Compare, Extract>::clear() {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::allocator_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::get_allocator()
+    const noexcept {
+  return map_.get_allocator();
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+void map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::clear() {
+  map_.clear();
+}
+
+/*Ordered input is linked up in O(n), anything else is inserted one by one*/
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename InputIt>
+void map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::assign_sorted(
+    InputIt first, InputIt last) {
   map_.clear();
+  map_.insert_unique(first, last);
 }
-template <typename K, typename T, class Compare, class Extract>
-std::pair<typename map<K, T, Compare, Extract>::iterator, bool>
-map<K, T, Compare, Extract>::insert(const value_type &value) {
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(
+    const value_type &value) {
   return map_.insert_unique(value);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-std::pair<typename map<K, T, Compare, Extract>::iterator, bool>
-map<K, T, Compare, Extract>::insert(const key_type &key,
-                                    const mapped_value &obj) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(
+    value_type &&value) {
+  return map_.insert_unique(std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(
+    const_iterator hint, const value_type &value) {
+  return map_.insert_hint_unique(hint, value);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(
+    const_iterator hint, value_type &&value) {
+  return map_.insert_hint_unique(hint, std::move(value));
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(
+    const key_type &key, const mapped_value &obj) {
   iterator inserter = map_.search(key);
 
   if (inserter == end()) {
@@ -195,46 +365,258 @@ map<K, T, Compare, Extract>::insert(const key_type &key,
   return std::pair<iterator, bool>(inserter, true);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-std::pair<typename map<K, T, Compare, Extract>::iterator, bool>
-map<K, T, Compare, Extract>::insert_or_assign(const key_type &key,
-                                              const mapped_value &obj) {
-  std::pair<iterator, bool> creep = insert({key, obj});
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert_or_assign(
+    const key_type &key, const mapped_value &obj) {
+  std::pair<iterator, bool> creep = try_emplace(key, obj);
 
   if (creep.second) {
     return creep;
   }
 
   creep.first->second = obj;
-  creep.second = false;
   return creep;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-typename map<K, T, Compare, Extract>::iterator
-map<K, T, Compare, Extract>::erase(iterator pos) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::emplace(Args &&...args) {
+  return map_.emplace_unique(std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::emplace_hint(
+    const_iterator hint, Args &&...args) {
+  return map_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+}
+
+/*The mapped value is built in the node, and only when the key is missing*/
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::try_emplace(
+    const key_type &key, Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename... Args>
+std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::try_emplace(
+    key_type &&key, Args &&...args) {
+  return map_.try_emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc,
+             Threaded>::insert_return_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert(node_type &&nh) {
+  return map_.insert_unique(std::move(nh));
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::node_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::extract(
+    const_iterator pos) {
+  return map_.extract(pos);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::node_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::extract(
+    const key_type &key) {
+  return map_.extract_key(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::erase(iterator pos) {
   return iterator(map_.erase(pos));
 }
 
-template <typename K, typename T, class Compare, class Extract>
-void map<K, T, Compare, Extract>::swap(map &other) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::erase(
+    const_iterator first, const_iterator last) {
+  return map_.erase(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::erase(
+    const key_type &key) {
+  return map_.erase_key(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Pred>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::erase_if(Pred pred) {
+  return map_.erase_if(pred);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+void map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::swap(map &other) {
   map_.swap(other.map_);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-void map<K, T, Compare, Extract>::merge(map &other) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+void map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::merge(map &other) {
   map_.merge_unique(other.map_);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool map<K, T, Compare, Extract>::contains(const key_type &key) const noexcept {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::find(
+    const key_type &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::find(
+    const key_type &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key, typename C, typename>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::find(const Key &key) {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key, typename C, typename>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::find(
+    const Key &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::contains(
+    const key_type &key) const noexcept {
   return map_.contains(key);
 }
 
-template <typename K, typename T, class Compare, class Extract>
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key, typename C, typename>
+bool map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::contains(
+    const Key &key) const noexcept {
+  return map_.contains(key);
+}
+
+/*Writes find(key) for every key; the lookups of a batch overlap their
+  cache misses, and sorted keys share the top of their paths*/
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt, typename OutputIt>
+OutputIt map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) {
+  return map_.find_many(first, last, out);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename ForwardIt, typename OutputIt>
+OutputIt map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::contains_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return map_.contains_many(first, last, out);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::count(
+    const key_type &key) const {
+  return map_.count(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+template <typename Key, typename C, typename>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::count(
+    const Key &key) const {
+  return map_.count(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::rank(
+    const key_type &key) const {
+  return map_.rank(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::select(size_type k) {
+  return map_.select(k);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::const_iterator
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::select(
+    size_type k) const {
+  return map_.select(k);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::size_type
+map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::distance(
+    const_iterator first, const_iterator last) const {
+  return map_.distance(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
 template <typename... Args>
-s21::vector<std::pair<typename map<K, T, Compare, Extract>::iterator, bool>>
-s21::map<K, T, Compare, Extract>::insert_many(Args &&...args) {
+s21::vector<std::pair<
+    typename map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::iterator,
+    bool>>
+s21::map<K, T, Compare, Extract, Indexed, Alloc, Threaded>::insert_many(
+    Args &&...args) {
   s21::vector<std::pair<iterator, bool>> res;
 
   (res.push_back(insert(std::forward<Args>(args))), ...);
@@ -242,42 +624,70 @@ s21::map<K, T, Compare, Extract>::insert_many(Args &&...args) {
   return res;
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator>(const map<K, T, Compare, Extract> &lhs,
-               const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator>(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator>=(const map<K, T, Compare, Extract> &lhs,
-                const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator>=(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator<(const map<K, T, Compare, Extract> &lhs,
-               const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator<(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator<=(const map<K, T, Compare, Extract> &lhs,
-                const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator<=(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator==(const map<K, T, Compare, Extract> &lhs,
-                const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator==(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::is_equal(lhs, rhs);
 }
 
-template <typename K, typename T, class Compare, class Extract>
-bool operator!=(const map<K, T, Compare, Extract> &lhs,
-                const map<K, T, Compare, Extract> &rhs) {
+template <typename K, typename T, class Compare, class Extract, bool Indexed,
+          class Alloc, bool Threaded>
+bool operator!=(
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const map<K, T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return !s21::is_equal(lhs, rhs);
 }
 
+template <typename K, typename T>
+using indexed_map =
+    map<K, T, s21::Compare<K, T>, s21::KeyExtract<K, T>, true>;
+
+/*Iterators follow in-order links kept in every node, at the cost of two
+  pointers per node*/
+template <typename K, typename T>
+using threaded_map =
+    map<K, T, s21::Compare<K, T>, s21::KeyExtract<K, T>, false,
+        s21::pool_allocator<std::pair<K, T>>, true>;
+
+/*Copies share one map until one of them is written to, which then copies
+  the whole map*/
+template <typename K, typename T>
+using cow_map = cow<map<K, T>>;
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
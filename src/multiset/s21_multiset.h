@@ -4,13 +4,15 @@
 #include <initializer_list>
 
 #include "../RBtree/s21_RBtree.h"
+#include "../cow/s21_cow.h"
 #include "../helper/helper.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
 
 template <typename T, class Extract = s21::KeyExtract<T, T>,
-          class Compare = s21::Compare<T, T>>
+          class Compare = s21::Compare<T, T>, bool Indexed = false,
+          class Alloc = s21::pool_allocator<T>, bool Threaded = false>
 class multiset {
  public:
   using key_type = T;
@@ -18,12 +20,17 @@ class multiset {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
-  using Container = RBTree<T, T, Compare, Extract>;
+  using allocator_type = Alloc;
+  using Container = RBTree<T, T, Compare, Extract, Indexed, Alloc, Threaded>;
 
   multiset() : multiset_() {};
-  multiset(std::initializer_list<value_type> const &items) {
-    for (const auto &i : items) insert(i);
-  };
+  explicit multiset(const allocator_type &alloc) : multiset_(alloc) {}
+  multiset(std::initializer_list<value_type> const &items)
+      : multiset(items.begin(), items.end()) {}
+  template <typename InputIt>
+  multiset(InputIt first, InputIt last) : multiset_() {
+    multiset_.insert_equal(first, last);
+  }
   multiset(const multiset &ms) : multiset_(ms.multiset_) {};
   multiset(multiset &&ms) : multiset_{std::move(ms.multiset_)} {};
   ~multiset() {};
@@ -43,6 +50,7 @@ class multiset {
   }
   using iterator = typename Container::iterator;
   using const_iterator = typename Container::const_iterator;
+  using node_type = typename Container::node_handle;
 
   iterator begin() { return iterator(multiset_.begin()); }
   const_iterator begin() const noexcept {
@@ -56,38 +64,179 @@ class multiset {
   const_iterator cbegin() { return const_iterator(multiset_.cbegin()); }
   const_iterator cend() { return const_iterator(multiset_.cend()); }
 
-  bool empty() { return multiset_.empty(); }
-  size_type size() { return multiset_.size(); }
-  size_type max_size() { return multiset_.max_size(); }
+  bool empty() const noexcept { return multiset_.empty(); }
+  size_type size() const noexcept { return multiset_.size(); }
+  size_type max_size() const { return multiset_.max_size(); }
+  allocator_type get_allocator() const noexcept {
+    return multiset_.get_allocator();
+  }
 
   void clear() { multiset_.clear(); }
+  /*Ordered input is linked up in O(n), anything else is inserted one by
+    one*/
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    multiset_.clear();
+    multiset_.insert_equal(first, last);
+  }
 
   iterator insert(const value_type &value) {
     return multiset_.insert_equal(value);
   }
+  iterator insert(value_type &&value) {
+    return multiset_.insert_equal(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return multiset_.insert_hint_equal(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return multiset_.insert_hint_equal(hint, std::move(value));
+  }
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return multiset_.emplace_equal(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return multiset_.emplace_hint_equal(hint, std::forward<Args>(args)...);
+  }
+
+  iterator insert(node_type &&nh) {
+    return multiset_.insert_equal(std::move(nh));
+  }
+  node_type extract(const_iterator pos) { return multiset_.extract(pos); }
+  node_type extract(const key_type &key) {
+    return multiset_.extract_key(key);
+  }
 
   void erase(iterator pos) { multiset_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return multiset_.erase(first, last);
+  }
+  size_type erase(const key_type &key) { return multiset_.erase_key(key); }
+  template <typename Pred>
+  size_type erase_if(Pred pred) {
+    return multiset_.erase_if(pred);
+  }
   void swap(multiset &other) { multiset_.swap(other.multiset_); }
-  void merge(multiset &other) { multiset_.merge_unique(other.multiset_); }
+  void merge(multiset &other) { multiset_.merge_equal(other.multiset_); }
+  /*Moves the values from key on into the returned multiset. Costs O(log n)
+    plus the number of values moved*/
+  multiset split(const key_type &key) {
+    multiset greater;
+    greater.multiset_ = multiset_.split(key);
+    return greater;
+  }
+  /*Appends other, none of whose values may order before ours; throws
+    std::invalid_argument otherwise. Costs O(log n) plus the size of the
+    smaller one*/
+  void join(multiset &other) { multiset_.join_equal(other.multiset_); }
 
-  size_type count(const T &key) {
+  size_type count(const T &key) const {
     return multiset_.count(key);
   };  // количество определенных ключей
   iterator find(const T &key) {
     return multiset_.search(key);
   };  // находит элемент с определенным ключом
-  bool contains(const T &key) {
+  const_iterator find(const T &key) const { return multiset_.search(key); }
+  bool contains(const T &key) const {
     return multiset_.contains(key);
   };  // проверяет, содержит ли контейнер элемент с определенным ключом
   std::pair<iterator, iterator> equal_range(const T &key) {
     return multiset_.equal_range(key);
   };  // возвращает диапазон элементов, соответствующих определенному ключу
+  std::pair<const_iterator, const_iterator> equal_range(const T &key) const {
+    return multiset_.equal_range(key);
+  };
   iterator lower_bound(const T &key) {
     return multiset_.lower_bound(key);
   };  // возвращает итератор к первому элементу не меньше заданного ключа
+  const_iterator lower_bound(const T &key) const {
+    return multiset_.lower_bound(key);
+  };
   iterator upper_bound(const T &key) {
     return multiset_.upper_bound(key);
   };  // возвращает итератор к первому элементу, большему, чем заданный ключ
+  const_iterator upper_bound(const T &key) const {
+    return multiset_.upper_bound(key);
+  };
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const Key &key) const {
+    return multiset_.count(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key) {
+    return multiset_.search(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key &key) const {
+    return multiset_.search(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const {
+    return multiset_.contains(key);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    return multiset_.find_many(first, last, out);
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    return multiset_.contains_many(first, last, out);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return multiset_.equal_range(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+    return multiset_.equal_range(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const Key &key) {
+    return multiset_.lower_bound(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const Key &key) const {
+    return multiset_.lower_bound(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const Key &key) {
+    return multiset_.upper_bound(key);
+  }
+
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const Key &key) const {
+    return multiset_.upper_bound(key);
+  }
+
+  size_type rank(const T &key) const { return multiset_.rank(key); }
+  iterator select(size_type k) { return multiset_.select(k); }
+  const_iterator select(size_type k) const { return multiset_.select(k); }
+  size_type distance(const_iterator first, const_iterator last) const {
+    return multiset_.distance(first, last);
+  }
 
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
@@ -96,47 +245,205 @@ class multiset {
               std::make_pair(insert(std::forward<Args>(args)), true))));
     return results;
   }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last, thread_pool &pool) {
+    multiset_.insert_equal(first, last, pool);
+  }
+
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_union(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_union(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_intersection(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_intersection(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_difference(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_difference(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_symmetric_difference(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend multiset<U, E, C, I, A, Th> set_symmetric_difference(
+      const multiset<U, E, C, I, A, Th> &lhs,
+      const multiset<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
 
  private:
   Container multiset_;
 };
 
-template <typename T, class Compare, class Extract>
-bool operator>(const multiset<T, Compare, Extract> &lhs,
-               const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator>(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator>=(const multiset<T, Compare, Extract> &lhs,
-                const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator>=(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator<(const multiset<T, Compare, Extract> &lhs,
-               const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator<(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator<=(const multiset<T, Compare, Extract> &lhs,
-                const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator<=(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator==(const multiset<T, Compare, Extract> &lhs,
-                const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator==(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::is_equal(lhs, rhs);
 }
 
-template <typename T, class Compare, class Extract>
-bool operator!=(const multiset<T, Compare, Extract> &lhs,
-                const multiset<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator!=(
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return !s21::is_equal(lhs, rhs);
 }
 
+/*Results are built in bulk; RBTree::assign_union describes the cost*/
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_union(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_union(lhs.multiset_, rhs.multiset_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_intersection(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_intersection(lhs.multiset_, rhs.multiset_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_difference(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_difference(lhs.multiset_, rhs.multiset_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded>
+set_symmetric_difference(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_symmetric_difference(lhs.multiset_, rhs.multiset_);
+  return result;
+}
+
+/*Computed on pool; RBTree::assign_union(a, b, pool) describes how*/
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_union(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_union(lhs.multiset_, rhs.multiset_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_intersection(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_intersection(lhs.multiset_, rhs.multiset_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded> set_difference(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_difference(lhs.multiset_, rhs.multiset_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+multiset<T, Extract, Compare, Indexed, Alloc, Threaded>
+set_symmetric_difference(
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const multiset<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  multiset<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.multiset_.assign_symmetric_difference(lhs.multiset_, rhs.multiset_,
+                                               pool);
+  return result;
+}
+
+template <typename T>
+using indexed_multiset =
+    multiset<T, s21::KeyExtract<T, T>, s21::Compare<T, T>, true>;
+
+/*Iterators follow in-order links kept in every node, at the cost of two
+  pointers per node*/
+template <typename T>
+using threaded_multiset =
+    multiset<T, s21::KeyExtract<T, T>, s21::Compare<T, T>, false,
+             s21::pool_allocator<T>, true>;
+
+/*Copies share one multiset until one of them is written to, which then copies
+  the whole multiset*/
+template <typename T>
+using cow_multiset = cow<multiset<T>>;
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
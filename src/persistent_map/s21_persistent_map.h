@@ -0,0 +1,307 @@
+#ifndef CPP_S21_CONTAINERS_PERSISTENT_MAP_S21_PERSISTENT_MAP_H
+#define CPP_S21_CONTAINERS_PERSISTENT_MAP_S21_PERSISTENT_MAP_H
+
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../helper/helper.h"
+#include "../persistent_tree/s21_persistent_tree.h"
+
+namespace s21 {
+/*Map whose every version stays as it was. insert, insert_or_assign and
+  erase leave the map alone and return the new version, which shares all
+  but O(log n) nodes with it; copying a version is O(1). A version can be
+  read from any number of threads without locks while others are made from
+  it*/
+template <typename K, typename T, class Compare = s21::Compare<K, T>,
+          class Extract = s21::KeyExtract<K, T>,
+          class Alloc = std::allocator<std::pair<K, T>>>
+class persistent_map {
+ public:
+  using key_type = K;
+  using mapped_value = T;
+  using value_type = std::pair<K, T>;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+  using Container =
+      s21::PersistentTree<K, std::pair<K, T>, Compare, Extract, Alloc>;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  persistent_map();
+  explicit persistent_map(const allocator_type &alloc);
+  persistent_map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  persistent_map(InputIt first, InputIt last);
+  persistent_map(const persistent_map &m) noexcept;
+  persistent_map(persistent_map &&m) noexcept;
+  ~persistent_map();
+
+  persistent_map &operator=(const persistent_map &m) noexcept;
+  persistent_map &operator=(persistent_map &&m) noexcept;
+
+  const T &at(const key_type &k) const;
+  const T &operator[](const key_type &k) const;
+
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
+
+  persistent_map insert(const value_type &value) const;
+  persistent_map insert(value_type &&value) const;
+  template <typename InputIt>
+  persistent_map insert(InputIt first, InputIt last) const;
+  persistent_map insert_or_assign(const key_type &key,
+                                  const mapped_value &obj) const;
+  persistent_map erase(const key_type &key) const;
+  persistent_map clear() const;
+  void swap(persistent_map &other) noexcept;
+
+  const_iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const noexcept;
+  size_type count(const key_type &key) const noexcept;
+  const_iterator lower_bound(const key_type &key) const;
+  const_iterator upper_bound(const key_type &key) const;
+
+ private:
+  Container map_;
+};
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map() : map_() {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map(
+    const allocator_type &alloc)
+    : map_(alloc) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map(
+    std::initializer_list<value_type> const &items)
+    : persistent_map(items.begin(), items.end()) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename InputIt>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map(InputIt first,
+                                                              InputIt last)
+    : persistent_map() {
+  map_.insert_unique(first, last);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map(
+    const persistent_map &m) noexcept
+    : map_(m.map_) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::persistent_map(
+    persistent_map &&m) noexcept
+    : map_(std::move(m.map_)) {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::~persistent_map() {}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc> &
+persistent_map<K, T, Compare, Extract, Alloc>::operator=(
+    const persistent_map &m) noexcept {
+  map_ = m.map_;
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc> &
+persistent_map<K, T, Compare, Extract, Alloc>::operator=(
+    persistent_map &&m) noexcept {
+  map_ = std::move(m.map_);
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+const T &persistent_map<K, T, Compare, Extract, Alloc>::at(
+    const key_type &k) const {
+  const value_type *found = map_.find_value(k);
+
+  if (found == nullptr) {
+    throw std::out_of_range("persistent_map::at: key not found");
+  }
+
+  return found->second;
+}
+
+/*Read only: a version never changes, so there is nothing to default
+  construct into*/
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+const T &persistent_map<K, T, Compare, Extract, Alloc>::operator[](
+    const key_type &k) const {
+  return at(k);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::begin() const noexcept {
+  return map_.begin();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::cbegin() const noexcept {
+  return map_.cbegin();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::end() const noexcept {
+  return map_.end();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::cend() const noexcept {
+  return map_.cend();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool persistent_map<K, T, Compare, Extract, Alloc>::empty() const noexcept {
+  return map_.empty();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::size_type
+persistent_map<K, T, Compare, Extract, Alloc>::size() const noexcept {
+  return map_.size();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::size_type
+persistent_map<K, T, Compare, Extract, Alloc>::max_size() const {
+  return map_.max_size();
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::allocator_type
+persistent_map<K, T, Compare, Extract, Alloc>::get_allocator()
+    const noexcept {
+  return map_.get_allocator();
+}
+
+/*A version with value added, or this one again if its key is taken*/
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::insert(
+    const value_type &value) const {
+  persistent_map next(*this);
+  next.map_.insert_unique(value);
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::insert(
+    value_type &&value) const {
+  persistent_map next(*this);
+  next.map_.insert_unique(std::move(value));
+  return next;
+}
+
+/*The nodes the batch adds belong to the new version alone, so only the
+  first insert of a path copies it*/
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+template <typename InputIt>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::insert(InputIt first,
+                                                      InputIt last) const {
+  persistent_map next(*this);
+  next.map_.insert_unique(first, last);
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::insert_or_assign(
+    const key_type &key, const mapped_value &obj) const {
+  persistent_map next(*this);
+  next.map_.insert_or_assign(value_type(key, obj));
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::erase(
+    const key_type &key) const {
+  persistent_map next(*this);
+  next.map_.erase_key(key);
+  return next;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>
+persistent_map<K, T, Compare, Extract, Alloc>::clear() const {
+  return persistent_map(get_allocator());
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+void persistent_map<K, T, Compare, Extract, Alloc>::swap(
+    persistent_map &other) noexcept {
+  map_.swap(other.map_);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::find(
+    const key_type &key) const {
+  return map_.search(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool persistent_map<K, T, Compare, Extract, Alloc>::contains(
+    const key_type &key) const noexcept {
+  return map_.contains(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::size_type
+persistent_map<K, T, Compare, Extract, Alloc>::count(
+    const key_type &key) const noexcept {
+  return map_.contains(key) ? 1 : 0;
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::lower_bound(
+    const key_type &key) const {
+  return map_.lower_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+typename persistent_map<K, T, Compare, Extract, Alloc>::const_iterator
+persistent_map<K, T, Compare, Extract, Alloc>::upper_bound(
+    const key_type &key) const {
+  return map_.upper_bound(key);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator==(const persistent_map<K, T, Compare, Extract, Alloc> &lhs,
+                const persistent_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename K, typename T, class Compare, class Extract, class Alloc>
+bool operator!=(const persistent_map<K, T, Compare, Extract, Alloc> &lhs,
+                const persistent_map<K, T, Compare, Extract, Alloc> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef CPP_S21_CONTAINERS_PERSISTENT_SET_S21_PERSISTENT_SET_H
+#define CPP_S21_CONTAINERS_PERSISTENT_SET_S21_PERSISTENT_SET_H
+
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "../helper/helper.h"
+#include "../persistent_tree/s21_persistent_tree.h"
+
+namespace s21 {
+/*Set whose every version stays as it was; see persistent_map*/
+template <typename T, class Extract = s21::KeyExtract<T, T>,
+          class Compare = s21::Compare<T, T>, class Alloc = std::allocator<T>>
+class persistent_set {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using reference = const T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+  using Container = PersistentTree<T, T, Compare, Extract, Alloc>;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  persistent_set() : set_() {}
+  explicit persistent_set(const allocator_type &alloc) : set_(alloc) {}
+  persistent_set(std::initializer_list<value_type> const &items)
+      : persistent_set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  persistent_set(InputIt first, InputIt last) : set_() {
+    set_.insert_unique(first, last);
+  }
+  persistent_set(const persistent_set &s) noexcept : set_(s.set_) {}
+  persistent_set(persistent_set &&s) noexcept : set_(std::move(s.set_)) {}
+  ~persistent_set() {}
+
+  persistent_set &operator=(const persistent_set &other) noexcept {
+    set_ = other.set_;
+    return *this;
+  }
+  persistent_set &operator=(persistent_set &&s) noexcept {
+    set_ = std::move(s.set_);
+    return *this;
+  }
+
+  const_iterator begin() const noexcept { return set_.begin(); }
+  const_iterator end() const noexcept { return set_.end(); }
+  const_iterator cbegin() const noexcept { return set_.cbegin(); }
+  const_iterator cend() const noexcept { return set_.cend(); }
+
+  bool empty() const noexcept { return set_.empty(); }
+  size_type size() const noexcept { return set_.size(); }
+  size_type max_size() const { return set_.max_size(); }
+  allocator_type get_allocator() const noexcept {
+    return set_.get_allocator();
+  }
+
+  /*Each returns the new version and leaves this one as it is*/
+  persistent_set insert(const value_type &value) const {
+    persistent_set next(*this);
+    next.set_.insert_unique(value);
+    return next;
+  }
+  persistent_set insert(value_type &&value) const {
+    persistent_set next(*this);
+    next.set_.insert_unique(std::move(value));
+    return next;
+  }
+  template <typename InputIt>
+  persistent_set insert(InputIt first, InputIt last) const {
+    persistent_set next(*this);
+    next.set_.insert_unique(first, last);
+    return next;
+  }
+  persistent_set erase(const key_type &key) const {
+    persistent_set next(*this);
+    next.set_.erase_key(key);
+    return next;
+  }
+  persistent_set clear() const { return persistent_set(get_allocator()); }
+  void swap(persistent_set &other) noexcept { set_.swap(other.set_); }
+
+  const_iterator find(const T &key) const { return set_.search(key); }
+  bool contains(const T &key) const noexcept { return set_.contains(key); }
+  size_type count(const T &key) const noexcept {
+    return set_.contains(key) ? 1 : 0;
+  }
+  const_iterator lower_bound(const T &key) const {
+    return set_.lower_bound(key);
+  }
+  const_iterator upper_bound(const T &key) const {
+    return set_.upper_bound(key);
+  }
+
+ private:
+  Container set_;
+};
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator==(const persistent_set<T, Extract, Compare, Alloc> &lhs,
+                const persistent_set<T, Extract, Compare, Alloc> &rhs) {
+  return s21::is_equal(lhs, rhs);
+}
+
+template <typename T, class Extract, class Compare, class Alloc>
+bool operator!=(const persistent_set<T, Extract, Compare, Alloc> &lhs,
+                const persistent_set<T, Extract, Compare, Alloc> &rhs) {
+  return !s21::is_equal(lhs, rhs);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,997 @@
+#ifndef CPP_S21_CONTAINERS_PERSISTENT_TREE_S21_PERSISTENT_TREE_H
+#define CPP_S21_CONTAINERS_PERSISTENT_TREE_S21_PERSISTENT_TREE_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "../helper/helper.h"
+
+namespace s21 {
+/*Red-black tree behind persistent_map and persistent_set. Nodes have no
+  parent links and are counted by the links and versions that hold them, so
+  a copy of the tree is a new version sharing every node. A change copies
+  the nodes it touches while another version still holds them, which is the
+  path from the root and the few siblings rebalancing repaints or rotates,
+  and changes the nodes only this version holds in place. Shared nodes are
+  never written, so other threads may read the versions they hold without
+  locks; Alloc has to be safe to call from any thread, since the last
+  version holding a node frees it*/
+template <typename K, typename T, class Compare, class Extracter,
+          class Alloc = std::allocator<T>>
+class PersistentTree {
+  struct Node;
+
+  using node_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+ public:
+  class PersistentIterator;
+
+  using key_type = K;
+  using value_type = T;
+  using size_type = size_t;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = PersistentIterator;
+  using const_iterator = PersistentIterator;
+  using allocator_type = Alloc;
+
+  /*Deepest a red-black tree of any size that fits in memory gets*/
+  static constexpr size_type kMaxDepth =
+      2 * std::numeric_limits<size_type>::digits;
+
+  /*Keeps the path from the root, which takes the place of parent links*/
+  class PersistentIterator {
+    friend class PersistentTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = PersistentTree::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    PersistentIterator() noexcept;
+    PersistentIterator(const PersistentIterator &other) noexcept;
+    PersistentIterator &operator=(const PersistentIterator &other) noexcept;
+
+    iterator &operator++() noexcept;
+    iterator operator++(int) noexcept;
+    iterator &operator--() noexcept;
+    iterator operator--(int) noexcept;
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+
+   private:
+    const Node *root_;
+    size_type depth_;
+    const Node *path_[kMaxDepth];
+
+    explicit PersistentIterator(const Node *root) noexcept;
+    void CopyPath(const PersistentIterator &other) noexcept;
+    const Node *Current() const noexcept;
+    void Descend(const Node *node, bool left) noexcept;
+  };
+
+  PersistentTree();
+  explicit PersistentTree(const allocator_type &alloc);
+  PersistentTree(const PersistentTree &other) noexcept;
+  PersistentTree(PersistentTree &&other) noexcept;
+  ~PersistentTree();
+
+  PersistentTree &operator=(const PersistentTree &other) noexcept;
+  PersistentTree &operator=(PersistentTree &&other) noexcept;
+
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const;
+  allocator_type get_allocator() const noexcept;
+
+  void clear() noexcept;
+  template <typename V>
+  bool insert_unique(V &&val);
+  template <typename InputIt>
+  void insert_unique(InputIt first, InputIt last);
+  template <typename V>
+  bool insert_or_assign(V &&val);
+  template <typename Key>
+  size_type erase_key(const Key &key);
+  void swap(PersistentTree &other) noexcept;
+
+  template <typename Key>
+  const_iterator search(const Key &key) const noexcept;
+  template <typename Key>
+  const value_type *find_value(const Key &key) const noexcept;
+  template <typename Key>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key>
+  const_iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key>
+  const_iterator upper_bound(const Key &key) const noexcept;
+
+ private:
+  typedef enum { RED, BLACK } color_t;
+
+  struct Node {
+    template <typename... Args>
+    explicit Node(Args &&...args)
+        : refs_(1),
+          left_child_(nullptr),
+          right_child_(nullptr),
+          color_(RED),
+          key_(std::forward<Args>(args)...) {}
+
+    std::atomic<size_type> refs_;
+    Node *left_child_;
+    Node *right_child_;
+    color_t color_;
+    value_type key_;
+  };
+
+  Node *root_;
+  size_type tree_size_;
+  Compare comp_;
+  Extracter extracter_;
+  node_allocator alloc_;
+
+  template <typename... Args>
+  Node *CreateNode(Args &&...args);
+  void DestroyNode(Node *node) noexcept;
+  static Node *Share(Node *node) noexcept;
+  void Release(Node *node) noexcept;
+  Node *Own(Node *&link);
+  template <typename V>
+  void Replace(Node *&link, V &&val);
+
+  template <typename Key>
+  Node *FindNode(const Key &key) const noexcept;
+  static bool IsRed(const Node *node) noexcept;
+  static Node *&ChildLink(Node *parent, const Node *child) noexcept;
+  static void LeftRotate(Node *&link) noexcept;
+  static void RightRotate(Node *&link) noexcept;
+  Node *&ParentLink(Node **path, size_type depth) noexcept;
+  void RebalanceInsert(Node **path, size_type depth, Node *node);
+  void RebalanceDelete(Node **path, size_type depth, Node *x);
+};
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::PersistentIterator() noexcept
+    : root_(nullptr), depth_(0) {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+    PersistentIterator(const PersistentIterator &other) noexcept {
+  CopyPath(other);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::iterator &
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+operator=(const PersistentIterator &other) noexcept {
+  CopyPath(other);
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+    PersistentIterator(const Node *root) noexcept
+    : root_(root), depth_(0) {}
+
+/*Only the part of the path in use is copied*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+    CopyPath(const PersistentIterator &other) noexcept {
+  root_ = other.root_;
+  depth_ = other.depth_;
+
+  for (size_type i = 0; i < depth_; ++i) {
+    path_[i] = other.path_[i];
+  }
+}
+
+/*Next in order: the leftmost node of the right subtree, or else the nearest
+  ancestor reached from its left*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::iterator &
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator++() noexcept {
+  const Node *node = Current();
+
+  if (node == nullptr) {
+    return *this;
+  }
+
+  if (node->right_child_ != nullptr) {
+    Descend(node->right_child_, true);
+    return *this;
+  }
+
+  const Node *child = nullptr;
+
+  do {
+    child = path_[--depth_];
+  } while (depth_ > 0 && path_[depth_ - 1]->right_child_ == child);
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::iterator
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator++(int) noexcept {
+  iterator tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+/*Stepping back from end lands on the rightmost node*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::iterator &
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator--() noexcept {
+  const Node *node = Current();
+
+  if (node == nullptr) {
+    if (root_ != nullptr) {
+      Descend(root_, false);
+    }
+
+    return *this;
+  }
+
+  if (node->left_child_ != nullptr) {
+    Descend(node->left_child_, false);
+    return *this;
+  }
+
+  const Node *child = nullptr;
+
+  do {
+    child = path_[--depth_];
+  } while (depth_ > 0 && path_[depth_ - 1]->left_child_ == child);
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::iterator
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator--(int) noexcept {
+  iterator tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_reference
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator*() const noexcept {
+  return Current()->key_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+const typename PersistentTree<K, T, Compare, Extracter, Alloc>::value_type *
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::operator->() const noexcept {
+  return &Current()->key_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+operator==(const iterator &other) const noexcept {
+  return Current() == other.Current();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentIterator::
+operator!=(const iterator &other) const noexcept {
+  return Current() != other.Current();
+}
+
+/*nullptr stands for end*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+const typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *
+PersistentTree<K, T, Compare, Extracter,
+               Alloc>::PersistentIterator::Current() const noexcept {
+  return depth_ > 0 ? path_[depth_ - 1] : nullptr;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter,
+                    Alloc>::PersistentIterator::Descend(const Node *node,
+                                                        bool left) noexcept {
+  while (node != nullptr) {
+    path_[depth_++] = node;
+    node = left ? node->left_child_ : node->right_child_;
+  }
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentTree()
+    : root_(nullptr), tree_size_(0), comp_(), extracter_(), alloc_() {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentTree(
+    const allocator_type &alloc)
+    : root_(nullptr),
+      tree_size_(0),
+      comp_(),
+      extracter_(),
+      alloc_(alloc) {}
+
+/*A new version of the same tree; no node is copied until one of the two
+  changes*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentTree(
+    const PersistentTree &other) noexcept
+    : root_(Share(other.root_)),
+      tree_size_(other.tree_size_),
+      comp_(other.comp_),
+      extracter_(other.extracter_),
+      alloc_(other.alloc_) {}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::PersistentTree(
+    PersistentTree &&other) noexcept
+    : root_(other.root_),
+      tree_size_(other.tree_size_),
+      comp_(other.comp_),
+      extracter_(other.extracter_),
+      alloc_(other.alloc_) {
+  other.root_ = nullptr;
+  other.tree_size_ = 0;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc>::~PersistentTree() {
+  Release(root_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc> &
+PersistentTree<K, T, Compare, Extracter, Alloc>::operator=(
+    const PersistentTree &other) noexcept {
+  Node *root = Share(other.root_);
+  Release(root_);
+  root_ = root;
+  tree_size_ = other.tree_size_;
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+PersistentTree<K, T, Compare, Extracter, Alloc> &
+PersistentTree<K, T, Compare, Extracter, Alloc>::operator=(
+    PersistentTree &&other) noexcept {
+  if (this != &other) {
+    Release(root_);
+    root_ = other.root_;
+    tree_size_ = other.tree_size_;
+
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    }
+
+    other.root_ = nullptr;
+    other.tree_size_ = 0;
+  }
+
+  return *this;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::begin() const noexcept {
+  const_iterator it(root_);
+  it.Descend(root_, true);
+  return it;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::cbegin() const noexcept {
+  return begin();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::end() const noexcept {
+  return const_iterator(root_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::cend() const noexcept {
+  return end();
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::empty() const noexcept {
+  return tree_size_ == 0;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::size_type
+PersistentTree<K, T, Compare, Extracter, Alloc>::size() const noexcept {
+  return tree_size_;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::size_type
+PersistentTree<K, T, Compare, Extracter, Alloc>::max_size() const {
+  return node_traits::max_size(alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::allocator_type
+PersistentTree<K, T, Compare, Extracter, Alloc>::get_allocator()
+    const noexcept {
+  return allocator_type(alloc_);
+}
+
+/*Only drops this version; nodes other versions hold stay*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::clear() noexcept {
+  Release(root_);
+  root_ = nullptr;
+  tree_size_ = 0;
+}
+
+/*The key is looked for first, so a value already there costs no copies*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename V>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::insert_unique(V &&val) {
+  const key_type &key = extracter_(val);
+
+  if (FindNode(key) != nullptr) {
+    return false;
+  }
+
+  Node *path[kMaxDepth];
+  size_type depth = 0;
+  Node **link = &root_;
+
+  while (*link != nullptr) {
+    Node *node = Own(*link);
+    path[depth++] = node;
+    link = comp_(key, extracter_(node->key_)) ? &node->left_child_
+                                              : &node->right_child_;
+  }
+
+  Node *node = CreateNode(std::forward<V>(val));
+  *link = node;
+  ++tree_size_;
+  RebalanceInsert(path, depth, node);
+
+  return true;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename InputIt>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::insert_unique(
+    InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    insert_unique(*first);
+  }
+}
+
+/*Returns true when val was added and false when it replaced the value with
+  its key*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename V>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::insert_or_assign(
+    V &&val) {
+  const key_type &key = extracter_(val);
+
+  if (FindNode(key) == nullptr) {
+    return insert_unique(std::forward<V>(val));
+  }
+
+  Node **link = &root_;
+
+  for (;;) {
+    Node *node = *link;
+
+    if (comp_(key, extracter_(node->key_))) {
+      link = &Own(*link)->left_child_;
+
+    } else if (comp_(extracter_(node->key_), key)) {
+      link = &Own(*link)->right_child_;
+
+    } else {
+      break;
+    }
+  }
+
+  Replace(*link, std::forward<V>(val));
+
+  return false;
+}
+
+/*The node taken out is the one holding key, or its successor when it has
+  two children; either way the removed color decides the rebalancing, as in
+  RBTree::EraseHandler*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::size_type
+PersistentTree<K, T, Compare, Extracter, Alloc>::erase_key(const Key &key) {
+  if (FindNode(key) == nullptr) {
+    return 0;
+  }
+
+  Node *path[kMaxDepth];
+  size_type depth = 0;
+  Node **link = &root_;
+
+  for (;;) {
+    Node *node = Own(*link);
+
+    if (comp_(key, extracter_(node->key_))) {
+      link = &node->left_child_;
+
+    } else if (comp_(extracter_(node->key_), key)) {
+      link = &node->right_child_;
+
+    } else {
+      break;
+    }
+
+    path[depth++] = node;
+  }
+
+  Node *target = *link;
+  Node *x = nullptr;
+  color_t removed = target->color_;
+
+  if (target->left_child_ == nullptr || target->right_child_ == nullptr) {
+    x = target->left_child_ != nullptr ? target->left_child_
+                                       : target->right_child_;
+    *link = x;
+
+  } else {
+    size_type target_depth = depth;
+    path[depth++] = target;
+    Node **successor_link = &target->right_child_;
+
+    while ((*successor_link)->left_child_ != nullptr) {
+      Node *node = Own(*successor_link);
+      path[depth++] = node;
+      successor_link = &node->left_child_;
+    }
+
+    Node *successor = Own(*successor_link);
+    removed = successor->color_;
+    x = successor->right_child_;
+
+    if (successor_link != &target->right_child_) {
+      *successor_link = x;
+      successor->right_child_ = target->right_child_;
+    }
+
+    successor->left_child_ = target->left_child_;
+    successor->color_ = target->color_;
+    path[target_depth] = successor;
+    *link = successor;
+  }
+
+  target->left_child_ = nullptr;
+  target->right_child_ = nullptr;
+  DestroyNode(target);
+  --tree_size_;
+
+  if (removed == BLACK) {
+    RebalanceDelete(path, depth, x);
+  }
+
+  return 1;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::swap(
+    PersistentTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(tree_size_, other.tree_size_);
+  std::swap(alloc_, other.alloc_);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::search(
+    const Key &key) const noexcept {
+  const_iterator it(root_);
+  const Node *node = root_;
+
+  while (node != nullptr) {
+    it.path_[it.depth_++] = node;
+
+    if (comp_(key, extracter_(node->key_))) {
+      node = node->left_child_;
+
+    } else if (comp_(extracter_(node->key_), key)) {
+      node = node->right_child_;
+
+    } else {
+      return it;
+    }
+  }
+
+  return end();
+}
+
+/*Lookup without building an iterator*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+const typename PersistentTree<K, T, Compare, Extracter, Alloc>::value_type *
+PersistentTree<K, T, Compare, Extracter, Alloc>::find_value(
+    const Key &key) const noexcept {
+  const Node *node = FindNode(key);
+  return node != nullptr ? &node->key_ : nullptr;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::contains(
+    const Key &key) const noexcept {
+  return FindNode(key) != nullptr;
+}
+
+/*The answer is the last node the search went left at, or matched, so the
+  path is cut back to it*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::lower_bound(
+    const Key &key) const noexcept {
+  const_iterator it(root_);
+  size_type found = 0;
+
+  for (const Node *node = root_; node != nullptr;) {
+    it.path_[it.depth_++] = node;
+
+    if (comp_(extracter_(node->key_), key)) {
+      node = node->right_child_;
+
+    } else {
+      found = it.depth_;
+      node = node->left_child_;
+    }
+  }
+
+  it.depth_ = found;
+  return it;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::const_iterator
+PersistentTree<K, T, Compare, Extracter, Alloc>::upper_bound(
+    const Key &key) const noexcept {
+  const_iterator it(root_);
+  size_type found = 0;
+
+  for (const Node *node = root_; node != nullptr;) {
+    it.path_[it.depth_++] = node;
+
+    if (comp_(key, extracter_(node->key_))) {
+      found = it.depth_;
+      node = node->left_child_;
+
+    } else {
+      node = node->right_child_;
+    }
+  }
+
+  it.depth_ = found;
+  return it;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename... Args>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *
+PersistentTree<K, T, Compare, Extracter, Alloc>::CreateNode(Args &&...args) {
+  Node *node = node_traits::allocate(alloc_, 1);
+
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+
+  return node;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::DestroyNode(
+    Node *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *
+PersistentTree<K, T, Compare, Extracter, Alloc>::Share(Node *node) noexcept {
+  if (node != nullptr) {
+    node->refs_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return node;
+}
+
+/*Drops one hold on node and frees what nothing holds any more. The right
+  spine is walked in a loop, so recursion only goes as deep as the tree*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::Release(
+    Node *node) noexcept {
+  while (node != nullptr &&
+         node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Release(node->left_child_);
+    Node *right = node->right_child_;
+    DestroyNode(node);
+    node = right;
+  }
+}
+
+/*Makes link, a link of a node only this version holds, point to a node only
+  this version holds, copying its node if another version holds it too. A
+  count of one cannot grow behind our back: only this version reaches the
+  node, and the acquire load pairs with the release of the versions that let
+  go of it*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *
+PersistentTree<K, T, Compare, Extracter, Alloc>::Own(Node *&link) {
+  Node *node = link;
+
+  if (node->refs_.load(std::memory_order_acquire) == 1) {
+    return node;
+  }
+
+  Node *copy = CreateNode(node->key_);
+  copy->color_ = node->color_;
+  copy->left_child_ = Share(node->left_child_);
+  copy->right_child_ = Share(node->right_child_);
+  link = copy;
+  Release(node);
+
+  return copy;
+}
+
+/*Puts a node holding val where link points, keeping the color and children
+  of the node it replaces*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename V>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::Replace(Node *&link,
+                                                              V &&val) {
+  Node *node = link;
+  Node *fresh = CreateNode(std::forward<V>(val));
+  fresh->color_ = node->color_;
+  fresh->left_child_ = Share(node->left_child_);
+  fresh->right_child_ = Share(node->right_child_);
+  link = fresh;
+  Release(node);
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+template <typename Key>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *
+PersistentTree<K, T, Compare, Extracter, Alloc>::FindNode(
+    const Key &key) const noexcept {
+  Node *node = root_;
+
+  while (node != nullptr) {
+    if (comp_(key, extracter_(node->key_))) {
+      node = node->left_child_;
+
+    } else if (comp_(extracter_(node->key_), key)) {
+      node = node->right_child_;
+
+    } else {
+      return node;
+    }
+  }
+
+  return nullptr;
+}
+
+/*Missing children count as black leaves*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+bool PersistentTree<K, T, Compare, Extracter, Alloc>::IsRed(
+    const Node *node) noexcept {
+  return node != nullptr && node->color_ == RED;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *&
+PersistentTree<K, T, Compare, Extracter, Alloc>::ChildLink(
+    Node *parent, const Node *child) noexcept {
+  return parent->left_child_ == child ? parent->left_child_
+                                      : parent->right_child_;
+}
+
+/*Both nodes rotated have to be held by this version alone*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::LeftRotate(
+    Node *&link) noexcept {
+  Node *x = link;
+  Node *y = x->right_child_;
+  x->right_child_ = y->left_child_;
+  y->left_child_ = x;
+  link = y;
+}
+
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::RightRotate(
+    Node *&link) noexcept {
+  Node *y = link;
+  Node *x = y->left_child_;
+  y->left_child_ = x->right_child_;
+  x->right_child_ = y;
+  link = x;
+}
+
+/*The link that holds path[depth - 1]*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+typename PersistentTree<K, T, Compare, Extracter, Alloc>::Node *&
+PersistentTree<K, T, Compare, Extracter, Alloc>::ParentLink(
+    Node **path, size_type depth) noexcept {
+  return depth > 1 ? ChildLink(path[depth - 2], path[depth - 1]) : root_;
+}
+
+/*RBTree::RebalanceInsert with path[depth - 1] as the parent of node and
+  the path standing in for parent links. The path is this version's own;
+  an uncle is copied before it is repainted*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::RebalanceInsert(
+    Node **path, size_type depth, Node *node) {
+  while (depth > 1 && IsRed(path[depth - 1])) {
+    Node *parent = path[depth - 1];
+    Node *grand = path[depth - 2];
+    Node *&grand_link = ParentLink(path, depth - 1);
+
+    if (parent == grand->left_child_) {
+      if (IsRed(grand->right_child_)) {
+        Node *uncle = Own(grand->right_child_);
+        parent->color_ = BLACK;
+        uncle->color_ = BLACK;
+        grand->color_ = RED;
+        node = grand;
+        depth -= 2;
+        continue;
+      }
+
+      if (node == parent->right_child_) {
+        LeftRotate(grand->left_child_);
+        std::swap(node, parent);
+      }
+
+      parent->color_ = BLACK;
+      grand->color_ = RED;
+      RightRotate(grand_link);
+
+    } else {
+      if (IsRed(grand->left_child_)) {
+        Node *uncle = Own(grand->left_child_);
+        parent->color_ = BLACK;
+        uncle->color_ = BLACK;
+        grand->color_ = RED;
+        node = grand;
+        depth -= 2;
+        continue;
+      }
+
+      if (node == parent->left_child_) {
+        RightRotate(grand->right_child_);
+        std::swap(node, parent);
+      }
+
+      parent->color_ = BLACK;
+      grand->color_ = RED;
+      LeftRotate(grand_link);
+    }
+
+    break;
+  }
+
+  root_->color_ = BLACK;
+}
+
+/*RBTree::RebalanceDelete with path[depth - 1] as the parent of x, which
+  may be a missing leaf. A parent rotated down below its sibling gets the
+  sibling as its new parent on the path; siblings and nephews are copied
+  before they are repainted or rotated*/
+template <typename K, typename T, class Compare, class Extracter, class Alloc>
+void PersistentTree<K, T, Compare, Extracter, Alloc>::RebalanceDelete(
+    Node **path, size_type depth, Node *x) {
+  while (depth > 0 && !IsRed(x)) {
+    Node *parent = path[depth - 1];
+
+    if (x == parent->left_child_) {
+      Node *sibling = Own(parent->right_child_);
+
+      if (IsRed(sibling)) {
+        sibling->color_ = BLACK;
+        parent->color_ = RED;
+        LeftRotate(ParentLink(path, depth));
+        path[depth - 1] = sibling;
+        path[depth++] = parent;
+        sibling = Own(parent->right_child_);
+      }
+
+      if (!IsRed(sibling->left_child_) && !IsRed(sibling->right_child_)) {
+        sibling->color_ = RED;
+        x = parent;
+        --depth;
+        continue;
+      }
+
+      if (!IsRed(sibling->right_child_)) {
+        Own(sibling->left_child_)->color_ = BLACK;
+        sibling->color_ = RED;
+        RightRotate(parent->right_child_);
+        sibling = parent->right_child_;
+      }
+
+      Own(sibling->right_child_)->color_ = BLACK;
+      sibling->color_ = parent->color_;
+      parent->color_ = BLACK;
+      LeftRotate(ParentLink(path, depth));
+
+    } else {
+      Node *sibling = Own(parent->left_child_);
+
+      if (IsRed(sibling)) {
+        sibling->color_ = BLACK;
+        parent->color_ = RED;
+        RightRotate(ParentLink(path, depth));
+        path[depth - 1] = sibling;
+        path[depth++] = parent;
+        sibling = Own(parent->left_child_);
+      }
+
+      if (!IsRed(sibling->left_child_) && !IsRed(sibling->right_child_)) {
+        sibling->color_ = RED;
+        x = parent;
+        --depth;
+        continue;
+      }
+
+      if (!IsRed(sibling->left_child_)) {
+        Own(sibling->right_child_)->color_ = BLACK;
+        sibling->color_ = RED;
+        LeftRotate(parent->left_child_);
+        sibling = parent->left_child_;
+      }
+
+      Own(sibling->left_child_)->color_ = BLACK;
+      sibling->color_ = parent->color_;
+      parent->color_ = BLACK;
+      RightRotate(ParentLink(path, depth));
+    }
+
+    return;
+  }
+
+  if (IsRed(x)) {
+    Node *&link = depth > 0 ? ChildLink(path[depth - 1], x) : root_;
+    Own(link)->color_ = BLACK;
+  }
+}
+
+}  // namespace s21
+
+#endif
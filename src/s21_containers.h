@@ -1,6 +1,10 @@
 #ifndef CPP_CONTAINERS_SRC_S21_CONTAINERS_H_
 #define CPP_CONTAINERS_SRC_S21_CONTAINERS_H_
 
+#include "btree_map/s21_btree_map.h"
+#include "btree_set/s21_btree_set.h"
+#include "flat_map/s21_flat_map.h"
+#include "flat_set/s21_flat_set.h"
 #include "list/s21_list.h"
 #include "map/s21_map.h"
 #include "queue/s21_queue.h"
@@ -1,7 +1,12 @@
-#ifndef CPP_CONTAINERS_SRC_S21_CONTAINERS_H_
-#define CPP_CONTAINERS_SRC_S21_CONTAINERS_H_
+#ifndef CPP_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
+#define CPP_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
 
 #include "array/s21_array.h"
+#include "btree_multiset/s21_btree_multiset.h"
+#include "concurrent_map/s21_concurrent_map.h"
+#include "cow/s21_cow.h"
 #include "multiset/s21_multiset.h"
+#include "persistent_map/s21_persistent_map.h"
+#include "persistent_set/s21_persistent_set.h"
 
 #endif
\ No newline at end of file
@@ -2,13 +2,15 @@
 #define CPP_S21_CONTAINERS_SET_S21_SET_H
 
 #include "../RBtree/s21_RBtree.h"
+#include "../cow/s21_cow.h"
 #include "../helper/helper.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
 
 template <typename T, class Extract = s21::KeyExtract<T, T>,
-          class Compare = s21::Compare<T, T>>
+          class Compare = s21::Compare<T, T>, bool Indexed = false,
+          class Alloc = s21::pool_allocator<T>, bool Threaded = false>
 class set {
  public:
   using key_type = T;
@@ -16,12 +18,17 @@ class set {
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
-  using Container = RBTree<T, T, Compare, Extract>;
+  using allocator_type = Alloc;
+  using Container = RBTree<T, T, Compare, Extract, Indexed, Alloc, Threaded>;
 
   set() : set_() {};
-  set(std::initializer_list<value_type> const &items) {
-    for (const auto &i : items) insert(i);
-  };
+  explicit set(const allocator_type &alloc) : set_(alloc) {}
+  set(std::initializer_list<value_type> const &items)
+      : set(items.begin(), items.end()) {}
+  template <typename InputIt>
+  set(InputIt first, InputIt last) : set_() {
+    set_.insert_unique(first, last);
+  }
   set(const set &s) : set_(s.set_) {};
   set(set &&s) : set_{std::move(s.set_)} {};
   ~set() {};
@@ -41,6 +48,8 @@ class set {
 
   using iterator = typename Container::iterator;
   using const_iterator = typename Container::const_iterator;
+  using node_type = typename Container::node_handle;
+  using insert_return_type = typename Container::insert_return_type;
 
   iterator begin() { return iterator(set_.begin()); }
   const_iterator begin() const noexcept { return const_iterator(set_.begin()); }
@@ -50,14 +59,41 @@ class set {
   const_iterator cbegin() { return const_iterator(set_.cbegin()); }
   const_iterator cend() { return const_iterator(set_.cend()); }
 
-  bool empty() { return set_.empty(); }
-  size_type size() { return set_.size(); }
-  size_type max_size() { return set_.max_size(); }
+  bool empty() const noexcept { return set_.empty(); }
+  size_type size() const noexcept { return set_.size(); }
+  size_type max_size() const { return set_.max_size(); }
+  allocator_type get_allocator() const noexcept {
+    return set_.get_allocator();
+  }
 
   void clear() { set_.clear(); }
+  /*Ordered input is linked up in O(n), anything else is inserted one by
+    one*/
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    set_.clear();
+    set_.insert_unique(first, last);
+  }
   std::pair<iterator, bool> insert(const value_type &value) {
     return set_.insert_unique(value);
   }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return set_.insert_unique(std::move(value));
+  }
+  iterator insert(const_iterator hint, const value_type &value) {
+    return set_.insert_hint_unique(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return set_.insert_hint_unique(hint, std::move(value));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return set_.emplace_unique(std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return set_.emplace_hint_unique(hint, std::forward<Args>(args)...);
+  }
 
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
@@ -65,54 +101,257 @@ class set {
     (results.push_back(insert(std::forward<Args>(args))), ...);
     return results;
   }
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last, thread_pool &pool) {
+    set_.insert_unique(first, last, pool);
+  }
+
+  insert_return_type insert(node_type &&nh) {
+    return set_.insert_unique(std::move(nh));
+  }
+  node_type extract(const_iterator pos) { return set_.extract(pos); }
+  node_type extract(const key_type &key) { return set_.extract_key(key); }
 
   void erase(iterator pos) { set_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return set_.erase(first, last);
+  }
+  size_type erase(const key_type &key) { return set_.erase_key(key); }
+  template <typename Pred>
+  size_type erase_if(Pred pred) {
+    return set_.erase_if(pred);
+  }
   void swap(set &other) { set_.swap(other.set_); }
   void merge(set &other) { set_.merge_unique(other.set_); }
+  /*Moves the values from key on into the returned set. Costs O(log n)
+    plus the number of values moved*/
+  set split(const key_type &key) {
+    set greater;
+    greater.set_ = set_.split(key);
+    return greater;
+  }
+  /*Appends other, every value of which has to order after ours; throws
+    std::invalid_argument otherwise. Costs O(log n) plus the size of the
+    smaller one*/
+  void join(set &other) { set_.join_unique(other.set_); }
 
   iterator find(const T &key) { return set_.search(key); }
-  bool contains(const T &key) { return set_.contains(key); }
+  const_iterator find(const T &key) const { return set_.search(key); }
+  bool contains(const T &key) const { return set_.contains(key); }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const Key &key) {
+    return set_.search(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const Key &key) const {
+    return set_.search(key);
+  }
+  template <typename Key, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const Key &key) const {
+    return set_.contains(key);
+  }
+  /*Look up a batch of keys at once; faster than one by one on big sets,
+    most of all when the keys come sorted*/
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    return set_.find_many(first, last, out);
+  }
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    return set_.contains_many(first, last, out);
+  }
+
+  size_type rank(const T &key) const { return set_.rank(key); }
+  iterator select(size_type k) { return set_.select(k); }
+  const_iterator select(size_type k) const { return set_.select(k); }
+  size_type distance(const_iterator first, const_iterator last) const {
+    return set_.distance(first, last);
+  }
+
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_union(const set<U, E, C, I, A, Th> &lhs,
+                                          const set<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_union(const set<U, E, C, I, A, Th> &lhs,
+                                          const set<U, E, C, I, A, Th> &rhs,
+                                          thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_intersection(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_intersection(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_difference(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_difference(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_symmetric_difference(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs);
+  template <typename U, class E, class C, bool I, class A, bool Th>
+  friend set<U, E, C, I, A, Th> set_symmetric_difference(
+      const set<U, E, C, I, A, Th> &lhs,
+      const set<U, E, C, I, A, Th> &rhs,
+      thread_pool &pool);
 
  private:
   Container set_;
 };
 
-template <typename T, class Compare, class Extract>
-bool operator>(const set<T, Compare, Extract> &lhs,
-               const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator>(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+               const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator>=(const set<T, Compare, Extract> &lhs,
-                const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator>=(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+                const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator<(const set<T, Compare, Extract> &lhs,
-               const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator<(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+               const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator<=(const set<T, Compare, Extract> &lhs,
-                const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator<=(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+                const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::lexicog_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, class Compare, class Extract>
-bool operator==(const set<T, Compare, Extract> &lhs,
-                const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator==(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+                const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return s21::is_equal(lhs, rhs);
 }
 
-template <typename T, class Compare, class Extract>
-bool operator!=(const set<T, Compare, Extract> &lhs,
-                const set<T, Compare, Extract> &rhs) {
+template <typename T, class Compare, class Extract, bool Indexed, class Alloc,
+          bool Threaded>
+bool operator!=(const set<T, Compare, Extract, Indexed, Alloc, Threaded> &lhs,
+                const set<T, Compare, Extract, Indexed, Alloc, Threaded> &rhs) {
   return !s21::is_equal(lhs, rhs);
 }
 
+/*Results are built in bulk; RBTree::assign_union describes the cost*/
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_union(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_union(lhs.set_, rhs.set_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_intersection(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_intersection(lhs.set_, rhs.set_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_difference(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_difference(lhs.set_, rhs.set_);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_symmetric_difference(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_symmetric_difference(lhs.set_, rhs.set_);
+  return result;
+}
+
+/*Computed on pool; RBTree::assign_union(a, b, pool) describes how*/
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_union(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_union(lhs.set_, rhs.set_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_intersection(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_intersection(lhs.set_, rhs.set_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_difference(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_difference(lhs.set_, rhs.set_, pool);
+  return result;
+}
+
+template <typename T, class Extract, class Compare, bool Indexed, class Alloc,
+          bool Threaded>
+set<T, Extract, Compare, Indexed, Alloc, Threaded> set_symmetric_difference(
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &lhs,
+    const set<T, Extract, Compare, Indexed, Alloc, Threaded> &rhs,
+    thread_pool &pool) {
+  set<T, Extract, Compare, Indexed, Alloc, Threaded> result;
+  result.set_.assign_symmetric_difference(lhs.set_, rhs.set_, pool);
+  return result;
+}
+
+template <typename T>
+using indexed_set = set<T, s21::KeyExtract<T, T>, s21::Compare<T, T>, true>;
+
+/*Iterators follow in-order links kept in every node, at the cost of two
+  pointers per node*/
+template <typename T>
+using threaded_set = set<T, s21::KeyExtract<T, T>, s21::Compare<T, T>, false,
+                         s21::pool_allocator<T>, true>;
+
+/*Copies share one set until one of them is written to, which then copies
+  the whole set*/
+template <typename T>
+using cow_set = cow<set<T>>;
+
 }  // namespace s21
 
 #endif
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+using std::string;
+
+/*Counts every heap allocation of the tester, so that tests can bound what
+  the containers ask the system for*/
+namespace {
+std::atomic<std::size_t> heap_allocations{0};
+std::atomic<std::size_t> heap_frees{0};
+}  // namespace
+
+void *operator new(std::size_t size) {
+  void *block = std::malloc(size != 0 ? size : 1);
+
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  ++heap_allocations;
+  return block;
+}
+
+void operator delete(void *block) noexcept {
+  if (block != nullptr) {
+    ++heap_frees;
+  }
+
+  std::free(block);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return ::operator new(size);
+
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void *block, std::size_t) noexcept {
+  ::operator delete(block);
+}
+
+void operator delete(void *block, const std::nothrow_t &) noexcept {
+  ::operator delete(block);
+}
+
+void operator delete[](void *block) noexcept { ::operator delete(block); }
+
+void operator delete[](void *block, std::size_t) noexcept {
+  ::operator delete(block);
+}
+
+namespace {
+std::size_t allocations = 0;
+
+std::size_t LiveHeapBlocks() { return heap_allocations - heap_frees; }
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() noexcept = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *block, std::size_t n) noexcept {
+    std::allocator<T>().deallocate(block, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+struct NoDefault {
+  explicit NoDefault(int value) : value_(value) {}
+
+  bool operator<(const NoDefault &other) const { return value_ < other.value_; }
+
+  int value_;
+};
+}  // namespace
+
+TEST(test_allocator, reuse_freed_block) {
+  s21::pool_allocator<int> alloc;
+
+  int *first = alloc.allocate(1);
+  alloc.deallocate(first, 1);
+  int *second = alloc.allocate(1);
+
+  EXPECT_EQ(first, second);
+  alloc.deallocate(second, 1);
+}
+
+TEST(test_allocator, rebind_shares_pool) {
+  s21::pool_allocator<int> alloc(8);
+  s21::pool_allocator<double> rebound(alloc);
+
+  EXPECT_TRUE(alloc == rebound);
+  EXPECT_FALSE(alloc.unique());
+  EXPECT_TRUE(alloc != s21::pool_allocator<int>(8));
+}
+
+TEST(test_allocator, copy_construction_gets_own_pool) {
+  s21::map<int, string> opa;
+  opa.insert({1, "one"});
+
+  s21::map<int, string> copy(opa);
+
+  EXPECT_TRUE(copy.get_allocator() != opa.get_allocator());
+  EXPECT_EQ(copy.at(1), "one");
+}
+
+TEST(test_allocator, clear_and_refill) {
+  s21::set<string> opa;
+
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 100; ++i) {
+      opa.insert(std::to_string(i));
+    }
+
+    EXPECT_EQ(opa.size(), 100);
+    opa.clear();
+    EXPECT_TRUE(opa.empty());
+  }
+}
+
+TEST(test_allocator, merge_shared_pool_keeps_nodes) {
+  s21::pool_allocator<int> pool(64);
+  s21::set<int> opa(pool);
+  s21::set<int> opa_2(pool);
+
+  opa.insert(1);
+  opa_2.insert(2);
+  const int *moved = &*opa_2.find(2);
+
+  opa.merge(opa_2);
+
+  EXPECT_EQ(&*opa.find(2), moved);
+  EXPECT_TRUE(opa_2.empty());
+}
+
+TEST(test_allocator, merge_different_pools) {
+  s21::set<string> opa{"a", "c"};
+  s21::set<string> opa_2{"b", "c"};
+
+  opa.merge(opa_2);
+  opa_2.clear();
+
+  EXPECT_EQ(opa.size(), 3);
+  EXPECT_EQ(*opa.begin(), "a");
+  EXPECT_TRUE(opa.contains("b"));
+}
+
+TEST(test_allocator, merge_default_sets_keeps_nodes) {
+  s21::set<int> opa;
+  s21::set<int> opa_2{3, 7};
+  s21::set<int> opa_3{5, 9, 11};
+  s21::set<int> opa_4{200, 300};
+  std::vector<const int *> moved;
+
+  for (int i = 0; i < 100; i += 2) opa.insert(i);
+  for (const int &value : opa_2) moved.push_back(&value);
+  for (const int &value : opa_3) moved.push_back(&value);
+  for (const int &value : opa_4) moved.push_back(&value);
+
+  opa.merge(opa_2);
+  opa_3.merge(opa);
+  opa_3.merge(opa_4);
+
+  EXPECT_EQ(opa_3.size(), 57);
+  EXPECT_EQ(&*opa_3.find(3), moved[0]);
+  EXPECT_EQ(&*opa_3.find(7), moved[1]);
+  EXPECT_EQ(&*opa_3.find(5), moved[2]);
+  EXPECT_EQ(&*opa_3.find(11), moved[4]);
+  EXPECT_EQ(&*opa_3.find(200), moved[5]);
+  EXPECT_EQ(&*opa_3.find(300), moved[6]);
+  EXPECT_TRUE(opa.empty());
+  EXPECT_TRUE(opa_2.empty());
+  EXPECT_TRUE(opa_4.empty());
+}
+
+TEST(test_allocator, list_splice_different_pools) {
+  s21::list<string> opa{"a", "b"};
+  s21::list<string> opa_2{"c", "d"};
+
+  opa.splice(opa.cbegin(), opa_2);
+  opa_2.push_back("e");
+
+  EXPECT_EQ(opa.size(), 4);
+  EXPECT_EQ(opa.front(), "c");
+  EXPECT_EQ(opa.back(), "b");
+  EXPECT_EQ(opa_2.size(), 1);
+  EXPECT_EQ(opa_2.front(), "e");
+}
+
+TEST(test_allocator, copies_stay_equal) {
+  s21::pool_allocator<int> alloc;
+  s21::pool_allocator<int> copy(alloc);
+  s21::pool_allocator<int> moved(std::move(copy));
+
+  EXPECT_TRUE(alloc == moved);
+  copy = moved;
+  alloc.deallocate(alloc.allocate(1), 1);
+  EXPECT_TRUE(alloc == copy);
+  EXPECT_TRUE(alloc == moved);
+  EXPECT_TRUE(alloc != s21::pool_allocator<int>());
+}
+
+TEST(test_allocator, list_splice_keeps_iterators) {
+  s21::list<int> opa{1, 2};
+  s21::list<int> opa_2{3, 4};
+  auto it = opa_2.begin();
+
+  opa.splice(opa.cbegin(), opa_2);
+
+  EXPECT_EQ(*it, 3);
+  EXPECT_TRUE(it == opa.begin());
+  EXPECT_TRUE(opa_2.empty());
+}
+
+TEST(test_allocator, adopted_pool_outlives_source) {
+  s21::list<string> opa{"a"};
+
+  {
+    s21::list<string> opa_2{"b", "c"};
+    opa.splice(opa.cend(), opa_2);
+    opa_2.push_back("d");
+  }
+
+  opa.pop_front();
+  opa.push_back("e");
+
+  EXPECT_EQ(opa.size(), 3);
+  EXPECT_EQ(opa.front(), "b");
+  EXPECT_EQ(opa.back(), "e");
+}
+
+TEST(test_allocator, free_into_pool_that_never_allocated) {
+  s21::list<int> opa;
+
+  {
+    s21::list<int> opa_2{1, 2};
+    opa.splice(opa.cend(), opa_2);
+  }
+
+  opa.pop_front();
+  opa.push_back(3);
+
+  EXPECT_EQ(opa.size(), 2);
+  EXPECT_EQ(opa.front(), 2);
+  EXPECT_EQ(opa.back(), 3);
+}
+
+TEST(test_allocator, list_merge_shared_pool) {
+  s21::pool_allocator<int> pool(16);
+  s21::list<int> opa(pool);
+  s21::list<int> opa_2(pool);
+
+  opa.push_back(1);
+  opa.push_back(3);
+  opa_2.push_back(2);
+  const int *moved = &opa_2.front();
+
+  opa.merge(opa_2);
+
+  EXPECT_EQ(&*(++opa.begin()), moved);
+  EXPECT_EQ(opa.size(), 3);
+  EXPECT_TRUE(opa_2.empty());
+}
+
+TEST(test_allocator, std_allocator) {
+  s21::map<int, int, s21::Compare<int, int>, s21::KeyExtract<int, int>, false,
+           std::allocator<std::pair<int, int>>>
+      opa{{2, 2}, {1, 1}};
+  s21::list<int, std::allocator<int>> opa_2{3, 1};
+  s21::list<int, std::allocator<int>> opa_3{2};
+
+  opa_2.splice(opa_2.cend(), opa_3);
+
+  EXPECT_EQ(opa.begin()->first, 1);
+  EXPECT_EQ(opa_2.size(), 3);
+  EXPECT_EQ(opa_2.back(), 2);
+}
+
+TEST(test_allocator, empty_containers_do_not_allocate) {
+  using counted_set = s21::set<int, s21::KeyExtract<int, int>,
+                               s21::Compare<int, int>, false,
+                               CountingAllocator<int>>;
+  using counted_list = s21::list<int, CountingAllocator<int>>;
+
+  allocations = 0;
+
+  {
+    counted_set opa;
+    counted_set opa_2(std::move(opa));
+    counted_list opa_3;
+    counted_list opa_4(std::move(opa_3));
+
+    opa.swap(opa_2);
+    opa_3.swap(opa_4);
+    opa_2 = std::move(opa);
+    opa_4 = std::move(opa_3);
+  }
+
+  EXPECT_EQ(allocations, 0);
+
+  counted_set opa{3, 1, 2};
+  counted_set opa_2(std::move(opa));
+
+  EXPECT_TRUE(opa.empty());
+  EXPECT_EQ(*opa_2.begin(), 1);
+  EXPECT_EQ(*--opa_2.end(), 3);
+}
+
+TEST(test_allocator, empty_default_containers_do_not_allocate) {
+  std::size_t before = heap_allocations;
+
+  {
+    s21::map<int, string> opa;
+    s21::set<int> opa_2;
+    s21::multiset<int> opa_3;
+    s21::list<int> opa_4;
+    s21::map<int, string> opa_5(std::move(opa));
+    s21::set<int> opa_6(std::move(opa_2));
+    s21::multiset<int> opa_7(std::move(opa_3));
+    s21::list<int> opa_8(std::move(opa_4));
+
+    opa_2.swap(opa_6);
+    opa_3.swap(opa_7);
+    opa = std::move(opa_5);
+    opa_4 = std::move(opa_8);
+  }
+
+  EXPECT_EQ(heap_allocations, before);
+}
+
+TEST(test_allocator, adopted_blocks_are_reused) {
+  s21::list<int> opa;
+  std::size_t live = 0;
+
+  for (int i = 0; i < 10000; ++i) {
+    s21::list<int> opa_2{i};
+    opa.splice(opa.cend(), opa_2);
+    opa.pop_front();
+
+    if (i == 100) {
+      live = LiveHeapBlocks();
+    }
+  }
+
+  EXPECT_TRUE(opa.empty());
+  EXPECT_LT(LiveHeapBlocks(), live + 100);
+}
+
+TEST(test_allocator, merged_blocks_are_reused) {
+  s21::set<int> opa{-1};
+  s21::set<int> opa_2;
+  std::size_t live = 0;
+
+  for (int i = 0; i < 10000; ++i) {
+    s21::set<int> opa_3{i};
+    s21::set<int> opa_4{i};
+    opa.merge(opa_3);
+    opa.erase(opa.find(i));
+    opa_2.merge(opa_4);
+    opa_2.erase(opa_2.find(i));
+
+    if (i == 100) {
+      live = LiveHeapBlocks();
+    }
+  }
+
+  EXPECT_EQ(opa.size(), 1);
+  EXPECT_TRUE(opa_2.empty());
+  EXPECT_LT(LiveHeapBlocks(), live + 100);
+}
+
+TEST(test_allocator, extracted_blocks_are_reused) {
+  s21::map<int, int> opa;
+  std::size_t live = 0;
+
+  for (int i = 0; i < 10000; ++i) {
+    s21::map<int, int> opa_2{{i, i}};
+    opa.insert(opa_2.extract(i));
+    opa.erase(i);
+
+    if (i == 100) {
+      live = LiveHeapBlocks();
+    }
+  }
+
+  EXPECT_TRUE(opa.empty());
+  EXPECT_LT(LiveHeapBlocks(), live + 100);
+}
+
+TEST(test_allocator, payload_without_default_constructor) {
+  s21::set<NoDefault> opa{NoDefault(2), NoDefault(1)};
+  s21::list<NoDefault> opa_2{NoDefault(2), NoDefault(1)};
+
+  EXPECT_EQ(opa.begin()->value_, 1);
+  EXPECT_EQ(opa_2.front().value_, 2);
+  EXPECT_EQ(opa_2.back().value_, 1);
+}
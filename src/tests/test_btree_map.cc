@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "../s21_containers.h"
+
+TEST(btree_map, constructors) {
+  s21::btree_map<int, std::string> empty;
+  s21::btree_map<int, std::string> m{{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+  s21::btree_map<int, std::string> copy(m);
+  s21::btree_map<int, std::string> moved(std::move(copy));
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at(1), "a");
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == m);
+
+  empty = moved;
+  EXPECT_TRUE(empty == m);
+  moved = std::move(empty);
+  EXPECT_EQ(moved.size(), 3U);
+}
+
+TEST(btree_map, access) {
+  s21::btree_map<std::string, int> m;
+
+  m["one"] = 1;
+  m["two"] = 2;
+  ++m["one"];
+
+  EXPECT_EQ(m.at("one"), 2);
+  EXPECT_EQ(m["two"], 2);
+  EXPECT_EQ(m["three"], 0);
+  EXPECT_THROW(m.at("four"), std::out_of_range);
+  EXPECT_EQ(m.size(), 3U);
+}
+
+TEST(btree_map, insert) {
+  s21::btree_map<int, int> m;
+
+  EXPECT_TRUE(m.insert({1, 10}).second);
+  EXPECT_FALSE(m.insert({1, 11}).second);
+  EXPECT_EQ(m.at(1), 10);
+  EXPECT_TRUE(m.insert_or_assign(2, 20).second);
+  EXPECT_FALSE(m.insert_or_assign(2, 21).second);
+  EXPECT_EQ(m.at(2), 21);
+  EXPECT_TRUE(m.insert(2, 22).second);
+  EXPECT_EQ(m.at(2), 22);
+  EXPECT_TRUE(m.try_emplace(3, 30).second);
+  EXPECT_FALSE(m.try_emplace(3, 31).second);
+  EXPECT_EQ(m.emplace(4, 40).first->second, 40);
+
+  auto res = m.insert_many(std::make_pair(5, 50), std::make_pair(1, 0));
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(m.size(), 5U);
+}
+
+TEST(btree_map, sorted_ingest) {
+  s21::btree_map<int, int> hinted;
+  std::map<int, int> ref;
+
+  for (int i = 0; i < 5000; ++i) {
+    hinted.insert(hinted.end(), {i, -i});
+    ref.insert({i, -i});
+  }
+  for (int i = -1; i > -100; --i) {
+    hinted.emplace_hint(hinted.begin(), i, -i);
+    ref.emplace(i, -i);
+  }
+
+  ASSERT_EQ(hinted.size(), ref.size());
+  auto it = hinted.begin();
+  for (auto &item : ref) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+  EXPECT_TRUE(it == hinted.end());
+}
+
+TEST(btree_map, erase_returns_next) {
+  s21::btree_map<int, int> m;
+  for (int i = 0; i < 1000; ++i) m.insert({i, i});
+
+  auto it = m.find(0);
+  while (it != m.end()) {
+    int key = it->first;
+    it = m.erase(it);
+    if (it != m.end()) {
+      EXPECT_EQ(it->first, key + 1);
+      ++it;
+    }
+  }
+
+  EXPECT_EQ(m.size(), 500U);
+  for (auto &item : m) EXPECT_EQ(item.first % 2, 1);
+}
+
+TEST(btree_map, lookup) {
+  s21::btree_map<int, int> m;
+  for (int i = 0; i < 300; i += 3) m.insert({i, i});
+
+  EXPECT_TRUE(m.contains(27));
+  EXPECT_FALSE(m.contains(28));
+  EXPECT_EQ(m.count(30), 1U);
+  EXPECT_TRUE(m.find(31) == m.end());
+  EXPECT_EQ(m.find(99)->second, 99);
+}
+
+TEST(btree_map, merge) {
+  s21::btree_map<int, int> a{{1, 1}, {3, 3}};
+  s21::btree_map<int, int> b{{2, 2}, {3, 30}};
+
+  a.merge(b);
+
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(a.at(3), 3);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(b.at(3), 30);
+}
+
+TEST(btree_map, random_against_std) {
+  std::mt19937 rng(42);
+  s21::btree_map<int, int> m;
+  std::map<int, int> ref;
+
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(rng() % 2000);
+    if (rng() % 3) {
+      EXPECT_EQ(m.insert({key, i}).second, ref.insert({key, i}).second);
+
+    } else {
+      auto found = m.find(key);
+      EXPECT_EQ(found != m.end(), ref.erase(key) == 1U);
+      if (found != m.end()) m.erase(found);
+    }
+  }
+
+  ASSERT_EQ(m.size(), ref.size());
+  auto it = m.begin();
+  for (auto &item : ref) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+}
\ No newline at end of file
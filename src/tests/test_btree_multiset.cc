@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include "../s21_containersplus.h"
+
+TEST(btree_multiset, insert_duplicates) {
+  s21::btree_multiset<int> s{3, 1, 3, 2, 3};
+
+  EXPECT_EQ(s.size(), 5U);
+  EXPECT_EQ(s.count(3), 3U);
+  EXPECT_EQ(s.count(4), 0U);
+
+  auto range = s.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  EXPECT_TRUE(range.second == s.end());
+}
+
+TEST(btree_multiset, hinted_insert_keeps_order) {
+  s21::btree_multiset<int> s;
+
+  for (int i = 0; i < 1000; ++i) s.insert(s.end(), i / 10);
+  for (int i = 0; i < 100; ++i) s.insert(s.begin(), -1);
+
+  EXPECT_EQ(s.size(), 1100U);
+  EXPECT_EQ(s.count(-1), 100U);
+  EXPECT_EQ(s.count(50), 10U);
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+}
+
+TEST(btree_multiset, erase) {
+  s21::btree_multiset<int> s;
+  for (int i = 0; i < 600; ++i) s.insert(i % 3);
+
+  auto range = s.equal_range(1);
+  auto it = range.first;
+  while (it != s.end() && *it == 1) it = s.erase(it);
+
+  EXPECT_EQ(s.size(), 400U);
+  EXPECT_EQ(s.count(1), 0U);
+  EXPECT_EQ(*it, 2);
+}
+
+TEST(btree_multiset, random_against_std) {
+  std::mt19937 rng(3);
+  s21::btree_multiset<int> s;
+  std::multiset<int> ref;
+
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(rng() % 500);
+    if (rng() % 3) {
+      s.insert(key);
+      ref.insert(key);
+
+    } else {
+      auto found = s.find(key);
+      auto ref_found = ref.find(key);
+      ASSERT_EQ(found == s.end(), ref_found == ref.end());
+      if (found != s.end()) {
+        s.erase(found);
+        ref.erase(ref_found);
+      }
+    }
+  }
+
+  ASSERT_EQ(s.size(), ref.size());
+  EXPECT_TRUE(std::equal(ref.begin(), ref.end(), s.begin()));
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../s21_containers.h"
+
+TEST(btree_set, constructors) {
+  s21::btree_set<int> empty;
+  s21::btree_set<int> s{5, 1, 4, 1, 3};
+  s21::btree_set<int> copy(s);
+  s21::btree_set<int> moved(std::move(copy));
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(s.size(), 4U);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == s);
+  EXPECT_EQ(*s.begin(), 1);
+}
+
+TEST(btree_set, iterators) {
+  s21::btree_set<int> s;
+  for (int i = 999; i >= 0; --i) s.insert(i);
+
+  int expected = 0;
+  for (auto it = s.begin(); it != s.end(); ++it) EXPECT_EQ(*it, expected++);
+  EXPECT_EQ(expected, 1000);
+
+  auto it = s.end();
+  while (it != s.begin()) EXPECT_EQ(*--it, --expected);
+  EXPECT_EQ(expected, 0);
+}
+
+TEST(btree_set, bounds) {
+  s21::btree_set<int> s;
+  for (int i = 0; i < 500; i += 5) s.insert(i);
+
+  EXPECT_EQ(*s.lower_bound(10), 10);
+  EXPECT_EQ(*s.lower_bound(11), 15);
+  EXPECT_EQ(*s.upper_bound(10), 15);
+  EXPECT_TRUE(s.lower_bound(496) == s.end());
+  EXPECT_TRUE(s.find(12) == s.end());
+  EXPECT_TRUE(s.contains(495));
+}
+
+TEST(btree_set, transparent_lookup) {
+  s21::btree_set<std::string, s21::KeyExtract<std::string, std::string>,
+                 s21::less<>>
+      s{"alpha", "beta", "gamma"};
+
+  EXPECT_TRUE(s.contains(std::string_view("beta")));
+  EXPECT_FALSE(s.contains("delta"));
+  EXPECT_EQ(*s.find(std::string_view("gamma")), "gamma");
+}
+
+TEST(btree_set, erase_all) {
+  s21::btree_set<std::string> s;
+  for (int i = 0; i < 2000; ++i) s.insert(std::to_string(i));
+
+  auto it = s.begin();
+  while (it != s.end()) it = s.erase(it);
+
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.begin() == s.end());
+  s.insert("again");
+  EXPECT_EQ(s.size(), 1U);
+}
+
+TEST(btree_set, random_against_std) {
+  std::mt19937 rng(7);
+  s21::btree_set<int> s;
+  std::set<int> ref;
+
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(rng() % 3000);
+    if (rng() % 4) {
+      EXPECT_EQ(s.insert(key).second, ref.insert(key).second);
+
+    } else {
+      auto found = s.lower_bound(key);
+      auto ref_found = ref.lower_bound(key);
+      ASSERT_EQ(found == s.end(), ref_found == ref.end());
+      if (found != s.end()) {
+        auto next = s.erase(found);
+        auto ref_next = ref.erase(ref_found);
+        ASSERT_EQ(next == s.end(), ref_next == ref.end());
+        if (next != s.end()) {
+          EXPECT_EQ(*next, *ref_next);
+        }
+      }
+    }
+  }
+
+  ASSERT_EQ(s.size(), ref.size());
+  EXPECT_TRUE(std::equal(ref.begin(), ref.end(), s.begin()));
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../concurrent_map/s21_concurrent_map.h"
+
+TEST(concurrent_map, single_calls) {
+  s21::concurrent_map<int, std::string> m(8);
+
+  EXPECT_EQ(m.shard_count(), 8U);
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.insert({1, "one"}));
+  EXPECT_FALSE(m.insert({1, "uno"}));
+  EXPECT_TRUE(m.try_emplace(2, 3, 't'));
+  EXPECT_FALSE(m.insert_or_assign(1, "uno"));
+  EXPECT_TRUE(m.insert_or_assign(3, "three"));
+  EXPECT_EQ(m.at(1), "uno");
+  EXPECT_EQ(m.at(2), "ttt");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.count(3), 1U);
+
+  EXPECT_TRUE(m.update(3, [](std::string &v) { v += "!"; }));
+  EXPECT_FALSE(m.update(4, [](std::string &v) { v += "!"; }));
+
+  std::string seen;
+  EXPECT_TRUE(m.visit(3, [&](const std::string &v) { seen = v; }));
+  EXPECT_FALSE(m.visit(9, [&](const std::string &v) { seen = v; }));
+  EXPECT_EQ(seen, "three!");
+
+  EXPECT_EQ(m.erase(2), 1U);
+  EXPECT_EQ(m.erase(2), 0U);
+  EXPECT_FALSE(m.contains(2));
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.size(), 0U);
+}
+
+TEST(concurrent_map, batches) {
+  s21::concurrent_map<int, int> m{{5, 50}, {1, 10}};
+  std::vector<std::pair<int, int>> values;
+
+  for (int i = 0; i < 1000; ++i) {
+    values.emplace_back(i, i * 2);
+  }
+
+  EXPECT_EQ(m.insert(values.begin(), values.end()), 998U);
+  EXPECT_EQ(m.at(5), 50);
+  EXPECT_EQ(m.at(6), 12);
+  EXPECT_EQ(m.insert_or_assign(values.begin(), values.begin() + 10), 0U);
+  EXPECT_EQ(m.at(5), 10);
+
+  std::vector<int> keys{-1, 0, 999, 1000, 500, 500};
+  std::vector<bool> found;
+  m.contains_many(keys.begin(), keys.end(), std::back_inserter(found));
+
+  EXPECT_EQ(found,
+            std::vector<bool>({false, true, true, false, true, true}));
+  EXPECT_EQ(m.erase(keys.begin(), keys.end()), 3U);
+  EXPECT_EQ(m.size(), 997U);
+
+  std::vector<int> none;
+  EXPECT_EQ(m.insert(values.end(), values.end()), 0U);
+  EXPECT_EQ(m.erase(none.begin(), none.end()), 0U);
+}
+
+TEST(concurrent_map, snapshot_and_for_each) {
+  s21::concurrent_map<int, int> m(16);
+
+  for (int i = 1000; i > 0; --i) {
+    m.insert({i * 64, i});
+  }
+
+  auto copy = m.snapshot();
+  int expected = 64;
+
+  ASSERT_EQ(copy.size(), 1000U);
+
+  for (const auto &item : copy) {
+    EXPECT_EQ(item.first, expected);
+    expected += 64;
+  }
+
+  long sum = 0;
+  m.for_each([&](const std::pair<const int, int> &item) {
+    sum += item.second;
+  });
+  EXPECT_EQ(sum, 500500);
+}
+
+TEST(concurrent_map, threads_insert_count_and_erase) {
+  s21::concurrent_map<int, int> m;
+  const int threads = 4;
+  const int per_thread = 5000;
+  std::vector<std::thread> workers;
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::vector<std::pair<int, int>> batch;
+
+      for (int i = 0; i < per_thread; ++i) {
+        int key = t * per_thread + i;
+
+        if (i % 2 == 0) {
+          m.insert({key, key});
+        } else {
+          batch.emplace_back(key, key);
+        }
+
+        m.upsert(-1 - i % 10, 1, [](int &count) { ++count; });
+        m.contains(key - 1);
+      }
+
+      m.insert(batch.begin(), batch.end());
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(m.size(), static_cast<size_t>(threads * per_thread + 10));
+
+  for (int k = 1; k <= 10; ++k) {
+    EXPECT_EQ(m.at(-k), threads * per_thread / 10);
+  }
+
+  workers.clear();
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::vector<int> keys;
+
+      for (int i = t; i < threads * per_thread; i += threads) {
+        keys.push_back(i);
+      }
+
+      m.erase(keys.begin(), keys.end());
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(m.size(), 10U);
+}
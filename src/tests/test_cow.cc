@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../map/s21_map.h"
+#include "../multiset/s21_multiset.h"
+#include "../set/s21_set.h"
+#include "../vector/s21_vector.h"
+
+TEST(cow, copies_share_until_written) {
+  s21::cow_map<int, std::string> config;
+
+  for (int i = 0; i < 1000; ++i) {
+    config.write().emplace(i, std::to_string(i));
+  }
+
+  s21::cow_map<int, std::string> stage = config;
+
+  EXPECT_TRUE(config.shared());
+  EXPECT_EQ(&stage.read(), &config.read());
+  EXPECT_EQ(stage->at(500), "500");
+
+  stage.write()[500] = "changed";
+  stage.write().erase(stage->find(0));
+
+  EXPECT_FALSE(config.shared());
+  EXPECT_NE(&stage.read(), &config.read());
+  EXPECT_EQ(config->at(500), "500");
+  EXPECT_EQ(stage->at(500), "changed");
+  EXPECT_EQ(config.size(), 1000U);
+  EXPECT_EQ(stage.size(), 999U);
+  EXPECT_TRUE(config->contains(0));
+  EXPECT_FALSE(stage->contains(0));
+}
+
+TEST(cow, write_without_sharing_keeps_the_container) {
+  s21::cow_set<int> s{3, 1, 2};
+  const s21::set<int> *before = &s.read();
+
+  s.write().insert(4);
+
+  EXPECT_EQ(&s.read(), before);
+  EXPECT_EQ(s.size(), 4U);
+}
+
+TEST(cow, empty_and_moved_from) {
+  s21::cow_multiset<int> empty;
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_FALSE(empty.shared());
+
+  s21::cow_multiset<int> values{5, 5, 7};
+  s21::cow_multiset<int> moved = std::move(values);
+
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(moved->count(5), 2U);
+
+  values.write().insert(1);
+  EXPECT_EQ(values.size(), 1U);
+
+  values.swap(moved);
+  EXPECT_EQ(values.size(), 3U);
+  EXPECT_EQ(moved.size(), 1U);
+}
+
+TEST(cow, iteration_reads_shared_values) {
+  s21::cow_set<int> s{4, 2, 8, 6};
+  s21::cow_set<int> copy;
+  copy = s;
+
+  std::vector<int> values;
+
+  for (int value : copy) {
+    values.push_back(value);
+  }
+
+  EXPECT_EQ(values, std::vector<int>({2, 4, 6, 8}));
+
+  s21::cow<s21::vector<int>> vec(s21::vector<int>{1, 2, 3});
+  s21::cow<s21::vector<int>> vec_copy = vec;
+  vec_copy.write().push_back(4);
+
+  EXPECT_EQ(vec.size(), 3U);
+  EXPECT_EQ(vec_copy.size(), 4U);
+}
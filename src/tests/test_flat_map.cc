@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_containers.h"
+
+TEST(flat_map, constructors) {
+  s21::flat_map<int, std::string> empty;
+  s21::flat_map<int, std::string> m{{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+  s21::flat_map<int, std::string> copy(m);
+  s21::flat_map<int, std::string> moved(std::move(copy));
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at(1), "a");
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == m);
+
+  empty = moved;
+  EXPECT_TRUE(empty == m);
+}
+
+TEST(flat_map, access) {
+  s21::flat_map<std::string, int, s21::less<>> m;
+
+  m["one"] = 1;
+  m["two"] = 2;
+  ++m["one"];
+
+  const auto &view = m;
+  EXPECT_EQ(view.at("one"), 2);
+  EXPECT_EQ(m.at(std::string_view("two")), 2);
+  EXPECT_EQ(m["three"], 0);
+  EXPECT_THROW(view.at("four"), std::out_of_range);
+  EXPECT_EQ(m.size(), 3U);
+}
+
+TEST(flat_map, iterators_are_pointers) {
+  s21::flat_map<int, int> m{{2, 20}, {1, 10}, {3, 30}};
+
+  std::pair<int, int> *first = m.begin();
+  EXPECT_EQ(m.end() - first, 3);
+  EXPECT_EQ(first[1].second, 20);
+  EXPECT_EQ(m.find(3), first + 2);
+  EXPECT_EQ(m.lower_bound(2), first + 1);
+  EXPECT_EQ(m.upper_bound(2), first + 2);
+}
+
+TEST(flat_map, bulk_insert) {
+  s21::flat_map<int, int> m{{5, 0}, {1, 0}};
+  std::vector<std::pair<int, int>> batch{{3, 1}, {5, 1}, {2, 1}, {3, 2}};
+
+  m.insert(batch.begin(), batch.end());
+
+  ASSERT_EQ(m.size(), 4U);
+  EXPECT_EQ(m.at(1), 0);
+  EXPECT_EQ(m.at(2), 1);
+  EXPECT_EQ(m.at(3), 1);
+  EXPECT_EQ(m.at(5), 0);
+  EXPECT_TRUE(std::is_sorted(m.begin(), m.end()));
+}
+
+TEST(flat_map, insert_and_erase) {
+  s21::flat_map<int, int> m;
+
+  EXPECT_TRUE(m.insert({2, 20}).second);
+  EXPECT_FALSE(m.insert({2, 21}).second);
+  EXPECT_TRUE(m.try_emplace(1, 10).second);
+  EXPECT_FALSE(m.insert_or_assign(1, 11).second);
+  EXPECT_EQ(m.insert(m.end(), {3, 30})->first, 3);
+  EXPECT_EQ(m.emplace_hint(m.begin(), 0, 0)->first, 0);
+  EXPECT_EQ(m.at(1), 11);
+
+  auto next = m.erase(m.find(1));
+  EXPECT_EQ(next->first, 2);
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.count(1), 0U);
+}
+
+TEST(flat_map, merge) {
+  s21::flat_map<int, int> a{{1, 1}, {3, 3}};
+  s21::flat_map<int, int> b{{0, 0}, {2, 2}, {3, 30}, {4, 4}};
+
+  a.merge(b);
+
+  EXPECT_EQ(a.size(), 5U);
+  EXPECT_EQ(a.at(3), 3);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(b.at(3), 30);
+  EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+}
+
+TEST(flat_map, random_against_std) {
+  std::mt19937 rng(11);
+  s21::flat_map<int, int> m;
+  std::map<int, int> ref;
+
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(rng() % 1000);
+    if (rng() % 3) {
+      EXPECT_EQ(m.insert({key, i}).second, ref.insert({key, i}).second);
+
+    } else {
+      auto found = m.find(key);
+      EXPECT_EQ(found != m.end(), ref.erase(key) == 1U);
+      if (found != m.end()) m.erase(found);
+    }
+  }
+
+  ASSERT_EQ(m.size(), ref.size());
+  auto it = m.begin();
+  for (auto &item : ref) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_containers.h"
+
+TEST(flat_set, constructors) {
+  s21::flat_set<int> empty;
+  s21::flat_set<int> s{5, 1, 4, 1, 3};
+  s21::flat_set<int> copy(s);
+  s21::flat_set<int> moved(std::move(copy));
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(s.size(), 4U);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(moved == s);
+  EXPECT_EQ(*s.begin(), 1);
+}
+
+TEST(flat_set, bounds) {
+  s21::flat_set<int> s;
+  for (int i = 0; i < 500; i += 5) s.insert(i);
+
+  EXPECT_EQ(*s.lower_bound(10), 10);
+  EXPECT_EQ(*s.lower_bound(11), 15);
+  EXPECT_EQ(*s.upper_bound(10), 15);
+  EXPECT_EQ(*s.lower_bound(-3), 0);
+  EXPECT_TRUE(s.lower_bound(496) == s.end());
+  EXPECT_TRUE(s.upper_bound(495) == s.end());
+  EXPECT_TRUE(s.find(12) == s.end());
+  EXPECT_TRUE(s.contains(495));
+  EXPECT_EQ(s.count(495), 1U);
+}
+
+TEST(flat_set, bounds_every_size) {
+  for (int n = 0; n < 40; ++n) {
+    std::vector<int> odd;
+    for (int i = 0; i < n; ++i) odd.push_back(2 * i + 1);
+    s21::flat_set<int> s(odd.begin(), odd.end());
+
+    for (int key = -1; key <= 2 * n + 1; ++key) {
+      EXPECT_EQ(s.lower_bound(key) - s.begin(),
+                std::lower_bound(odd.begin(), odd.end(), key) - odd.begin());
+      EXPECT_EQ(s.upper_bound(key) - s.begin(),
+                std::upper_bound(odd.begin(), odd.end(), key) - odd.begin());
+    }
+  }
+}
+
+TEST(flat_set, transparent_lookup) {
+  s21::flat_set<std::string, s21::KeyExtract<std::string, std::string>,
+                s21::less<>>
+      s{"alpha", "beta", "gamma"};
+
+  EXPECT_TRUE(s.contains(std::string_view("beta")));
+  EXPECT_FALSE(s.contains("delta"));
+  EXPECT_EQ(*s.find(std::string_view("gamma")), "gamma");
+}
+
+TEST(flat_set, bulk_insert) {
+  s21::flat_set<std::string> s{"b", "d"};
+  std::vector<std::string> batch{"e", "a", "d", "c", "a"};
+
+  s.insert(batch.begin(), batch.end());
+
+  EXPECT_EQ(s.size(), 5U);
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+  EXPECT_TRUE(std::adjacent_find(s.begin(), s.end()) == s.end());
+}
+
+TEST(flat_set, random_against_std) {
+  std::mt19937 rng(5);
+  s21::flat_set<int> s;
+  std::set<int> ref;
+
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(rng() % 800);
+    int op = static_cast<int>(rng() % 4);
+    if (op < 2) {
+      EXPECT_EQ(s.insert(key).second, ref.insert(key).second);
+
+    } else if (op == 2) {
+      std::vector<int> batch{key, key + 3, key - 7};
+      s.insert(batch.begin(), batch.end());
+      ref.insert(batch.begin(), batch.end());
+
+    } else {
+      auto found = s.find(key);
+      EXPECT_EQ(found != s.end(), ref.erase(key) == 1U);
+      if (found != s.end()) s.erase(found);
+    }
+  }
+
+  ASSERT_EQ(s.size(), ref.size());
+  EXPECT_TRUE(std::equal(ref.begin(), ref.end(), s.begin()));
+}
\ No newline at end of file
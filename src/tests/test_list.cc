@@ -112,7 +112,7 @@ TEST(test_list, move_constructor_1) {
 
   EXPECT_EQ(opa.size(), 0);
   EXPECT_EQ(eq, 1);
-  EXPECT_EQ(*it, 0);
+  EXPECT_TRUE(it == opa.end());
 
   for (it = opa2.begin(); it != opa2.end() && it2 != aboba.end(); ++it, ++it2) {
     EXPECT_EQ(*it, *it2);
@@ -129,8 +129,8 @@ TEST(test_list, move_constructor_2) {
   EXPECT_EQ(opa.empty(), 1);
   EXPECT_EQ(opa2.size(), 0);
   EXPECT_EQ(opa2.empty(), 1);
-  EXPECT_EQ(*it, 0);
-  EXPECT_EQ(*it2, 0);
+  EXPECT_TRUE(it == opa.end());
+  EXPECT_TRUE(it2 == opa2.end());
 }
 
 TEST(test_list, move_constructor_3) {
@@ -143,8 +143,8 @@ TEST(test_list, move_constructor_3) {
   EXPECT_EQ(opa.empty(), 1);
   EXPECT_EQ(opa2.size(), 0);
   EXPECT_EQ(opa2.empty(), 1);
-  EXPECT_EQ(*it, 0);
-  EXPECT_EQ(*it2, 0);
+  EXPECT_TRUE(it == opa.end());
+  EXPECT_TRUE(it2 == opa2.end());
 }
 
 TEST(test_list, move_constructor_4) {
@@ -157,8 +157,8 @@ TEST(test_list, move_constructor_4) {
   EXPECT_EQ(opa.empty(), 1);
   EXPECT_EQ(opa2.size(), 0);
   EXPECT_EQ(opa2.empty(), 1);
-  EXPECT_EQ(*it, "");
-  EXPECT_EQ(*it2, "");
+  EXPECT_TRUE(it == opa.end());
+  EXPECT_TRUE(it2 == opa2.end());
 }
 
 TEST(test_list, operator_assign_1) {
@@ -327,7 +327,8 @@ TEST(test_list, begin_2) {
   s21::list<int>::ListIterator it = opa.begin();
   std::list<int>::iterator it2 = opa2.begin();
 
-  EXPECT_EQ(*it, *it2);
+  EXPECT_TRUE(it == opa.end());
+  EXPECT_TRUE(it2 == opa2.end());
 }
 
 TEST(test_list, end_1) {
@@ -365,7 +366,8 @@ TEST(test_list, cbegin_2) {
   s21::list<int>::ListConstIterator it = opa.cbegin();
   std::list<int>::const_iterator it2 = opa2.cbegin();
 
-  EXPECT_EQ(*it, *it2);
+  EXPECT_TRUE(it == opa.cend());
+  EXPECT_TRUE(it2 == opa2.cend());
 }
 
 TEST(test_list, cend_1) {
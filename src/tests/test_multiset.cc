@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "../s21_containersplus.h"
 
@@ -521,4 +528,383 @@ TEST(multiset, multiset_insert_many_03) {
   EXPECT_EQ(*it++, 6);
 
   EXPECT_EQ(s.size(), 12);
-}
\ No newline at end of file
+}
+TEST(multiset, multiset_bounds_match_std) {
+  s21::multiset<int> s;
+  std::multiset<int> s2;
+
+  for (int i = 0; i < 200; ++i) {
+    s.insert((i * 37) % 50 * 2);
+    s2.insert((i * 37) % 50 * 2);
+  }
+
+  for (int key = -3; key < 103; ++key) {
+    auto lower = s.lower_bound(key);
+    auto upper = s.upper_bound(key);
+    auto lower2 = s2.lower_bound(key);
+    auto upper2 = s2.upper_bound(key);
+
+    EXPECT_EQ(lower == s.end(), lower2 == s2.end());
+    EXPECT_EQ(upper == s.end(), upper2 == s2.end());
+    if (lower2 != s2.end()) {
+      EXPECT_EQ(*lower, *lower2);
+    }
+    if (upper2 != s2.end()) {
+      EXPECT_EQ(*upper, *upper2);
+    }
+
+    std::size_t in_range = 0;
+    for (auto it = lower; it != upper; ++it) ++in_range;
+    EXPECT_EQ(in_range, s2.count(key));
+  }
+}
+
+TEST(multiset, multiset_bounds_const) {
+  const s21::multiset<int> s({1, 3, 3, 3, 7});
+
+  auto range = s.equal_range(3);
+  EXPECT_EQ(*range.first, 3);
+  EXPECT_EQ(*range.second, 7);
+  EXPECT_EQ(range.first, s.lower_bound(3));
+  EXPECT_EQ(range.second, s.upper_bound(3));
+  EXPECT_EQ(*--s.lower_bound(3), 1);
+  EXPECT_EQ(s.upper_bound(7), s.end());
+  EXPECT_EQ(s.lower_bound(8), s.end());
+}
+
+TEST(multiset, multiset_count_indexed) {
+  s21::multiset<int, s21::KeyExtract<int, int>, s21::Compare<int, int>, true> s;
+  std::multiset<int> s2;
+
+  for (int i = 0; i < 500; ++i) {
+    s.insert((i * 7919) % 61);
+    s2.insert((i * 7919) % 61);
+  }
+
+  for (int i = 0; i < 300; ++i) {
+    int key = (i * 31) % 61;
+    auto it = s.find(key);
+    auto it2 = s2.find(key);
+    if (it2 != s2.end()) {
+      s.erase(it);
+      s2.erase(it2);
+    }
+  }
+
+  for (int key = -1; key < 62; ++key) {
+    EXPECT_EQ(s.count(key), s2.count(key));
+  }
+
+  EXPECT_EQ(s.size(), s2.size());
+}
+
+TEST(multiset, multiset_count_indexed_copy) {
+  s21::multiset<int, s21::KeyExtract<int, int>, s21::Compare<int, int>, true> s(
+      {5, 1, 5, 3, 5, 5, 2});
+  auto copy = s;
+  copy.erase(copy.find(5));
+
+  EXPECT_EQ(s.count(5), 4);
+  EXPECT_EQ(copy.count(5), 3);
+  EXPECT_EQ(copy.count(4), 0);
+  EXPECT_EQ(copy.count(1), 1);
+}
+
+TEST(multiset, multiset_rank_select_indexed) {
+  s21::indexed_multiset<int> s({7, 3, 3, 9, 3, 1, 7});
+  std::multiset<int> s2({7, 3, 3, 9, 3, 1, 7});
+
+  std::size_t k = 0;
+  for (auto it2 = s2.begin(); it2 != s2.end(); ++it2, ++k) {
+    EXPECT_EQ(*s.select(k), *it2);
+  }
+
+  EXPECT_EQ(s.rank(3), 1);
+  EXPECT_EQ(s.rank(7), 4);
+  EXPECT_EQ(s.rank(8), 6);
+
+  auto range = s.equal_range(3);
+  EXPECT_EQ(s.distance(range.first, range.second), 3);
+  EXPECT_EQ(s.distance(s.begin(), s.end()), s.size());
+}
+
+TEST(multiset, multiset_range_sorted) {
+  std::vector<int> src{1, 1, 2, 3, 3, 3, 4, 7, 7, 9};
+  s21::indexed_multiset<int> s(src.begin(), src.end());
+
+  ASSERT_EQ(s.size(), src.size());
+  EXPECT_EQ(s.count(3), 3);
+  EXPECT_EQ(s.count(7), 2);
+  for (std::size_t k = 0; k < src.size(); ++k) {
+    EXPECT_EQ(*s.select(k), src[k]);
+  }
+
+  s.insert(3);
+  s.erase(s.find(1));
+  EXPECT_EQ(s.count(3), 4);
+  EXPECT_EQ(s.count(1), 1);
+}
+
+TEST(multiset, multiset_assign_sorted) {
+  s21::multiset<int> s{8, 9};
+  std::vector<int> src{2, 2, 5};
+
+  s.assign_sorted(src.begin(), src.end());
+
+  EXPECT_EQ(s.size(), 3U);
+  EXPECT_EQ(*s.begin(), 2);
+  EXPECT_FALSE(s.contains(8));
+}
+
+TEST(multiset, multiset_merge_equal_keys) {
+  s21::pool_allocator<int> pool(64);
+  s21::multiset<int> s(pool);
+  s21::multiset<int> s2(pool);
+  s21::multiset<int> s3({0, 1});
+
+  s.insert_many(1, 2, 2);
+  s2.insert_many(2, 3);
+
+  s.merge(s2);
+  s.merge(s3);
+
+  EXPECT_TRUE(s2.empty());
+  EXPECT_TRUE(s3.empty());
+  EXPECT_EQ(s.size(), 7U);
+  EXPECT_EQ(s.count(1), 2);
+  EXPECT_EQ(s.count(2), 3);
+  EXPECT_EQ(*s.begin(), 0);
+}
+
+TEST(multiset, multiset_transparent_lookup) {
+  s21::multiset<std::string, s21::KeyExtract<std::string, std::string>,
+                s21::less<>>
+      opa{"b", "a", "b", "c", "b"};
+  std::string_view key = "b";
+
+  EXPECT_EQ(opa.count(key), 3);
+  EXPECT_TRUE(opa.contains(key));
+  EXPECT_EQ(*opa.find(key), "b");
+  EXPECT_EQ(*opa.lower_bound(key), "b");
+  EXPECT_EQ(*opa.upper_bound(key), "c");
+
+  auto range = opa.equal_range(key);
+  int found = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ++found;
+  }
+  EXPECT_EQ(found, 3);
+}
+
+TEST(multiset, multiset_emplace) {
+  s21::multiset<std::string> opa;
+
+  opa.emplace(2, 'x');
+  opa.emplace("xx");
+  opa.insert(std::string("a"));
+  auto hinted = opa.emplace_hint(opa.end(), "z");
+
+  EXPECT_EQ(opa.size(), 4);
+  EXPECT_EQ(opa.count("xx"), 2);
+  EXPECT_EQ(*opa.begin(), "a");
+  EXPECT_EQ(*hinted, "z");
+}
+
+TEST(multiset, multiset_hinted_insert) {
+  s21::multiset<std::string> opa;
+
+  for (int i = 0; i < 10; ++i) {
+    opa.insert(opa.cend(), std::string(1, static_cast<char>('a' + i)));
+  }
+
+  auto first_c = opa.insert(opa.find("c"), "c");
+  auto last_c = opa.emplace_hint(opa.find("d"), "c");
+
+  EXPECT_EQ(opa.size(), 12);
+  EXPECT_EQ(opa.count("c"), 3);
+  EXPECT_TRUE(first_c == opa.lower_bound("c"));
+  EXPECT_TRUE(++last_c == opa.upper_bound("c"));
+}
+
+TEST(multiset, multiset_node_handle) {
+  s21::multiset<int> opa{1, 2, 2, 3};
+  s21::multiset<int> opa_2;
+
+  opa_2.insert(opa.extract(2));
+  opa_2.insert(opa.extract(opa.find(2)));
+  auto missed = opa.extract(2);
+
+  EXPECT_TRUE(missed.empty());
+  EXPECT_EQ(opa.size(), 2);
+  EXPECT_EQ(opa_2.count(2), 2);
+}
+TEST(multiset, multiset_threaded) {
+  std::vector<int> sorted{1, 2, 2, 3, 5, 8, 8, 8, 13};
+  s21::threaded_multiset<int> s(sorted.begin(), sorted.end());
+  std::multiset<int> expected(sorted.begin(), sorted.end());
+
+  for (int i = 0; i < 20; ++i) {
+    s.insert(i % 7);
+    expected.insert(i % 7);
+  }
+
+  s.erase(s.find(8));
+  expected.erase(expected.find(8));
+  s.insert(s.end(), 100);
+  expected.insert(100);
+
+  auto it = s.begin();
+
+  for (int value : expected) {
+    EXPECT_EQ(*it, value);
+    ++it;
+  }
+
+  EXPECT_EQ(it, s.end());
+  EXPECT_EQ(*--it, 100);
+}
+
+TEST(multiset, multiset_erase_range_and_key) {
+  s21::multiset<int> s;
+  std::multiset<int> expected;
+
+  for (int i = 0; i < 600; ++i) {
+    s.insert(i % 200);
+    expected.insert(i % 200);
+  }
+
+  EXPECT_EQ(s.erase(7), 3U);
+  EXPECT_EQ(s.erase(7), 0U);
+  expected.erase(7);
+
+  auto next = s.erase(s.find(20), s.find(180));
+  expected.erase(expected.lower_bound(20), expected.lower_bound(180));
+  EXPECT_EQ(*next, 180);
+
+  EXPECT_EQ(s.erase_if([](int value) { return value % 2 == 0; }), 60U);
+
+  for (auto it = expected.begin(); it != expected.end();) {
+    it = *it % 2 == 0 ? expected.erase(it) : std::next(it);
+  }
+
+  s.insert(181);
+  expected.insert(181);
+
+  ASSERT_EQ(s.size(), expected.size());
+  auto it = s.begin();
+
+  for (int value : expected) {
+    EXPECT_EQ(*it, value);
+    ++it;
+  }
+}
+
+TEST(multiset, multiset_set_algebra) {
+  s21::multiset<int> a{1, 1, 1, 2, 3, 3};
+  s21::multiset<int> b{1, 3, 3, 3, 4};
+  std::vector<int> expected;
+
+  auto as_vector = [](s21::multiset<int> s) {
+    std::vector<int> values;
+
+    for (int value : s) {
+      values.push_back(value);
+    }
+
+    return values;
+  };
+
+  EXPECT_EQ(as_vector(s21::set_union(a, b)),
+            std::vector<int>({1, 1, 1, 2, 3, 3, 3, 4}));
+  EXPECT_EQ(as_vector(s21::set_intersection(a, b)),
+            std::vector<int>({1, 3, 3}));
+  EXPECT_EQ(as_vector(s21::set_difference(a, b)), std::vector<int>({1, 1, 2}));
+  EXPECT_EQ(as_vector(s21::set_symmetric_difference(a, b)),
+            std::vector<int>({1, 1, 2, 3, 4}));
+
+  std::multiset<int> sa{1, 1, 1, 2, 3, 3};
+  std::multiset<int> sb{1, 3, 3, 3, 4};
+
+  for (int i = 0; i < 2000; ++i) {
+    a.insert(i % 500);
+    sa.insert(i % 500);
+  }
+
+  std::set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(),
+                      std::back_inserter(expected));
+
+  EXPECT_EQ(as_vector(s21::set_difference(a, b)), expected);
+}
+
+TEST(multiset, multiset_parallel_insert) {
+  s21::thread_pool pool(4);
+  s21::multiset<int> s{5, 5, 17};
+  std::multiset<int> expected{5, 5, 17};
+  std::vector<int> keys;
+
+  for (int i = 0; i < 30000; ++i) {
+    keys.push_back(i * 7 % 1009);
+    expected.insert(i * 7 % 1009);
+  }
+
+  s.insert(keys.begin(), keys.end(), pool);
+
+  std::vector<int> values;
+
+  for (int value : s) {
+    values.push_back(value);
+  }
+
+  EXPECT_EQ(s.size(), expected.size());
+  EXPECT_EQ(values, std::vector<int>(expected.begin(), expected.end()));
+  EXPECT_EQ(s.count(5), expected.count(5));
+}
+
+TEST(multiset, multiset_split_and_join) {
+  s21::multiset<int> s{1, 2, 2, 2, 3, 3, 4};
+  s21::multiset<int> greater = s.split(3);
+
+  EXPECT_EQ(s.size(), 4U);
+  EXPECT_EQ(greater.size(), 3U);
+  EXPECT_EQ(greater.count(3), 2U);
+  EXPECT_EQ(s.count(2), 3U);
+
+  s21::multiset<int> overlap{0, 9};
+  EXPECT_THROW(s.join(overlap), std::invalid_argument);
+
+  s21::multiset<int> same{2};
+  s.join(same);
+  s.join(greater);
+
+  EXPECT_EQ(s.size(), 8U);
+  EXPECT_EQ(s.count(2), 4U);
+  EXPECT_TRUE(greater.empty());
+}
+
+TEST(multiset, multiset_find_many) {
+  s21::multiset<int> s;
+
+  for (int i = 0; i < 40000; ++i) {
+    s.insert(i % 100 * 2);
+  }
+
+  std::vector<int> keys;
+
+  for (int i = -5; i < 210; ++i) {
+    keys.push_back(i);
+    keys.push_back(i);
+  }
+
+  std::vector<s21::multiset<int>::iterator> found;
+  std::vector<bool> present;
+
+  s.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  s.contains_many(keys.begin(), keys.end(), std::back_inserter(present));
+
+  ASSERT_EQ(found.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_TRUE(found[i] == s.find(keys[i]));
+    EXPECT_EQ(present[i], keys[i] >= 0 && keys[i] < 200 && keys[i] % 2 == 0);
+  }
+}
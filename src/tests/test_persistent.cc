@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../persistent_map/s21_persistent_map.h"
+#include "../persistent_set/s21_persistent_set.h"
+
+namespace {
+template <typename Persistent, typename Std>
+void ExpectSame(const Persistent &version, const Std &expected) {
+  ASSERT_EQ(version.size(), expected.size());
+
+  auto it = version.begin();
+
+  for (const auto &value : expected) {
+    ASSERT_TRUE(it != version.end());
+    ASSERT_EQ(*it, value);
+    ++it;
+  }
+
+  EXPECT_TRUE(it == version.end());
+}
+}  // namespace
+
+TEST(persistent_map, versions_stay_as_they_were) {
+  s21::persistent_map<int, std::string> empty;
+  auto one = empty.insert({1, "one"});
+  auto two = one.insert({2, "two"});
+  auto changed = two.insert_or_assign(1, "uno");
+  auto erased = changed.erase(2);
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(one.size(), 1U);
+  EXPECT_EQ(two.size(), 2U);
+  EXPECT_EQ(two.at(1), "one");
+  EXPECT_EQ(changed.at(1), "uno");
+  EXPECT_EQ(changed[2], "two");
+  EXPECT_EQ(erased.size(), 1U);
+  EXPECT_FALSE(erased.contains(2));
+  EXPECT_TRUE(two.contains(2));
+  EXPECT_THROW(erased.at(2), std::out_of_range);
+  EXPECT_EQ(two.insert({2, "dos"}).at(2), "two");
+  EXPECT_EQ(two.erase(7), two);
+  EXPECT_NE(two, changed);
+  EXPECT_TRUE(two.clear().empty());
+  EXPECT_EQ(two.size(), 2U);
+}
+
+TEST(persistent_map, lookups) {
+  s21::persistent_map<int, int> m;
+
+  for (int i = 0; i < 100; i += 2) {
+    m = m.insert({i, i * i});
+  }
+
+  EXPECT_EQ(m.find(10)->second, 100);
+  EXPECT_TRUE(m.find(11) == m.end());
+  EXPECT_EQ(m.count(12), 1U);
+  EXPECT_EQ(m.count(13), 0U);
+  EXPECT_EQ(m.lower_bound(11)->first, 12);
+  EXPECT_EQ(m.lower_bound(12)->first, 12);
+  EXPECT_EQ(m.upper_bound(12)->first, 14);
+  EXPECT_TRUE(m.lower_bound(99) == m.end());
+  EXPECT_TRUE(m.upper_bound(98) == m.end());
+
+  auto it = m.find(50);
+  ++it;
+  EXPECT_EQ(it->first, 52);
+  --it;
+  --it;
+  EXPECT_EQ(it->first, 48);
+
+  auto last = m.end();
+  --last;
+  EXPECT_EQ(last->first, 98);
+
+  int expected = 98;
+
+  for (auto back = m.end(); back != m.begin();) {
+    --back;
+    EXPECT_EQ(back->first, expected);
+    expected -= 2;
+  }
+
+  EXPECT_EQ(expected, -2);
+}
+
+/*Every version made along the way is checked again after all the later
+  versions are made from it*/
+TEST(persistent_map, random_versions_match_std_map) {
+  std::mt19937 gen(24);
+  std::uniform_int_distribution<int> key(0, 500);
+  std::uniform_int_distribution<int> action(0, 2);
+  std::vector<s21::persistent_map<int, int>> versions(1);
+  std::vector<std::map<int, int>> expected(1);
+
+  for (int step = 0; step < 3000; ++step) {
+    std::uniform_int_distribution<size_t> base(0, versions.size() - 1);
+    size_t from = step % 4 == 0 ? base(gen) : versions.size() - 1;
+    s21::persistent_map<int, int> version = versions[from];
+    std::map<int, int> model = expected[from];
+    int k = key(gen);
+
+    switch (action(gen)) {
+      case 0:
+        version = version.insert({k, step});
+        model.insert({k, step});
+        break;
+
+      case 1:
+        version = version.insert_or_assign(k, step);
+        model[k] = step;
+        break;
+
+      default:
+        version = version.erase(k);
+        model.erase(k);
+        break;
+    }
+
+    versions.push_back(version);
+    expected.push_back(model);
+  }
+
+  for (size_t i = 0; i < versions.size(); ++i) {
+    ExpectSame(versions[i],
+               std::vector<std::pair<int, int>>(expected[i].begin(),
+                                                expected[i].end()));
+  }
+}
+
+TEST(persistent_set, erase_every_key) {
+  std::vector<int> keys(2000);
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  s21::persistent_set<int> full(keys.begin(), keys.end());
+  s21::persistent_set<int> s = full;
+  std::set<int> model(keys.begin(), keys.end());
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(8));
+
+  for (int k : keys) {
+    s = s.erase(k);
+    model.erase(k);
+
+    if (model.size() % 97 == 0) {
+      ExpectSame(s, model);
+    }
+  }
+
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.begin() == s.end());
+  EXPECT_EQ(full.size(), 2000U);
+  EXPECT_EQ(*full.begin(), 0);
+  EXPECT_EQ(*--full.end(), 1999);
+}
+
+TEST(persistent_set, basics) {
+  s21::persistent_set<std::string> s{"pear", "apple", "fig"};
+  auto more = s.insert("kiwi");
+  s21::persistent_set<std::string> moved(std::move(more));
+
+  EXPECT_TRUE(more.empty());
+  EXPECT_EQ(moved.size(), 4U);
+  EXPECT_EQ(*moved.begin(), "apple");
+  EXPECT_EQ(s.count("kiwi"), 0U);
+  EXPECT_EQ(moved.count("kiwi"), 1U);
+  EXPECT_EQ(*moved.upper_bound("fig"), "kiwi");
+
+  std::vector<std::string> batch{"plum", "fig", "date"};
+  auto merged = s.insert(batch.begin(), batch.end());
+
+  EXPECT_EQ(merged.size(), 5U);
+  EXPECT_EQ(s.size(), 3U);
+
+  merged.swap(s);
+  EXPECT_EQ(s.size(), 5U);
+  EXPECT_EQ(merged.size(), 3U);
+}
+
+/*Readers take a version under the lock and walk it without one while the
+  writer keeps making new ones*/
+TEST(persistent_map, readers_walk_versions_while_writer_changes) {
+  std::mutex lock;
+  s21::persistent_map<int, int> latest;
+  bool done = false;
+  std::vector<std::thread> readers;
+  std::vector<int> consistent(4, 1);
+
+  for (size_t r = 0; r < consistent.size(); ++r) {
+    readers.emplace_back([&, r] {
+      for (;;) {
+        s21::persistent_map<int, int> version;
+        bool last = false;
+
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          version = latest;
+          last = done;
+        }
+
+        size_t walked = 0;
+        int previous = -1;
+
+        for (const auto &item : version) {
+          if (item.first <= previous || item.second != item.first * 3) {
+            consistent[r] = 0;
+          }
+
+          previous = item.first;
+          ++walked;
+        }
+
+        if (walked != version.size()) {
+          consistent[r] = 0;
+        }
+
+        if (last) {
+          break;
+        }
+      }
+    });
+  }
+
+  s21::persistent_map<int, int> next;
+
+  for (int i = 0; i < 3000; ++i) {
+    next = next.insert({i, i * 3});
+
+    if (i % 3 == 0) {
+      next = next.erase(i / 2);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    latest = next;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    done = true;
+  }
+
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  for (int ok : consistent) {
+    EXPECT_EQ(ok, 1);
+  }
+
+  EXPECT_EQ(latest.size(), next.size());
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "../s21_containers.h"
+
+namespace {
+long Sum(s21::thread_pool &pool, long from, long to) {
+  if (to - from < 64) {
+    long sum = 0;
+
+    for (long i = from; i < to; ++i) {
+      sum += i;
+    }
+
+    return sum;
+  }
+
+  long mid = from + (to - from) / 2;
+  long left = 0;
+  long right = 0;
+
+  pool.invoke([&]() { left = Sum(pool, from, mid); },
+              [&]() { right = Sum(pool, mid, to); });
+
+  return left + right;
+}
+}  // namespace
+
+TEST(thread_pool, size) {
+  s21::thread_pool none(0);
+  s21::thread_pool single(1);
+  s21::thread_pool four(4);
+
+  EXPECT_EQ(none.size(), 1U);
+  EXPECT_EQ(single.size(), 1U);
+  EXPECT_EQ(four.size(), 4U);
+}
+
+TEST(thread_pool, nested_invoke) {
+  for (std::size_t threads : {1, 2, 4}) {
+    s21::thread_pool pool(threads);
+
+    EXPECT_EQ(Sum(pool, 0, 100000), 4999950000L);
+  }
+}
+
+TEST(thread_pool, exceptions) {
+  s21::thread_pool pool(3);
+  std::atomic<int> ran(0);
+
+  EXPECT_THROW(pool.invoke(
+                   [&]() {
+                     ++ran;
+                     throw std::runtime_error("first");
+                   },
+                   [&]() { ++ran; }),
+               std::runtime_error);
+  EXPECT_EQ(ran.load(), 2);
+
+  EXPECT_THROW(pool.invoke([&]() { ++ran; },
+                           [&]() {
+                             ++ran;
+                             throw std::logic_error("second");
+                           }),
+               std::logic_error);
+  EXPECT_EQ(ran.load(), 4);
+  EXPECT_EQ(Sum(pool, 0, 1000), 499500L);
+}
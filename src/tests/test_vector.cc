@@ -1,7 +1,45 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+
 #include "../s21_containers.h"
 
+namespace {
+struct Counted {
+  static int defaults;
+  static int copies;
+
+  int value;
+
+  Counted() : value(0) { ++defaults; }
+  explicit Counted(int v) : value(v) {}
+  Counted(const Counted &other) : value(other.value) { ++copies; }
+  Counted(Counted &&other) noexcept : value(other.value) {}
+  Counted &operator=(const Counted &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  Counted &operator=(Counted &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+
+int Counted::defaults = 0;
+int Counted::copies = 0;
+
+struct Boxed {
+  std::unique_ptr<int> value;
+};
+}  // namespace
+
+namespace s21 {
+template <>
+struct is_trivially_relocatable<Boxed> : std::true_type {};
+}  // namespace s21
+
 TEST(test_vector, constructor_type_1) {
   s21::vector<int> arr;
 
@@ -924,4 +962,81 @@ TEST(test_vector, modifiers_insert_many_7) {
   EXPECT_EQ(v[5], "of");
   EXPECT_EQ(v[6], "words");
   EXPECT_EQ(v[7], "world");
+}
+
+TEST(test_vector, growth_moves_without_default_construct) {
+  Counted::defaults = 0;
+  Counted::copies = 0;
+  s21::vector<Counted> v;
+
+  for (int i = 0; i < 100; ++i) {
+    v.emplace_back(i);
+  }
+
+  v.reserve(1000);
+  v.insert(v.begin() + 50, Counted(-1));
+
+  EXPECT_EQ(Counted::defaults, 0);
+  EXPECT_EQ(Counted::copies, 1);
+  EXPECT_EQ(v.size(), 101);
+  EXPECT_EQ(v[50].value, -1);
+  EXPECT_EQ(v[100].value, 99);
+}
+
+TEST(test_vector, push_back_move_only) {
+  s21::vector<std::unique_ptr<int>> v;
+
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(std::make_unique<int>(i));
+  }
+
+  v.erase(v.begin());
+  v.pop_back();
+
+  EXPECT_EQ(v.size(), 8);
+  EXPECT_EQ(*v.front(), 1);
+  EXPECT_EQ(*v.back(), 8);
+}
+
+TEST(test_vector, emplace_back_self_reference) {
+  s21::vector<std::string> v{"a string too long for the small buffer"};
+
+  for (int i = 0; i < 5; ++i) {
+    v.push_back(v[0]);
+  }
+
+  std::string &last = v.emplace_back(3, 'x');
+
+  EXPECT_EQ(v.size(), 7);
+  EXPECT_EQ(last, "xxx");
+  EXPECT_EQ(v[5], v[0]);
+}
+
+TEST(test_vector, clear_keeps_capacity) {
+  s21::vector<std::string> v{"hello", "world"};
+  v.clear();
+
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 2);
+  v.push_back("again");
+  EXPECT_EQ(v.front(), "again");
+}
+
+TEST(test_vector, relocatable_insert_erase) {
+  s21::vector<Boxed> v;
+
+  for (int i = 0; i < 20; ++i) {
+    v.push_back(Boxed{std::make_unique<int>(i)});
+  }
+
+  v.insert_many(v.begin() + 5, Boxed{std::make_unique<int>(-1)},
+                Boxed{std::make_unique<int>(-2)});
+  v.erase(v.begin());
+  v.shrink_to_fit();
+
+  EXPECT_EQ(v.size(), 21);
+  EXPECT_EQ(*v[3].value, 4);
+  EXPECT_EQ(*v[4].value, -1);
+  EXPECT_EQ(*v[5].value, -2);
+  EXPECT_EQ(*v[20].value, 19);
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+#ifndef CPP_S21_CONTAINERS_THREAD_POOL_S21_THREAD_POOL_H
+#define CPP_S21_CONTAINERS_THREAD_POOL_S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+/*Fork-join pool for divide and conquer work. Every worker keeps a deque of
+  the tasks it forked, runs its newest task first and steals the oldest task
+  of another worker when it runs dry, so thieves carry off the biggest
+  pieces. A thread waiting for a task it forked runs other tasks meanwhile,
+  which keeps nested forks from deadlocking. The thread calling invoke counts
+  as one of the threads, so a pool of one thread runs everything in place*/
+class thread_pool {
+ public:
+  explicit thread_pool(
+      std::size_t threads = std::thread::hardware_concurrency());
+  thread_pool(const thread_pool &other) = delete;
+  thread_pool &operator=(const thread_pool &other) = delete;
+  ~thread_pool();
+
+  std::size_t size() const noexcept;
+
+  template <typename F, typename G>
+  void invoke(F &&first, G &&second);
+
+ private:
+  class Task {
+   public:
+    void Execute() noexcept;
+    bool Done() const noexcept;
+    void Rethrow() const;
+
+   protected:
+    ~Task() = default;
+
+   private:
+    std::atomic<bool> done_{false};
+    std::exception_ptr error_;
+
+    virtual void Run() = 0;
+  };
+
+  template <typename F>
+  class Job final : public Task {
+   public:
+    explicit Job(F &body) noexcept : body_(body) {}
+
+   private:
+    F &body_;
+
+    void Run() override { body_(); }
+  };
+
+  struct Queue {
+    std::mutex mutex_;
+    std::deque<Task *> tasks_;
+  };
+
+  /*Which pool, if any, the current thread works for*/
+  struct Self {
+    const thread_pool *pool_;
+    std::size_t index_;
+  };
+
+  std::size_t queue_count_;
+  std::unique_ptr<Queue[]> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> queued_;
+  std::atomic<std::size_t> sleeping_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+
+  static Self &Current() noexcept;
+  std::size_t OwnQueue() const noexcept;
+  void Push(std::size_t index, Task *task);
+  bool Reclaim(std::size_t index, const Task *task) noexcept;
+  Task *Take(std::size_t index) noexcept;
+  void WaitFor(std::size_t index, const Task &task) noexcept;
+  void Work(std::size_t index) noexcept;
+  void Stop() noexcept;
+};
+
+/*threads - 1 workers are started; the last queue is shared by the threads
+  from outside the pool*/
+inline thread_pool::thread_pool(std::size_t threads)
+    : queue_count_(threads > 1 ? threads : 1),
+      queues_(new Queue[queue_count_]),
+      queued_(0),
+      sleeping_(0),
+      stop_(false) {
+  try {
+    for (std::size_t i = 0; i + 1 < queue_count_; ++i) {
+      workers_.emplace_back(&thread_pool::Work, this, i);
+    }
+
+  } catch (...) {
+    Stop();
+    throw;
+  }
+}
+
+inline thread_pool::~thread_pool() { Stop(); }
+
+inline std::size_t thread_pool::size() const noexcept { return queue_count_; }
+
+/*Runs first in the calling thread and second wherever a thread is free,
+  and returns once both are done. An exception thrown by either is passed
+  on after both have finished*/
+template <typename F, typename G>
+void thread_pool::invoke(F &&first, G &&second) {
+  if (workers_.empty()) {
+    first();
+    second();
+    return;
+  }
+
+  std::size_t index = OwnQueue();
+  Job<std::remove_reference_t<G>> job(second);
+
+  try {
+    Push(index, &job);
+
+  } catch (...) {
+    first();
+    second();
+    return;
+  }
+
+  std::exception_ptr error;
+
+  try {
+    first();
+
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  if (Reclaim(index, &job)) {
+    job.Execute();
+
+  } else {
+    WaitFor(index, job);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  job.Rethrow();
+}
+
+inline void thread_pool::Task::Execute() noexcept {
+  try {
+    Run();
+
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+
+  done_.store(true, std::memory_order_release);
+}
+
+inline bool thread_pool::Task::Done() const noexcept {
+  return done_.load(std::memory_order_acquire);
+}
+
+inline void thread_pool::Task::Rethrow() const {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+inline thread_pool::Self &thread_pool::Current() noexcept {
+  static thread_local Self self{nullptr, 0};
+  return self;
+}
+
+inline std::size_t thread_pool::OwnQueue() const noexcept {
+  const Self &self = Current();
+  return self.pool_ == this ? self.index_ : queue_count_ - 1;
+}
+
+/*A sleeping worker is only woken up when one might be asleep; queued_ and
+  sleeping_ are both sequentially consistent, so either the worker sees the
+  task or the pusher sees the worker*/
+inline void thread_pool::Push(std::size_t index, Task *task) {
+  {
+    std::lock_guard<std::mutex> lock(queues_[index].mutex_);
+    queues_[index].tasks_.push_back(task);
+  }
+
+  queued_.fetch_add(1);
+
+  if (sleeping_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    wake_.notify_one();
+  }
+}
+
+/*Takes task back unless a thief got to it first*/
+inline bool thread_pool::Reclaim(std::size_t index,
+                                 const Task *task) noexcept {
+  std::lock_guard<std::mutex> lock(queues_[index].mutex_);
+  std::deque<Task *> &tasks = queues_[index].tasks_;
+
+  for (auto it = tasks.end(); it != tasks.begin();) {
+    if (*--it == task) {
+      tasks.erase(it);
+      queued_.fetch_sub(1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*The newest task of our own queue, or else the oldest of another one*/
+inline thread_pool::Task *thread_pool::Take(std::size_t index) noexcept {
+  if (queued_.load() == 0) {
+    return nullptr;
+  }
+
+  for (std::size_t i = 0; i < queue_count_; ++i) {
+    Queue &queue = queues_[(index + i) % queue_count_];
+    std::lock_guard<std::mutex> lock(queue.mutex_);
+
+    if (queue.tasks_.empty()) {
+      continue;
+    }
+
+    Task *task = nullptr;
+
+    if (i == 0) {
+      task = queue.tasks_.back();
+      queue.tasks_.pop_back();
+
+    } else {
+      task = queue.tasks_.front();
+      queue.tasks_.pop_front();
+    }
+
+    queued_.fetch_sub(1);
+    return task;
+  }
+
+  return nullptr;
+}
+
+inline void thread_pool::WaitFor(std::size_t index,
+                                 const Task &task) noexcept {
+  while (!task.Done()) {
+    Task *other = Take(index);
+
+    if (other != nullptr) {
+      other->Execute();
+
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+inline void thread_pool::Work(std::size_t index) noexcept {
+  Current() = Self{this, index};
+
+  for (;;) {
+    Task *task = Take(index);
+
+    if (task != nullptr) {
+      task->Execute();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+
+    if (stop_) {
+      return;
+    }
+
+    sleeping_.fetch_add(1);
+    wake_.wait(lock, [this]() { return stop_ || queued_.load() > 0; });
+    sleeping_.fetch_sub(1);
+  }
+}
+
+inline void thread_pool::Stop() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+
+  wake_.notify_all();
+
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+
+  workers_.clear();
+}
+
+}  // namespace s21
+
+#endif
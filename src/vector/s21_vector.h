@@ -1,8 +1,14 @@
 #ifndef CPP_S21_CONTAINERS_VECTOR_S21_VECTOR_H
 #define CPP_S21_CONTAINERS_VECTOR_S21_VECTOR_H
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <new>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 
 #include "../helper/helper.h"
 
@@ -32,8 +38,8 @@ class vector {
   reference operator[](size_type pos);
   const_reference operator[](size_type pos) const;
 
-  reference front() noexcept;
-  reference back() noexcept;
+  reference front();
+  reference back();
   const_reference front() const;
   const_reference back() const;
   iterator data();
@@ -55,6 +61,9 @@ class vector {
   iterator insert(iterator pos, const_reference value);
   void erase(iterator pos);
   void push_back(const_reference value);
+  void push_back(value_type &&value);
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
   void pop_back();
   void swap(vector &other);
 
@@ -69,6 +78,17 @@ class vector {
   T *arr_;
   size_t size_;
   size_t capacity_;
+
+  static constexpr bool kRelocatable =
+      is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>;
+
+  size_type Recommend(size_type required) const noexcept;
+  static T *Allocate(size_type n);
+  static void Deallocate(T *arr, size_type n) noexcept;
+  static void Copy(const T *first, const T *last, T *dest);
+  static void Relocate(T *first, T *last, T *dest);
+  void Reallocate(size_type capacity);
+  void Splice(size_type index, T *items, size_type count);
 };
 
 template <typename T>
@@ -80,27 +100,43 @@ vector<T>::vector() {
 
 template <typename T>
 vector<T>::vector(size_type n) {
-  arr_ = new value_type[n]();
+  arr_ = Allocate(n);
   size_ = n;
   capacity_ = n;
+
+  try {
+    std::uninitialized_value_construct_n(arr_, n);
+  } catch (...) {
+    Deallocate(arr_, n);
+    throw;
+  }
 }
 
 template <typename T>
 vector<T>::vector(std::initializer_list<value_type> const &items) {
   size_ = items.size();
   capacity_ = size_;
-  arr_ = new value_type[size_];
-  std::copy(items.begin(), items.end(), arr_);
+  arr_ = Allocate(size_);
+
+  try {
+    Copy(items.begin(), items.end(), arr_);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
+  }
 }
 
 template <typename T>
 vector<T>::vector(const vector &v) {
   size_ = v.size_;
   capacity_ = v.capacity_;
-  arr_ = new T[size_];
+  arr_ = Allocate(capacity_);
 
-  for (size_t i = 0; i < size_; ++i) {
-    arr_[i] = v.arr_[i];
+  try {
+    Copy(v.begin(), v.end(), arr_);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
   }
 }
 
@@ -117,7 +153,8 @@ vector<T>::vector(vector &&v) {
 
 template <typename T>
 vector<T>::~vector() {
-  delete[] arr_;
+  std::destroy(begin(), end());
+  Deallocate(arr_, capacity_);
   size_ = 0;
   capacity_ = 0;
 }
@@ -159,7 +196,8 @@ typename vector<T>::const_reference vector<T>::operator[](size_type pos) const {
 template <typename T>
 vector<T> &vector<T>::operator=(vector &&v) {
   if (&v != this) {
-    delete[] arr_;
+    std::destroy(begin(), end());
+    Deallocate(arr_, capacity_);
     size_ = v.size_;
     capacity_ = v.capacity_;
     arr_ = v.arr_;
@@ -175,14 +213,8 @@ vector<T> &vector<T>::operator=(vector &&v) {
 template <typename T>
 vector<T> &vector<T>::operator=(const vector &v) {
   if (&v != this) {
-    size_ = v.size_;
-    capacity_ = v.capacity_;
-    delete[] arr_;
-    arr_ = new T[size_];
-
-    for (size_t i = 0; i < size_; ++i) {
-      arr_[i] = v.arr_[i];
-    }
+    vector copy(v);
+    swap(copy);
   }
 
   return *this;
@@ -195,32 +227,16 @@ void vector<T>::reserve(size_type size) {
         "Error: in reserve(size_type size): size > s21::vector::max_size()");
   }
 
-  if (size <= capacity_) {
-    return;
+  if (size > capacity_) {
+    Reallocate(size);
   }
-
-  auto arr_new = new value_type[size];
-
-  for (size_t i = 0; i < size_; ++i) {
-    arr_new[i] = arr_[i];
-  }
-
-  delete[] arr_;
-  arr_ = arr_new;
-  capacity_ = size;
 }
 
 template <typename T>
 void vector<T>::shrink_to_fit() {
-  auto arr_new = new value_type[size_];
-
-  for (size_t i = 0; i < size_; ++i) {
-    arr_new[i] = arr_[i];
+  if (size_ < capacity_) {
+    Reallocate(size_);
   }
-
-  delete[] arr_;
-  arr_ = arr_new;
-  capacity_ = size_;
 }
 
 template <typename T>
@@ -257,19 +273,14 @@ typename vector<T>::iterator vector<T>::insert(iterator pos,
   }
 
   size_type index = pos - begin();
-  value_type *arr_new = new value_type[size_ + 1];
-  std::copy(begin(), pos, arr_new);
-  arr_new[index] = value;
-  std::copy(pos, end(), arr_new + index + 1);
-
-  delete[] arr_;
-  arr_ = arr_new;
-  size_++;
+  value_type item = value;
 
-  if (size_ > capacity_) {
-    capacity_size();
+  if (size_ == capacity_) {
+    reserve(Recommend(size_ + 1));
   }
 
+  Splice(index, &item, 1);
+
   return begin() + index;
 }
 
@@ -283,6 +294,110 @@ void vector<T>::capacity_size() {
   }
 }
 
+/*Doubles the capacity, or grows straight to what is required if that is
+  more*/
+template <typename T>
+typename vector<T>::size_type vector<T>::Recommend(
+    size_type required) const noexcept {
+  return capacity_ * 2 > required ? capacity_ * 2 : required;
+}
+
+template <typename T>
+T *vector<T>::Allocate(size_type n) {
+  if (n == 0) {
+    return nullptr;
+  }
+
+  return std::allocator<T>().allocate(n);
+}
+
+template <typename T>
+void vector<T>::Deallocate(T *arr, size_type n) noexcept {
+  if (arr != nullptr) {
+    std::allocator<T>().deallocate(arr, n);
+  }
+}
+
+template <typename T>
+void vector<T>::Copy(const T *first, const T *last, T *dest) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (first != last) {
+      std::memcpy(static_cast<void *>(dest), first,
+                  (last - first) * sizeof(T));
+    }
+
+  } else {
+    std::uninitialized_copy(first, last, dest);
+  }
+}
+
+/*Moves [first, last) into raw memory at dest and ends the lifetime of the
+  sources. Falls back to copying when a throwing move could lose elements*/
+template <typename T>
+void vector<T>::Relocate(T *first, T *last, T *dest) {
+  if constexpr (kRelocatable) {
+    if (first != last) {
+      std::memcpy(static_cast<void *>(dest), first,
+                  (last - first) * sizeof(T));
+    }
+
+  } else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                       !std::is_copy_constructible_v<T>) {
+    std::uninitialized_move(first, last, dest);
+    std::destroy(first, last);
+
+  } else {
+    std::uninitialized_copy(first, last, dest);
+    std::destroy(first, last);
+  }
+}
+
+template <typename T>
+void vector<T>::Reallocate(size_type capacity) {
+  T *arr_new = Allocate(capacity);
+
+  try {
+    Relocate(begin(), end(), arr_new);
+  } catch (...) {
+    Deallocate(arr_new, capacity);
+    throw;
+  }
+
+  Deallocate(arr_, capacity_);
+  arr_ = arr_new;
+  capacity_ = capacity;
+}
+
+/*Shifts the tail right by count slots, which must fit in the capacity, and
+  moves items into the gap. Slots past the old end are raw memory, so they
+  are constructed rather than assigned*/
+template <typename T>
+void vector<T>::Splice(size_type index, T *items, size_type count) {
+  iterator pos = begin() + index;
+  iterator old_end = end();
+  size_type tail = size_ - index;
+
+  if constexpr (kRelocatable) {
+    if (tail != 0) {
+      std::memmove(static_cast<void *>(pos + count), pos, tail * sizeof(T));
+    }
+
+    std::uninitialized_move(items, items + count, pos);
+
+  } else if (tail > count) {
+    std::uninitialized_move(old_end - count, old_end, old_end);
+    std::move_backward(pos, old_end - count, old_end);
+    std::move(items, items + count, pos);
+
+  } else {
+    std::uninitialized_move(pos, old_end, pos + count);
+    std::move(items, items + tail, pos);
+    std::uninitialized_move(items + tail, items + count, old_end);
+  }
+
+  size_ += count;
+}
+
 template <typename T>
 typename vector<T>::iterator vector<T>::data() {
   return arr_;
@@ -290,16 +405,19 @@ typename vector<T>::iterator vector<T>::data() {
 
 template <typename T>
 void vector<T>::erase(iterator pos) {
-  if (pos < begin() || pos > end()) {
+  if (pos < begin() || pos >= end()) {
     throw std::length_error(
         "Error: erase(): Accessing an inaccessible area of memory");
   }
 
-  auto next = pos;
-  next++;
+  if constexpr (kRelocatable) {
+    std::destroy_at(pos);
+    std::memmove(static_cast<void *>(pos), pos + 1,
+                 (end() - pos - 1) * sizeof(T));
 
-  for (; next < end(); ++next, ++pos) {
-    std::swap(*next, *pos);
+  } else {
+    std::move(pos + 1, end(), pos);
+    std::destroy_at(end() - 1);
   }
 
   --size_;
@@ -314,17 +432,47 @@ void vector<T>::swap(vector &other) {
 
 template <typename T>
 void vector<T>::push_back(const_reference value) {
-  if (size_ >= capacity_) {
-    if (capacity_ == 0) {
-      reserve(1);
+  emplace_back(value);
+}
 
-    } else {
-      reserve(capacity_ * 2);
-    }
+template <typename T>
+void vector<T>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
+}
+
+/*On growth the new element is built first, so args may refer into the
+  vector itself*/
+template <typename T>
+template <typename... Args>
+typename vector<T>::reference vector<T>::emplace_back(Args &&...args) {
+  if (size_ < capacity_) {
+    ::new (static_cast<void *>(end())) T(std::forward<Args>(args)...);
+    return arr_[size_++];
+  }
+
+  size_type capacity = Recommend(size_ + 1);
+  T *arr_new = Allocate(capacity);
+
+  try {
+    ::new (static_cast<void *>(arr_new + size_)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    Deallocate(arr_new, capacity);
+    throw;
+  }
+
+  try {
+    Relocate(begin(), end(), arr_new);
+  } catch (...) {
+    std::destroy_at(arr_new + size_);
+    Deallocate(arr_new, capacity);
+    throw;
   }
 
-  arr_[size_] = value;
-  size_ += 1;
+  Deallocate(arr_, capacity_);
+  arr_ = arr_new;
+  capacity_ = capacity;
+
+  return arr_[size_++];
 }
 
 template <typename T>
@@ -334,6 +482,7 @@ void vector<T>::pop_back() {
   }
 
   size_--;
+  std::destroy_at(end());
 }
 
 template <typename T>
@@ -357,10 +506,26 @@ typename vector<T>::size_type vector<T>::capacity() const {
 
 template <typename T>
 void vector<T>::clear() {
-  delete[] arr_;
+  std::destroy(begin(), end());
   size_ = 0;
-  capacity_ = 0;
-  arr_ = nullptr;
+}
+
+template <typename T>
+typename vector<T>::reference vector<T>::front() {
+  if (empty()) {
+    throw std::logic_error("Error: Vector is epmty");
+  }
+
+  return arr_[0];
+}
+
+template <typename T>
+typename vector<T>::reference vector<T>::back() {
+  if (empty()) {
+    throw std::logic_error("Error: Vector is epmty");
+  }
+
+  return arr_[size_ - 1];
 }
 
 template <typename T>
@@ -384,10 +549,18 @@ typename vector<T>::const_reference vector<T>::back() const {
 template <typename T>
 template <typename... Args>
 void vector<T>::insert_many_back(Args &&...args) {
-  std::initializer_list<value_type> items{args...};
+  constexpr size_type count = sizeof...(Args);
 
-  for (auto val : items) {
-    push_back(val);
+  if (size_ + count > capacity_) {
+    value_type items[] = {value_type(std::forward<Args>(args))...};
+    reserve(Recommend(size_ + count));
+
+    for (auto &item : items) {
+      emplace_back(std::move(item));
+    }
+
+  } else {
+    (emplace_back(std::forward<Args>(args)), ...);
   }
 }
 
@@ -395,16 +568,23 @@ template <typename T>
 template <typename... Args>
 typename vector<T>::iterator vector<T>::insert_many(const_iterator pos,
                                                     Args &&...args) {
-  std::initializer_list<value_type> items{args...};
-  size_t index = pos - begin();
-  iterator it = index + begin();
-  iterator result;
-
-  for (auto val : items) {
-    result = insert(it, val);
-    it = result + 1;
+  size_type index = pos - begin();
+  constexpr size_type count = sizeof...(Args);
+
+  if constexpr (count == 0) {
+    return begin() + index;
+
+  } else {
+    value_type items[count] = {value_type(std::forward<Args>(args))...};
+
+    if (size_ + count > capacity_) {
+      reserve(Recommend(size_ + count));
+    }
+
+    Splice(index, items, count);
+
+    return begin() + index + count - 1;
   }
-  return result;
 }
 
 template <typename T>
@@ -439,4 +619,4 @@ bool operator!=(const vector<T> &lhs, const vector<T> &rhs) {
 
 }  // namespace s21
 
-#endif
+#endif
\ No newline at end of file